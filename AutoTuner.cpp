@@ -0,0 +1,371 @@
+#include "AutoTuner.h"
+#include <math.h>
+
+//***********************************************************
+//     Constructor: AutoTuner
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Initializes the tuner with empty statistics.
+//
+//***********************************************************
+AutoTuner::AutoTuner()
+{
+  reset();
+}
+
+//***********************************************************
+//     Function Name: reset
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Discards noise statistics and outcome counters so the next
+//       recommendations use a fresh day of data.
+//
+//***********************************************************
+void AutoTuner::reset()
+{
+  windowCount = 0;
+  windowLowLight = false;
+  differenceMean = 0.0f;
+  differenceM2 = 0.0f;
+  brightnessMean = 0.0f;
+  brightnessM2 = 0.0f;
+
+  brightWindows = 0;
+  dimWindows = 0;
+  brightDifferenceVarianceSum = 0.0f;
+  dimDifferenceVarianceSum = 0.0f;
+  brightnessRelativeVarianceSum = 0.0f;
+
+  adjustmentCount = 0;
+  reversalCount = 0;
+  abortCount = 0;
+  repeatCount = 0;
+  lastBalancedTime = 0;
+  hasLastBalanced = false;
+}
+
+//***********************************************************
+//     Function Name: addSample
+//
+//     Inputs:
+//     - eastValue : Filtered east sensor resistance in ohms
+//     - westValue : Filtered west sensor resistance in ohms
+//     - stationary : True when the panel is idle and not moving
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Accumulates the imbalance percent and brightness into a
+//       short window. Windows are short enough that sun movement
+//       is negligible, so their variance is sensor noise. A window
+//       is discarded if the panel moves or the light band changes.
+//
+//***********************************************************
+void AutoTuner::addSample( float eastValue, float westValue, bool stationary )
+{
+  float lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  if( !stationary || lowerValue <= 0.0f )
+  {
+    windowCount = 0;
+    return;
+  }
+
+  float brightness = ( eastValue + westValue ) / 2.0f;
+  float difference = (( eastValue - westValue ) / lowerValue ) * 100.0f;
+  bool lowLight = ( brightness >= AUTOTUNE_LOW_LIGHT_OHMS );
+  if( windowCount > 0 && lowLight != windowLowLight )
+  {
+    windowCount = 0;
+  }
+
+  if( windowCount == 0 )
+  {
+    windowLowLight = lowLight;
+    differenceMean = 0.0f;
+    differenceM2 = 0.0f;
+    brightnessMean = 0.0f;
+    brightnessM2 = 0.0f;
+  }
+
+  windowCount++;
+  float delta = difference - differenceMean;
+  differenceMean += delta / windowCount;
+  differenceM2 += delta * ( difference - differenceMean );
+  delta = brightness - brightnessMean;
+  brightnessMean += delta / windowCount;
+  brightnessM2 += delta * ( brightness - brightnessMean );
+
+  if( windowCount >= AUTOTUNE_WINDOW_SAMPLES )
+  {
+    closeWindow();
+  }
+}
+
+//***********************************************************
+//     Function Name: closeWindow
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Adds the completed window's variances to its light band.
+//
+//***********************************************************
+void AutoTuner::closeWindow()
+{
+  float differenceVariance = differenceM2 / ( windowCount - 1 );
+  if( windowLowLight )
+  {
+    if( dimWindows < UINT16_MAX )
+    {
+      dimWindows++;
+      dimDifferenceVarianceSum += differenceVariance;
+    }
+  }
+  else if( brightWindows < UINT16_MAX )
+  {
+    brightWindows++;
+    brightDifferenceVarianceSum += differenceVariance;
+    if( brightnessMean > 0.0f )
+    {
+      brightnessRelativeVarianceSum += ( brightnessM2 / ( windowCount - 1 )) / ( brightnessMean * brightnessMean );
+    }
+  }
+  windowCount = 0;
+}
+
+//***********************************************************
+//     Function Name: recordAdjustmentStart
+//
+//     Inputs:
+//     - currentTime : Time the adjustment started (ms)
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Counts an adjustment, and a repeat when it starts soon
+//       after the previous balance.
+//
+//***********************************************************
+void AutoTuner::recordAdjustmentStart( unsigned long currentTime )
+{
+  if( adjustmentCount < UINT16_MAX ) adjustmentCount++;
+  if( hasLastBalanced &&
+      currentTime - lastBalancedTime < AUTOTUNE_REPEAT_INTERVAL_SECONDS * 1000UL )
+  {
+    if( repeatCount < UINT16_MAX ) repeatCount++;
+  }
+}
+
+void AutoTuner::recordReversal()
+{
+  if( reversalCount < UINT16_MAX ) reversalCount++;
+}
+
+void AutoTuner::recordAbort()
+{
+  if( abortCount < UINT16_MAX ) abortCount++;
+}
+
+void AutoTuner::recordBalanced( unsigned long currentTime )
+{
+  lastBalancedTime = currentTime;
+  hasLastBalanced = true;
+}
+
+float AutoTuner::getImbalanceNoisePercent() const
+{
+  return ( brightWindows > 0 ) ? sqrt( brightDifferenceVarianceSum / brightWindows ) : 0.0f;
+}
+
+float AutoTuner::getLowLightImbalanceNoisePercent() const
+{
+  return ( dimWindows > 0 ) ? sqrt( dimDifferenceVarianceSum / dimWindows ) : 0.0f;
+}
+
+float AutoTuner::getBrightnessNoisePercent() const
+{
+  return ( brightWindows > 0 ) ? sqrt( brightnessRelativeVarianceSum / brightWindows ) * 100.0f : 0.0f;
+}
+
+//***********************************************************
+//     Function Name: recommendTolerance
+//
+//     Inputs:
+//     - currentPercent : Current balance tolerance
+//
+//     Returns:
+//     - float : Recommended balance tolerance in percent
+//
+//     Description:
+//     - Never below AUTOTUNE_TOLERANCE_SIGMAS times the measured
+//       imbalance noise. Frequent reversals widen the tolerance; a
+//       day with no reversals or aborts tightens it toward the
+//       noise floor. Result is clamped to the safe bounds.
+//
+//***********************************************************
+float AutoTuner::recommendTolerance( float currentPercent ) const
+{
+  float tolerance = currentPercent;
+  if( hasOutcomeData() )
+  {
+    float reversalRate = (float)reversalCount / adjustmentCount;
+    if( reversalRate > AUTOTUNE_REVERSAL_RATE_HIGH )
+    {
+      tolerance *= AUTOTUNE_INCREASE_FACTOR;
+    }
+    else if( reversalCount == 0 && abortCount == 0 )
+    {
+      tolerance *= AUTOTUNE_DECREASE_FACTOR;
+    }
+  }
+  if( hasNoiseData() )
+  {
+    float noiseFloor = AUTOTUNE_TOLERANCE_SIGMAS * getImbalanceNoisePercent();
+    if( tolerance < noiseFloor ) tolerance = noiseFloor;
+  }
+  return constrain( tolerance, AUTOTUNE_TOLERANCE_MIN_PERCENT, AUTOTUNE_TOLERANCE_MAX_PERCENT );
+}
+
+//***********************************************************
+//     Function Name: recommendLowLightTolerance
+//
+//     Inputs:
+//     - tolerancePercent : Tolerance used in good light
+//
+//     Returns:
+//     - float : Tolerance to use in low light (never below the
+//       good-light tolerance)
+//
+//***********************************************************
+float AutoTuner::recommendLowLightTolerance( float tolerancePercent ) const
+{
+  if( !hasLowLightNoiseData() )
+  {
+    return tolerancePercent;
+  }
+  float tolerance = AUTOTUNE_TOLERANCE_SIGMAS * getLowLightImbalanceNoisePercent();
+  if( tolerance < tolerancePercent ) tolerance = tolerancePercent;
+  return constrain( tolerance, AUTOTUNE_TOLERANCE_MIN_PERCENT, AUTOTUNE_TOLERANCE_MAX_PERCENT );
+}
+
+//***********************************************************
+//     Function Name: recommendStartThreshold
+//
+//     Inputs:
+//     - tolerancePercent : Recommended balance tolerance
+//     - currentPercent : Current monitor start threshold
+//
+//     Returns:
+//     - float : Recommended start threshold in percent
+//
+//     Description:
+//     - Keeps the threshold a margin above the tolerance so a
+//       balanced panel cannot immediately retrigger. Frequent
+//       repeat moves raise it; a day without repeats lowers it.
+//
+//***********************************************************
+float AutoTuner::recommendStartThreshold( float tolerancePercent, float currentPercent ) const
+{
+  float threshold = currentPercent;
+  if( hasOutcomeData() )
+  {
+    float repeatRate = (float)repeatCount / adjustmentCount;
+    if( repeatRate > AUTOTUNE_REPEAT_RATE_HIGH )
+    {
+      threshold *= AUTOTUNE_INCREASE_FACTOR;
+    }
+    else if( repeatCount == 0 )
+    {
+      threshold *= AUTOTUNE_DECREASE_FACTOR;
+    }
+  }
+  float minimum = tolerancePercent * AUTOTUNE_START_THRESHOLD_RATIO;
+  return constrain( threshold, minimum, AUTOTUNE_START_THRESHOLD_MAX_PERCENT );
+}
+
+//***********************************************************
+//     Function Name: recommendBrightnessTau
+//
+//     Inputs:
+//     - currentS : Current brightness filter time constant
+//
+//     Returns:
+//     - float : Time constant that brings filtered brightness
+//       noise down to AUTOTUNE_BRIGHTNESS_NOISE_TARGET_PERCENT
+//
+//***********************************************************
+float AutoTuner::recommendBrightnessTau( float currentS ) const
+{
+  if( !hasNoiseData() )
+  {
+    return currentS;
+  }
+  return tauForNoise( getBrightnessNoisePercent(), AUTOTUNE_BRIGHTNESS_NOISE_TARGET_PERCENT, currentS );
+}
+
+//***********************************************************
+//     Function Name: recommendMonitorTau
+//
+//     Inputs:
+//     - startThresholdPercent : Recommended start threshold
+//     - currentS : Current monitor filter time constant
+//
+//     Returns:
+//     - float : Time constant that keeps filtered imbalance noise
+//       AUTOTUNE_MONITOR_NOISE_SIGMAS below the start threshold
+//
+//***********************************************************
+float AutoTuner::recommendMonitorTau( float startThresholdPercent, float currentS ) const
+{
+  if( !hasNoiseData() )
+  {
+    return currentS;
+  }
+  return tauForNoise( getImbalanceNoisePercent(),
+                      startThresholdPercent / AUTOTUNE_MONITOR_NOISE_SIGMAS, currentS );
+}
+
+//***********************************************************
+//     Function Name: tauForNoise
+//
+//     Inputs:
+//     - noise : Input noise standard deviation
+//     - target : Wanted output noise standard deviation
+//     - currentS : Current time constant (returned if no target)
+//
+//     Returns:
+//     - float : EMA time constant in seconds, clamped to bounds
+//
+//     Description:
+//     - An EMA with time constant tau reduces the variance of
+//       independent samples spaced dt apart by about dt / (2 tau).
+//       The photosensor filter correlates samples over roughly two
+//       of its time constants, which is used as dt.
+//
+//***********************************************************
+float AutoTuner::tauForNoise( float noise, float target, float currentS )
+{
+  if( target <= 0.0f )
+  {
+    return currentS;
+  }
+  float dtS = ( 2.0f * PHOTOSENSOR_EMA_TIME_CONSTANT_MS ) / 1000.0f;
+  float ratio = noise / target;
+  float tau = ( dtS / 2.0f ) * ratio * ratio;
+  return constrain( tau, AUTOTUNE_TAU_MIN_S, AUTOTUNE_TAU_MAX_S );
+}
@@ -0,0 +1,70 @@
+#ifndef AUTO_TUNER_H
+#define AUTO_TUNER_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+class AutoTuner {
+public:
+  AutoTuner();
+  void reset();
+
+  // Feed one east/west sample pair (filtered ohms); only stationary samples measure noise
+  void addSample( float eastValue, float westValue, bool stationary );
+
+  // Adjustment outcomes
+  void recordAdjustmentStart( unsigned long currentTime );
+  void recordReversal();
+  void recordAbort();
+  void recordBalanced( unsigned long currentTime );
+
+  // Measured noise (standard deviations, percent)
+  bool hasNoiseData() const { return brightWindows >= AUTOTUNE_MIN_WINDOWS; }
+  bool hasLowLightNoiseData() const { return dimWindows >= AUTOTUNE_MIN_WINDOWS; }
+  bool hasOutcomeData() const { return adjustmentCount >= AUTOTUNE_MIN_ADJUSTMENTS; }
+  float getImbalanceNoisePercent() const;
+  float getLowLightImbalanceNoisePercent() const;
+  float getBrightnessNoisePercent() const;
+
+  // Outcome counters
+  uint16_t getAdjustmentCount() const { return adjustmentCount; }
+  uint16_t getReversalCount() const { return reversalCount; }
+  uint16_t getAbortCount() const { return abortCount; }
+  uint16_t getRepeatCount() const { return repeatCount; }
+
+  // Recommended settings, bounded and based on the data collected since reset()
+  float recommendTolerance( float currentPercent ) const;
+  float recommendLowLightTolerance( float tolerancePercent ) const;
+  float recommendStartThreshold( float tolerancePercent, float currentPercent ) const;
+  float recommendBrightnessTau( float currentS ) const;
+  float recommendMonitorTau( float startThresholdPercent, float currentS ) const;
+
+private:
+  // Current noise window (Welford)
+  uint8_t windowCount;
+  bool windowLowLight;
+  float differenceMean;
+  float differenceM2;
+  float brightnessMean;
+  float brightnessM2;
+
+  // Accumulated window variances per light band
+  uint16_t brightWindows;
+  uint16_t dimWindows;
+  float brightDifferenceVarianceSum;
+  float dimDifferenceVarianceSum;
+  float brightnessRelativeVarianceSum;
+
+  // Adjustment outcomes
+  uint16_t adjustmentCount;
+  uint16_t reversalCount;
+  uint16_t abortCount;
+  uint16_t repeatCount;
+  unsigned long lastBalancedTime;
+  bool hasLastBalanced;
+
+  void closeWindow();
+  static float tauForNoise( float noise, float target, float currentS );
+};
+
+#endif // AUTO_TUNER_H
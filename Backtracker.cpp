@@ -0,0 +1,262 @@
+#include "Backtracker.h"
+
+// sin() at whole degrees 0..90, Q15 (32768 = 1.0)
+static const uint16_t SIN_TABLE_Q15[91] PROGMEM =
+{
+      0,   572,  1144,  1715,  2286,  2856,  3425,  3993,  4560,  5126,
+   5690,  6252,  6813,  7371,  7927,  8481,  9032,  9580, 10126, 10668,
+  11207, 11743, 12275, 12803, 13328, 13848, 14365, 14876, 15384, 15886,
+  16384, 16877, 17364, 17847, 18324, 18795, 19261, 19720, 20174, 20622,
+  21063, 21498, 21926, 22348, 22763, 23170, 23571, 23965, 24351, 24730,
+  25102, 25466, 25822, 26170, 26510, 26842, 27166, 27482, 27789, 28088,
+  28378, 28660, 28932, 29197, 29452, 29698, 29935, 30163, 30382, 30592,
+  30792, 30983, 31164, 31336, 31499, 31651, 31795, 31928, 32052, 32166,
+  32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723, 32748, 32763,
+  32768
+};
+
+static const int32_t QUARTER_TURN_MDEG = 90000L;
+static const uint16_t SIN_45_Q15 = 23170U;
+
+// Integer square root (floor), bit by bit
+static uint32_t squareRoot( uint32_t value )
+{
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while( bit > value )
+  {
+    bit >>= 2;
+  }
+  while( bit != 0 )
+  {
+    if( value >= root + bit )
+    {
+      value -= root + bit;
+      root = ( root >> 1 ) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+//***********************************************************
+//     Constructor: Backtracker
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Initializes the row geometry from param_config.h with
+//       no day clock and the default day length.
+//
+//***********************************************************
+Backtracker::Backtracker()
+  : enabled(TRACKER_BACKTRACK_ENABLED),
+    rowPitchMm(TRACKER_ROW_PITCH_MM),
+    panelWidthMm(TRACKER_PANEL_WIDTH_MM),
+    dayStarted(false),
+    dayLengthMeasured(false),
+    dawnTime(0),
+    dayLengthMs(TRACKER_BACKTRACK_DAY_HOURS * 3600000UL)
+{
+  updateGroundCoverage();
+}
+
+void Backtracker::startDay( unsigned long currentTime )
+{
+  dayStarted = true;
+  dawnTime = currentTime;
+}
+
+void Backtracker::endDay( unsigned long currentTime )
+{
+  if( !dayStarted )
+  {
+    return;
+  }
+  dayStarted = false;
+
+  // A short "day" between two dark spells is not a sunrise-to-sunset span
+  unsigned long lengthMs = currentTime - dawnTime;
+  if( lengthMs >= TRACKER_BACKTRACK_MIN_DAY_HOURS * 3600000UL )
+  {
+    dayLengthMs = lengthMs;
+    dayLengthMeasured = true;
+  }
+}
+
+void Backtracker::setRowPitch( uint16_t pitchMm )
+{
+  rowPitchMm = pitchMm;
+  updateGroundCoverage();
+}
+
+void Backtracker::setPanelWidth( uint16_t widthMm )
+{
+  panelWidthMm = widthMm;
+  updateGroundCoverage();
+}
+
+void Backtracker::updateGroundCoverage()
+{
+  // Panels as wide as the pitch always shade; treat as fully covered
+  if( rowPitchMm == 0 || panelWidthMm >= rowPitchMm )
+  {
+    gcrQ15 = 32768U;
+    return;
+  }
+  gcrQ15 = (uint16_t)( ( (uint32_t)panelWidthMm << 15 ) / rowPitchMm );
+}
+
+//***********************************************************
+//     Function Name: getSunTilt
+//
+//     Inputs:
+//     - currentTime : Time to evaluate
+//
+//     Returns:
+//     - int32_t : Sun-facing tilt, millidegrees west of flat
+//
+//     Description:
+//     - Maps the time since dawn linearly onto -90 (east horizon)
+//       to +90 degrees (west horizon) over the day length. Before
+//       the first dawn the panel is assumed flat.
+//
+//***********************************************************
+int32_t Backtracker::getSunTilt( unsigned long currentTime ) const
+{
+  if( !dayStarted || dayLengthMs == 0 )
+  {
+    return 0;
+  }
+  unsigned long elapsedMs = currentTime - dawnTime;
+  if( elapsedMs >= dayLengthMs )
+  {
+    return QUARTER_TURN_MDEG;
+  }
+  // Evaluated once per adjustment, so the 64-bit product is affordable
+  return (int32_t)( (uint64_t)elapsedMs * ( 2 * QUARTER_TURN_MDEG ) / dayLengthMs ) - QUARTER_TURN_MDEG;
+}
+
+int32_t Backtracker::getTargetTilt( unsigned long currentTime ) const
+{
+  int32_t sunTilt = getSunTilt( currentTime );
+  int32_t magnitude = ( sunTilt < 0 ) ? -sunTilt : sunTilt;
+  int32_t tilt = getShadeFreeTilt( QUARTER_TURN_MDEG - magnitude, gcrQ15 );
+  return ( sunTilt < 0 ) ? -tilt : tilt;
+}
+
+bool Backtracker::isActive( unsigned long currentTime ) const
+{
+  if( !enabled || !dayStarted )
+  {
+    return false;
+  }
+  return getTargetTilt( currentTime ) != getSunTilt( currentTime );
+}
+
+//***********************************************************
+//     Function Name: getShadeFreeTilt
+//
+//     Inputs:
+//     - sunElevationMdeg : Sun elevation across the rotation axis
+//     - gcrQ15 : Ground coverage ratio (panel width / row pitch)
+//
+//     Returns:
+//     - int32_t : Tilt towards the sun, millidegrees from flat
+//
+//     Description:
+//     - The sun-facing tilt is 90 degrees less the elevation. The
+//       next row's shadow reaches this row when sin(elevation) is
+//       below the ground coverage ratio; the steepest tilt that
+//       just clears it is asin(sin(elevation) / gcr) - elevation,
+//       which falls to flat at the horizon.
+//
+//***********************************************************
+int32_t Backtracker::getShadeFreeTilt( int32_t sunElevationMdeg, uint16_t gcrQ15 )
+{
+  if( sunElevationMdeg <= 0 )
+  {
+    return 0;
+  }
+  if( sunElevationMdeg >= QUARTER_TURN_MDEG )
+  {
+    return 0;
+  }
+  uint16_t sinElevation = sinQ15( sunElevationMdeg );
+  if( sinElevation >= gcrQ15 )
+  {
+    return QUARTER_TURN_MDEG - sunElevationMdeg;   // No shading: face the sun
+  }
+  uint16_t ratio = (uint16_t)( ( (uint32_t)sinElevation << 15 ) / gcrQ15 );
+  int32_t clearAngle;
+  if( ratio > SIN_45_Q15 )
+  {
+    // Near the shading threshold take the cosine from the exact difference
+    // gcr^2 - sin^2 rather than from the rounded ratio
+    uint32_t difference = (uint32_t)gcrQ15 * gcrQ15 - (uint32_t)sinElevation * sinElevation;
+    uint16_t cosQ15 = (uint16_t)( ( squareRoot( difference ) << 15 ) / gcrQ15 );
+    clearAngle = QUARTER_TURN_MDEG - asinMdeg( cosQ15 );
+  }
+  else
+  {
+    clearAngle = asinMdeg( ratio );
+  }
+  int32_t tilt = clearAngle - sunElevationMdeg;
+  return ( tilt > 0 ) ? tilt : 0;
+}
+
+uint16_t Backtracker::sinQ15( int32_t angleMdeg )
+{
+  if( angleMdeg <= 0 )
+  {
+    return 0;
+  }
+  if( angleMdeg >= QUARTER_TURN_MDEG )
+  {
+    return 32768U;
+  }
+  // Linear interpolation between whole degrees (error below 3 LSB)
+  uint8_t degree = (uint8_t)( angleMdeg / 1000 );
+  uint16_t fraction = (uint16_t)( angleMdeg % 1000 );
+  uint16_t low = pgm_read_word( &SIN_TABLE_Q15[degree] );
+  uint16_t high = pgm_read_word( &SIN_TABLE_Q15[degree + 1] );
+  return low + (uint16_t)( (uint32_t)( high - low ) * fraction / 1000 );
+}
+
+int32_t Backtracker::asinMdeg( uint16_t valueQ15 )
+{
+  if( valueQ15 >= 32768U )
+  {
+    return QUARTER_TURN_MDEG;
+  }
+  // The table is flat near 90 degrees; use asin(x) = 90 - asin(sqrt(1 - x^2)) there
+  if( valueQ15 > SIN_45_Q15 )
+  {
+    uint32_t cosQ15 = squareRoot( ( 1UL << 30 ) - (uint32_t)valueQ15 * valueQ15 );
+    return QUARTER_TURN_MDEG - asinMdeg( (uint16_t)cosQ15 );
+  }
+
+  // Binary search for the whole degree below the value, then interpolate
+  uint8_t low = 0;
+  uint8_t high = 90;
+  while( high - low > 1 )
+  {
+    uint8_t middle = ( low + high ) / 2;
+    if( pgm_read_word( &SIN_TABLE_Q15[middle] ) <= valueQ15 )
+    {
+      low = middle;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  uint16_t lowValue = pgm_read_word( &SIN_TABLE_Q15[low] );
+  uint16_t highValue = pgm_read_word( &SIN_TABLE_Q15[high] );
+  return low * 1000L + (int32_t)( (uint32_t)( valueQ15 - lowValue ) * 1000 / ( highValue - lowValue ));
+}
@@ -0,0 +1,57 @@
+#ifndef BACKTRACKER_H
+#define BACKTRACKER_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+// Row-to-row shading avoidance. The sun's angle across the rotation axis
+// comes from a day clock (dawn to dusk of the learned day length spans
+// full east to full west); while the next row would shade this one, the
+// target tilt is pulled back towards flat until the rows just clear.
+// Angles are millidegrees from flat, west positive; the geometry kernel
+// is fixed-point with a sine table in program memory.
+class Backtracker {
+public:
+  Backtracker();
+
+  // Day clock
+  void startDay( unsigned long currentTime );
+  void endDay( unsigned long currentTime );   // Learns the day length
+  bool isDayStarted() const { return dayStarted; }
+  bool isDayLengthMeasured() const { return dayLengthMeasured; }
+  unsigned long getDayLength() const { return dayLengthMs; }
+
+  // Configuration
+  void setEnabled( bool enabled ) { this->enabled = enabled; }
+  void setRowPitch( uint16_t pitchMm );
+  void setPanelWidth( uint16_t widthMm );
+  bool getEnabled() const { return enabled; }
+  uint16_t getRowPitch() const { return rowPitchMm; }
+  uint16_t getPanelWidth() const { return panelWidthMm; }
+  uint16_t getGroundCoverage() const { return gcrQ15; }   // Panel width / row pitch, Q15
+
+  // Sun-facing tilt from the day clock, and the shade-free tilt
+  int32_t getSunTilt( unsigned long currentTime ) const;
+  int32_t getTargetTilt( unsigned long currentTime ) const;
+  bool isActive( unsigned long currentTime ) const;   // Enabled and the rows would shade
+
+  // Geometry kernel
+  static int32_t getShadeFreeTilt( int32_t sunElevationMdeg, uint16_t gcrQ15 );
+  static uint16_t sinQ15( int32_t angleMdeg );    // 0..90 degrees, 32768 = 1.0
+  static int32_t asinMdeg( uint16_t valueQ15 );   // Inverse of sinQ15
+
+private:
+  bool enabled;
+  uint16_t rowPitchMm;
+  uint16_t panelWidthMm;
+  uint16_t gcrQ15;
+
+  bool dayStarted;
+  bool dayLengthMeasured;
+  unsigned long dawnTime;
+  unsigned long dayLengthMs;
+
+  void updateGroundCoverage();
+};
+
+#endif // BACKTRACKER_H
@@ -0,0 +1,205 @@
+#include "CloudDetector.h"
+#include <math.h>
+
+//***********************************************************
+//     Constructor: CloudDetector
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Initializes the detector with the defaults from
+//       param_config.h and empty statistics.
+//
+//***********************************************************
+CloudDetector::CloudDetector()
+  : enabled(TRACKER_CLOUD_DETECT_ENABLED),
+    thresholdPercent(TRACKER_CLOUD_THRESHOLD_PERCENT),
+    holdoffMs(TRACKER_CLOUD_HOLDOFF_SECONDS * 1000UL)
+{
+  reset();
+}
+
+//***********************************************************
+//     Function Name: reset
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Discards all accumulated statistics. The detector reports
+//       stable until the next unstable window is seen.
+//
+//***********************************************************
+void CloudDetector::reset()
+{
+  windowCount = 0;
+  windowStartTime = 0;
+  brightnessMean = 0.0f;
+  brightnessM2 = 0.0f;
+  differenceMean = 0.0f;
+  differenceM2 = 0.0f;
+  hasPreviousWindow = false;
+  previousBrightnessMean = 0.0f;
+  previousDifferenceMean = 0.0f;
+  brightnessCvPercent = 0.0f;
+  brightnessRatePercentPerS = 0.0f;
+  differenceStdPercent = 0.0f;
+  differenceRatePercentPerS = 0.0f;
+  everUnstable = false;
+  lastUnstableTime = 0;
+}
+
+//***********************************************************
+//     Function Name: setThreshold
+//
+//     Inputs:
+//     - thresholdPercent : Sensitivity in percent (lower is
+//                          more sensitive)
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Sets the limit applied to the brightness coefficient of
+//       variation, the difference deviation and both rates of
+//       change (per second).
+//
+//***********************************************************
+void CloudDetector::setThreshold( float thresholdPercent )
+{
+  if( thresholdPercent > 0.0f )
+  {
+    this->thresholdPercent = thresholdPercent;
+  }
+}
+
+//***********************************************************
+//     Function Name: addSample
+//
+//     Inputs:
+//     - eastValue : Filtered east sensor resistance in ohms
+//     - westValue : Filtered west sensor resistance in ohms
+//     - currentTime : millis() timestamp of the sample
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Updates the running mean and variance of the average
+//       brightness and of the east/west difference (percent of
+//       the brighter side) using Welford's method. Every
+//       TRACKER_CLOUD_WINDOW_SAMPLES samples the window is closed
+//       and evaluated.
+//
+//***********************************************************
+void CloudDetector::addSample( float eastValue, float westValue, unsigned long currentTime )
+{
+  float lowerValue = ( eastValue < westValue ) ? eastValue : westValue;
+  if( lowerValue <= 0.0f )
+  {
+    return;
+  }
+  float brightness = ( eastValue + westValue ) / 2.0f;
+  float difference = (( eastValue - westValue ) / lowerValue ) * 100.0f;
+
+  if( windowCount == 0 )
+  {
+    windowStartTime = currentTime;
+  }
+  windowCount++;
+
+  // Welford update: mean and sum of squared deviations
+  float delta = brightness - brightnessMean;
+  brightnessMean += delta / windowCount;
+  brightnessM2 += delta * ( brightness - brightnessMean );
+
+  delta = difference - differenceMean;
+  differenceMean += delta / windowCount;
+  differenceM2 += delta * ( difference - differenceMean );
+
+  if( windowCount >= TRACKER_CLOUD_WINDOW_SAMPLES )
+  {
+    closeWindow( currentTime );
+  }
+}
+
+//***********************************************************
+//     Function Name: closeWindow
+//
+//     Inputs:
+//     - currentTime : millis() timestamp of the last sample
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Converts the window statistics into variation and
+//       rate-of-change metrics, flags the window as unstable when
+//       any metric exceeds the threshold and starts a new window.
+//
+//***********************************************************
+void CloudDetector::closeWindow( unsigned long currentTime )
+{
+  float windowS = ( currentTime - windowStartTime ) / 1000.0f;
+  if( windowS <= 0.0f )
+  {
+    windowS = ( TRACKER_CLOUD_WINDOW_SAMPLES * PHOTOSENSOR_SAMPLING_RATE_MS ) / 1000.0f;
+  }
+
+  brightnessCvPercent = ( brightnessMean > 0.0f ) ?
+                        ( sqrt( brightnessM2 / ( windowCount - 1 )) / brightnessMean ) * 100.0f : 0.0f;
+  differenceStdPercent = sqrt( differenceM2 / ( windowCount - 1 ));
+
+  if( hasPreviousWindow && previousBrightnessMean > 0.0f )
+  {
+    brightnessRatePercentPerS = ( fabs( brightnessMean - previousBrightnessMean ) /
+                                  previousBrightnessMean ) * 100.0f / windowS;
+    differenceRatePercentPerS = fabs( differenceMean - previousDifferenceMean ) / windowS;
+  }
+
+  if( brightnessCvPercent > thresholdPercent ||
+      differenceStdPercent > thresholdPercent ||
+      brightnessRatePercentPerS > thresholdPercent ||
+      differenceRatePercentPerS > thresholdPercent )
+  {
+    everUnstable = true;
+    lastUnstableTime = currentTime;
+  }
+
+  previousBrightnessMean = brightnessMean;
+  previousDifferenceMean = differenceMean;
+  hasPreviousWindow = true;
+
+  windowCount = 0;
+  brightnessMean = 0.0f;
+  brightnessM2 = 0.0f;
+  differenceMean = 0.0f;
+  differenceM2 = 0.0f;
+}
+
+//***********************************************************
+//     Function Name: isStable
+//
+//     Inputs:
+//     - currentTime : Current millis() timestamp
+//
+//     Returns:
+//     - bool : true when disabled, or when no unstable window has
+//              been seen for at least the hold-off time
+//
+//     Description:
+//     - Used by the tracker to gate IDLE to ADJUSTING transitions.
+//
+//***********************************************************
+bool CloudDetector::isStable( unsigned long currentTime ) const
+{
+  if( !enabled || !everUnstable )
+  {
+    return true;
+  }
+  return ( currentTime - lastUnstableTime ) >= holdoffMs;
+}
@@ -0,0 +1,63 @@
+#ifndef CLOUD_DETECTOR_H
+#define CLOUD_DETECTOR_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+class CloudDetector {
+public:
+  CloudDetector();
+  void reset();
+
+  // Feed one east/west sample pair (filtered ohms)
+  void addSample( float eastValue, float westValue, unsigned long currentTime );
+
+  // True once no instability has been seen for the hold-off time
+  bool isStable( unsigned long currentTime ) const;
+
+  // Configuration
+  void setEnabled( bool enabled ) { this->enabled = enabled; }
+  void setThreshold( float thresholdPercent );
+  void setHoldoffTime( unsigned long holdoffSeconds ) { holdoffMs = holdoffSeconds * 1000UL; }
+
+  // Getters for configuration
+  bool getEnabled() const { return enabled; }
+  float getThreshold() const { return thresholdPercent; }
+  unsigned long getHoldoffTime() const { return holdoffMs / 1000UL; }
+
+  // Statistics of the last completed window
+  float getBrightnessVariationPercent() const { return brightnessCvPercent; }
+  float getBrightnessRatePercent() const { return brightnessRatePercentPerS; }
+  float getDifferenceDeviationPercent() const { return differenceStdPercent; }
+  float getDifferenceRatePercent() const { return differenceRatePercentPerS; }
+
+private:
+  bool enabled;
+  float thresholdPercent;           // Sensitivity for all variation and rate metrics
+  unsigned long holdoffMs;          // Calm time required after the last unstable window
+
+  // Running (Welford) statistics for the current window
+  uint16_t windowCount;
+  unsigned long windowStartTime;
+  float brightnessMean;
+  float brightnessM2;
+  float differenceMean;
+  float differenceM2;
+
+  // Means of the previous window for rate-of-change
+  bool hasPreviousWindow;
+  float previousBrightnessMean;
+  float previousDifferenceMean;
+
+  // Results of the last completed window
+  float brightnessCvPercent;
+  float brightnessRatePercentPerS;
+  float differenceStdPercent;
+  float differenceRatePercentPerS;
+  bool everUnstable;
+  unsigned long lastUnstableTime;
+
+  void closeWindow( unsigned long currentTime );
+};
+
+#endif // CLOUD_DETECTOR_H
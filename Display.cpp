@@ -184,8 +184,8 @@ void DisplayModule_drawData( DisplayModule_t* module, float volts, float amps, i
 //     - None
 //
 //     Description:
-//     - Updates the display with current sensor data, generates demo
-//       voltage/current data, calculates power, updates the graph,
+//     - Updates the display with current sensor data, reads panel
+//       voltage/current from the power sensor, updates the graph,
 //       and refreshes the display every second.
 //
 //***********************************************************
@@ -196,11 +196,16 @@ void updateDisplay( DisplayModule_t* displayModule, Graph_t* graph, PhotoSensor*
   if( currentSecs > lastUpdate )
   {
     lastUpdate = currentSecs;
-    unsigned long elapsed = currentSecs - startTime;
 
-    // Generate demo data
-    float volts = 12 + 2 * sin( 2 * PI * elapsed / 30.0 );
-    float amps = 10 + 3 * sin( 2 * PI * elapsed / 53.0 );
+    // Read panel voltage and current
+    float volts = 0.0f;
+    float amps = 0.0f;
+    PowerSensor* powerSensor = tracker.getPowerSensor();
+    if( powerSensor != nullptr )
+    {
+      volts = powerSensor->getVoltage();
+      amps = powerSensor->getCurrent();
+    }
 
     // Read photoresistor values (filtered)
     int32_t east = (int32_t)eastSensor->getFilteredValue();
@@ -5,7 +5,9 @@ Eeprom eeprom;
 
 Eeprom::Eeprom()
   : settings( nullptr ),
-    isInitialized( false )
+    isInitialized( false ),
+    positionSlot( POSITION_SLOTS - 1 ),
+    positionSequence( 0 )
 {
 }
 
@@ -25,7 +27,7 @@ void Eeprom::loadParameters( Settings* settings )
     Parameter* param = settings->getParameter( i );
     if( param )
     {
-      int offset = getParameterOffset( param->meta.name );
+      int offset = getParameterOffset( i );
       float value = readFloat( offset );
       param->currentValue = value;
     }
@@ -77,7 +79,7 @@ void Eeprom::initializeEeprom( Settings* settings )
       Parameter* param = settings->getParameter( i );
       if( param )
       {
-        int offset = getParameterOffset( param->meta.name );
+        int offset = getParameterOffset( i );
         writeFloat( offset, param->currentValue );
       }
     }
@@ -163,13 +165,10 @@ int Eeprom::getParameterOffset( const char* name )
     return PARAMETERS_OFFSET;
     
   // Find parameter index by name or short name
-  for( int i = 0; i < settings->getParameterCount(); i++ )
+  int index = settings->findParameterIndex( name );
+  if( index >= 0 )
   {
-    Parameter* param = settings->getParameter( i );
-    if( param && ( strcasecmp( param->meta.name, name ) == 0 || strcasecmp( param->meta.shortName, name ) == 0 ) )
-    {
-      return PARAMETERS_OFFSET + ( i * sizeof( float ) );
-    }
+    return getParameterOffset( index );
   }
   
   // Parameter not found - this should never happen!
@@ -179,6 +178,11 @@ int Eeprom::getParameterOffset( const char* name )
   return PARAMETERS_OFFSET;  // Return first parameter offset as fallback
 }
 
+int Eeprom::getParameterOffset( int index )
+{
+  return PARAMETERS_OFFSET + ( index * sizeof( float ) );
+}
+
 void Eeprom::writeFloat( int offset, float value )
 {
   uint8_t* bytes = (uint8_t*)&value;
@@ -227,4 +231,199 @@ void Eeprom::writeUint8( int offset, uint8_t value )
 uint8_t Eeprom::readUint8( int offset )
 {
   return EEPROM.read( offset );
-} 
\ No newline at end of file
+} 
+//***********************************************************
+//     Function Name: loadShadingMap
+//
+//     Inputs:
+//     - scores : Receives the slot scores
+//     - count : Number of slots
+//
+//     Returns:
+//     - bool : True if a valid map was read
+//
+//     Description:
+//     - Reads the shading map region. The map has its own version
+//       and checksum so parameter layout changes do not clear it.
+//
+//***********************************************************
+bool Eeprom::loadShadingMap( uint8_t* scores, uint8_t count )
+{
+  if( readUint8( SHADING_MAP_OFFSET ) != SHADING_MAP_VERSION )
+    return false;
+
+  uint8_t checksum = 0;
+  for( uint8_t i = 0; i < count; i++ )
+  {
+    scores[i] = readUint8( SHADING_MAP_OFFSET + 2 + i );
+    checksum += scores[i];
+  }
+  return ( checksum == readUint8( SHADING_MAP_OFFSET + 1 ));
+}
+
+//***********************************************************
+//     Function Name: saveShadingMap
+//
+//     Inputs:
+//     - scores : Slot scores to store
+//     - count : Number of slots
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Writes the shading map region. Only changed bytes are
+//       written to limit EEPROM wear from the daily save.
+//
+//***********************************************************
+void Eeprom::saveShadingMap( const uint8_t* scores, uint8_t count )
+{
+  uint8_t checksum = 0;
+  for( uint8_t i = 0; i < count; i++ )
+  {
+    EEPROM.update( SHADING_MAP_OFFSET + 2 + i, scores[i] );
+    checksum += scores[i];
+  }
+  EEPROM.update( SHADING_MAP_OFFSET + 1, checksum );
+  EEPROM.update( SHADING_MAP_OFFSET, SHADING_MAP_VERSION );
+}
+
+//***********************************************************
+//     Function Name: loadRowConfig
+//
+//     Inputs:
+//     - config : Receives the row configuration bytes
+//     - count : Number of bytes
+//
+//     Returns:
+//     - bool : True if a valid configuration was read
+//
+//     Description:
+//     - Reads the row configuration region, checked the same way
+//       as the shading map. A different row count invalidates it.
+//
+//***********************************************************
+bool Eeprom::loadRowConfig( uint8_t* config, uint8_t count )
+{
+  if( readUint8( ROW_CONFIG_OFFSET ) != ROW_CONFIG_VERSION )
+    return false;
+
+  uint8_t checksum = count;
+  for( uint8_t i = 0; i < count; i++ )
+  {
+    config[i] = readUint8( ROW_CONFIG_OFFSET + 2 + i );
+    checksum += config[i];
+  }
+  return ( checksum == readUint8( ROW_CONFIG_OFFSET + 1 ));
+}
+
+//***********************************************************
+//     Function Name: saveRowConfig
+//
+//     Inputs:
+//     - config : Row configuration bytes to store
+//     - count : Number of bytes
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Writes the row configuration region, changed bytes only.
+//
+//***********************************************************
+void Eeprom::saveRowConfig( const uint8_t* config, uint8_t count )
+{
+  uint8_t checksum = count;
+  for( uint8_t i = 0; i < count; i++ )
+  {
+    EEPROM.update( ROW_CONFIG_OFFSET + 2 + i, config[i] );
+    checksum += config[i];
+  }
+  EEPROM.update( ROW_CONFIG_OFFSET + 1, checksum );
+  EEPROM.update( ROW_CONFIG_OFFSET, ROW_CONFIG_VERSION );
+}
+
+//***********************************************************
+//     Function Name: loadPanelPosition
+//
+//     Inputs:
+//     - record : Receives the position record
+//     - count : Record size (at most POSITION_SLOT_SIZE - 2)
+//
+//     Returns:
+//     - bool : True if a valid record was found
+//
+//     Description:
+//     - Finds the newest valid slot of the position ring. Slots are
+//       written in order with increasing sequence numbers, so the
+//       newest is the valid slot whose successor does not continue
+//       the sequence.
+//
+//***********************************************************
+bool Eeprom::loadPanelPosition( uint8_t* record, uint8_t count )
+{
+  bool found = false;
+  for( uint8_t slot = 0; slot < POSITION_SLOTS && !found; slot++ )
+  {
+    int offset = POSITION_OFFSET + slot * POSITION_SLOT_SIZE;
+    if( readUint8( offset + 1 ) != getPositionChecksum( offset, count ))
+      continue;
+
+    int next = POSITION_OFFSET + (( slot + 1 ) % POSITION_SLOTS ) * POSITION_SLOT_SIZE;
+    uint8_t sequence = readUint8( offset );
+    if( readUint8( next ) == (uint8_t)( sequence + 1 ) &&
+        readUint8( next + 1 ) == getPositionChecksum( next, count ))
+      continue;  // A newer record follows
+
+    positionSlot = slot;
+    positionSequence = sequence;
+    for( uint8_t i = 0; i < count; i++ )
+    {
+      record[i] = readUint8( offset + 2 + i );
+    }
+    found = true;
+  }
+  return found;
+}
+
+//***********************************************************
+//     Function Name: savePanelPosition
+//
+//     Inputs:
+//     - record : Position record to store
+//     - count : Record size (at most POSITION_SLOT_SIZE - 2)
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Writes the record to the slot after the newest one. The
+//       position changes after every move, so rotating over the
+//       slots divides the wear on each cell by POSITION_SLOTS.
+//       The checksum is written last, so a slot cut short by a
+//       reset fails validation and the previous record is used.
+//
+//***********************************************************
+void Eeprom::savePanelPosition( const uint8_t* record, uint8_t count )
+{
+  positionSlot = ( positionSlot + 1 ) % POSITION_SLOTS;
+  positionSequence++;
+  int offset = POSITION_OFFSET + positionSlot * POSITION_SLOT_SIZE;
+
+  for( uint8_t i = 0; i < count; i++ )
+  {
+    EEPROM.update( offset + 2 + i, record[i] );
+  }
+  EEPROM.update( offset, positionSequence );
+  EEPROM.update( offset + 1, getPositionChecksum( offset, count ));
+}
+
+uint8_t Eeprom::getPositionChecksum( int slotOffset, uint8_t count )
+{
+  uint8_t checksum = POSITION_VERSION + readUint8( slotOffset );
+  for( uint8_t i = 0; i < count; i++ )
+  {
+    checksum += readUint8( slotOffset + 2 + i );
+  }
+  return checksum;
+}
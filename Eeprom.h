@@ -16,8 +16,20 @@ public:
   bool isValid() const { return isInitialized; }  // Public method to check validity
   float readParameterValue( const char* name );  // New method to read a parameter value
 
+  // Shading map storage (separate region, independent of parameter layout)
+  bool loadShadingMap( uint8_t* scores, uint8_t count );
+  void saveShadingMap( const uint8_t* scores, uint8_t count );
+
+  // Extra tracker row configuration (separate region, like the shading map)
+  bool loadRowConfig( uint8_t* config, uint8_t count );
+  void saveRowConfig( const uint8_t* config, uint8_t count );
+
+  // Panel position record, rotated over several slots to spread wear
+  bool loadPanelPosition( uint8_t* record, uint8_t count );
+  void savePanelPosition( const uint8_t* record, uint8_t count );
+
 private:
-  static const uint8_t EEPROM_VERSION = 0x01;  // Increment when parameter layout changes
+  static const uint8_t EEPROM_VERSION = 0x11;  // Increment when parameter layout changes
   static const uint32_t MAGIC_NUMBER = 0xA55A0001;  // Used to detect if EEPROM is initialized
   
   // EEPROM layout offsets
@@ -25,10 +37,20 @@ private:
   static const int MAGIC_NUMBER_OFFSET = 1;     // 4 bytes
   static const int CHECKSUM_OFFSET = 5;         // 4 bytes
   static const int PARAMETERS_OFFSET = 9;       // Start of parameter values
+  static const int SHADING_MAP_OFFSET = 1024;   // 1 byte version, 1 byte checksum, slot scores
+  static const uint8_t SHADING_MAP_VERSION = 0x01;
+  static const int ROW_CONFIG_OFFSET = 1152;    // 1 byte version, 1 byte checksum, row config
+  static const uint8_t ROW_CONFIG_VERSION = 0x01;
+  static const int POSITION_OFFSET = 1184;      // Slots of 1 byte sequence, 1 byte checksum, record
+  static const uint8_t POSITION_SLOTS = 8;
+  static const uint8_t POSITION_SLOT_SIZE = 16; // Room for the record and its header
+  static const uint8_t POSITION_VERSION = 0x01;
   
   // Parameter storage
   Settings* settings;
   bool isInitialized;
+  uint8_t positionSlot;       // Slot holding the newest position record
+  uint8_t positionSequence;   // Its sequence number
   
   // Helper functions
   void initializeEeprom( Settings* settings );
@@ -36,12 +58,14 @@ private:
   uint32_t calculateChecksum();
   void updateChecksum();
   int getParameterOffset( const char* name );
+  int getParameterOffset( int index );
   void writeFloat( int offset, float value );
   float readFloat( int offset );
   void writeUint32( int offset, uint32_t value );
   uint32_t readUint32( int offset );
   void writeUint8( int offset, uint8_t value );
   uint8_t readUint8( int offset );
+  uint8_t getPositionChecksum( int slotOffset, uint8_t count );
 };
 
 // Global EEPROM instance declaration
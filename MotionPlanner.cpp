@@ -0,0 +1,191 @@
+#include "MotionPlanner.h"
+#include <math.h>
+
+//***********************************************************
+//     Constructor: MotionPlanner
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Starts with no learned gain or drift; plans are not
+//       made until a gain has been seeded or learned.
+//
+//***********************************************************
+MotionPlanner::MotionPlanner()
+{
+  reset();
+}
+
+void MotionPlanner::reset()
+{
+  gainValid = false;
+  driftValid = false;
+  msPerPercent = TRACKER_KALMAN_DEFAULT_MS_PER_PERCENT;
+  driftPercentPerMin = 0.0f;
+  reversalTakeUpMs = 0;
+  lastMoveWest = true;
+  observationValid = false;
+  observedErrorPercent = 0.0f;
+  observedRunTimeMs = 0;
+  observationTime = 0;
+}
+
+void MotionPlanner::seedGain( float msPerPercent )
+{
+  if( !gainValid && msPerPercent > 0.0f )
+  {
+    this->msPerPercent = msPerPercent;
+    gainValid = true;
+  }
+}
+
+void MotionPlanner::seedDrift( float driftPercentPerMin )
+{
+  if( !driftValid )
+  {
+    this->driftPercentPerMin = driftPercentPerMin;
+    driftValid = true;
+  }
+}
+
+//***********************************************************
+//     Function Name: observe
+//
+//     Inputs:
+//     - errorPercent : Signed imbalance, positive = west needed
+//     - motorRunTimeMs : Total motor run time
+//     - currentTime : Time of the observation
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - With the panel still, the error changes only with the
+//       sun; each interval of at least
+//       TRACKER_PLANNER_MIN_OBSERVATION_S gives a drift sample.
+//       Shorter intervals keep the older observation so noise
+//       is not divided by a small time. Any motor run since
+//       (night return, another strategy) restarts the interval.
+//
+//***********************************************************
+void MotionPlanner::observe( float errorPercent, unsigned long motorRunTimeMs, unsigned long currentTime )
+{
+  if( observationValid && motorRunTimeMs == observedRunTimeMs )
+  {
+    unsigned long elapsedMs = currentTime - observationTime;
+    if( elapsedMs < TRACKER_PLANNER_MIN_OBSERVATION_S * 1000UL )
+    {
+      return;
+    }
+    float sample = ( errorPercent - observedErrorPercent ) / ( elapsedMs / 60000.0f );
+    driftPercentPerMin = driftValid ?
+                         driftPercentPerMin + TRACKER_DRIFT_ESTIMATE_WEIGHT * ( sample - driftPercentPerMin ) :
+                         sample;
+    driftValid = true;
+  }
+  observationValid = true;
+  observedErrorPercent = errorPercent;
+  observedRunTimeMs = motorRunTimeMs;
+  observationTime = currentTime;
+}
+
+void MotionPlanner::recordMove( float errorBefore, float errorAfter, unsigned long runMs, bool west,
+                                unsigned long takeUpMs, bool reversal, unsigned long motorRunTimeMs,
+                                unsigned long currentTime )
+{
+  // Motor time per percent of error removed
+  float progressPercent = west ? ( errorBefore - errorAfter ) : ( errorAfter - errorBefore );
+  if( runMs > 0 && progressPercent >= TRACKER_DRIFT_MIN_PROGRESS_PERCENT )
+  {
+    float sample = runMs / progressPercent;
+    msPerPercent = gainValid ? msPerPercent + TRACKER_DRIFT_ESTIMATE_WEIGHT * ( sample - msPerPercent ) :
+                               sample;
+    gainValid = true;
+  }
+  if( reversal )
+  {
+    reversalTakeUpMs = takeUpMs;
+  }
+  lastMoveWest = west;
+
+  // Drift is measured from where the move left the error
+  observationValid = true;
+  observedErrorPercent = errorAfter;
+  observedRunTimeMs = motorRunTimeMs;
+  observationTime = currentTime;
+}
+
+//***********************************************************
+//     Function Name: plan
+//
+//     Inputs:
+//     - model : Current error, opportunity spacing and costs
+//
+//     Returns:
+//     - Plan : Cheapest candidate over the horizon
+//
+//     Description:
+//     - Scores not moving, and moving at each opportunity k to
+//       balance or to a lead of up to half the drift over the
+//       rest of the horizon (which balances the squared error
+//       either side of zero). Moves are capped at maxMoveMs and
+//       reversals pay the learned take-up. Only a plan with no
+//       delay is acted on; later opportunities are re-planned.
+//
+//***********************************************************
+MotionPlanner::Plan MotionPlanner::plan( const Model& model ) const
+{
+  float error = model.errorPercent;
+  float drift = driftPercentPerMin;
+  float gain = ( msPerPercent > 1.0f ) ? msPerPercent : 1.0f;
+  float horizonMin = HORIZON_STEPS * model.stepMinutes;
+  float idleCost = model.lossMwhPerPercentSqMin * getSquaredErrorIntegral( error, drift, horizonMin );
+
+  Plan best;
+  best.delaySteps = HORIZON_STEPS;
+  best.west = lastMoveWest;
+  best.durationMs = 0;
+  best.costMwh = idleCost;
+  best.idleCostMwh = idleCost;
+
+  for( uint8_t step = 0; step < HORIZON_STEPS; step++ )
+  {
+    float moveMin = step * model.stepMinutes;
+    float remainingMin = horizonMin - moveMin;
+    float errorAtMove = error + drift * moveMin;
+    float waitCost = model.lossMwhPerPercentSqMin * getSquaredErrorIntegral( error, drift, moveMin );
+
+    for( uint8_t lead = 0; lead < LEAD_STEPS; lead++ )
+    {
+      float target = -drift * remainingMin * 0.5f * lead / ( LEAD_STEPS - 1 );
+      float movePercent = errorAtMove - target;
+      bool west = ( movePercent > 0.0f );
+      float runMs = fabs( movePercent ) * gain;
+      if( runMs > (float)model.maxMoveMs )
+      {
+        runMs = (float)model.maxMoveMs;
+        target = errorAtMove + ( west ? -runMs : runMs ) / gain;
+      }
+      float takeUpMs = ( west != lastMoveWest ) ? (float)reversalTakeUpMs : 0.0f;
+      float cost = waitCost +
+                   model.lossMwhPerPercentSqMin * getSquaredErrorIntegral( target, drift, remainingMin ) +
+                   model.motorMwhPerMs * ( runMs + takeUpMs ) + model.startCostMwh;
+      if( cost < best.costMwh )
+      {
+        best.delaySteps = step;
+        best.west = west;
+        best.durationMs = (unsigned long)runMs;
+        best.costMwh = cost;
+      }
+    }
+  }
+  return best;
+}
+
+float MotionPlanner::getSquaredErrorIntegral( float startPercent, float ratePerMin, float minutes )
+{
+  // Integral over [0, T] of (e + r t)^2 dt
+  return minutes * ( startPercent * startPercent + startPercent * ratePerMin * minutes +
+                     ratePerMin * ratePerMin * minutes * minutes / 3.0f );
+}
@@ -0,0 +1,81 @@
+#ifndef MOTION_PLANNER_H
+#define MOTION_PLANNER_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+// Short-horizon model-predictive move planning. The tracking error (signed
+// imbalance percent, positive when the panel should move west) drifts
+// linearly with the sun, and a move of t ms removes t / gain percent after
+// any backlash take-up. Each candidate plan - move at one of the next few
+// adjustment opportunities, aiming at balance or past it into the drift, or
+// do not move - is scored by the yield lost to misalignment over the horizon
+// plus motor energy and a fixed cost per start. Scores are closed form, so
+// a plan always takes the same CANDIDATE_COUNT evaluations.
+class MotionPlanner {
+public:
+  static const uint8_t HORIZON_STEPS = TRACKER_PLANNER_HORIZON_STEPS;
+  static const uint8_t LEAD_STEPS = 3;      // Aim at balance, half and full lead
+  static const uint8_t CANDIDATE_COUNT = HORIZON_STEPS * LEAD_STEPS + 1;   // Plus no move
+
+  // Costs and limits for one plan; the planner supplies drift and gain
+  struct Model
+  {
+    float errorPercent;               // Signed imbalance now, positive = west needed
+    float stepMinutes;                // Time between adjustment opportunities
+    float lossMwhPerPercentSqMin;     // Yield lost per (percent error)^2 per minute
+    float motorMwhPerMs;              // Motor energy per ms of run time
+    float startCostMwh;               // Fixed cost of one motor start
+    unsigned long maxMoveMs;          // Longest single move
+  };
+
+  struct Plan
+  {
+    uint8_t delaySteps;               // Opportunities to wait; HORIZON_STEPS = no move
+    bool west;
+    unsigned long durationMs;         // Run time after any backlash take-up
+    float costMwh;                    // Predicted cost of this plan over the horizon
+    float idleCostMwh;                // Predicted cost of not moving
+  };
+
+  MotionPlanner();
+  void reset();   // Forget the learned model
+
+  // Gain and drift learned by sensor balancing, used until the planner has its own
+  void seedGain( float msPerPercent );
+  void seedDrift( float driftPercentPerMin );
+
+  // The error at an opportunity; motorRunTimeMs (total motor run time)
+  // tells whether anything moved the panel since the last observation
+  void observe( float errorPercent, unsigned long motorRunTimeMs, unsigned long currentTime );
+  // A finished planned move: errors before and after, and run time after take-up
+  void recordMove( float errorBefore, float errorAfter, unsigned long runMs, bool west,
+                   unsigned long takeUpMs, bool reversal, unsigned long motorRunTimeMs,
+                   unsigned long currentTime );
+
+  Plan plan( const Model& model ) const;
+
+  // Learned model
+  bool isGainValid() const { return gainValid; }
+  float getGain() const { return msPerPercent; }                 // Motor ms per percent
+  float getDriftRate() const { return driftPercentPerMin; }      // Percent per minute, + = west
+  unsigned long getReversalTakeUp() const { return reversalTakeUpMs; }
+  bool getLastMoveWest() const { return lastMoveWest; }
+
+private:
+  bool gainValid;
+  bool driftValid;
+  float msPerPercent;
+  float driftPercentPerMin;
+  unsigned long reversalTakeUpMs;   // Backlash take-up seen on the last reversal
+  bool lastMoveWest;
+
+  bool observationValid;
+  float observedErrorPercent;
+  unsigned long observedRunTimeMs;
+  unsigned long observationTime;
+
+  static float getSquaredErrorIntegral( float startPercent, float ratePerMin, float minutes );
+};
+
+#endif // MOTION_PLANNER_H
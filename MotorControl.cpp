@@ -1,21 +1,88 @@
 #include "MotorControl.h"
-#include "pins_config.h"
 
-MotorControl::MotorControl()
-  : state(STOPPED),
+MotorControl* MotorControl::timerMotors[MotorControl::MAX_TIMER_MOTORS];
+uint8_t MotorControl::timerMotorCount = 0;
+
+#if defined(TIMSK5)
+// Timer5 is not used by millis(), the PWM pins of the two axes or the
+// serial port; it ticks at 1 kHz to cut motor outputs on time
+ISR(TIMER5_COMPA_vect) {
+  MotorControl::onTimerTick();
+}
+#endif
+
+MotorControl::MotorControl(uint8_t eastPin, uint8_t westPin)
+  : eastPin(eastPin),
+  westPin(westPin),
+  state(STOPPED),
   moveStartTime(0),
   deadTimeStart(0),
-  pendingCommand(PENDING_NONE),
   isInitialized(false),
-  deadTimeMs(MOTOR_DEAD_TIME_MS)
+  deadTimeMs(MOTOR_DEAD_TIME_MS),
+  totalRunTimeMs(0),
+  startCount(0),
+  startLimitEnabled(MOTOR_START_LIMIT_ENABLED),
+  startBurst(MOTOR_START_BURST),
+  startRefillPerHour(MOTOR_START_REFILL_PER_HOUR),
+  startTokens(MOTOR_START_BURST),
+  lastRefillTime(0),
+  deniedStartCount(0),
+  priorityStartCount(0),
+  lastDirection(DIRECTION_NONE),
+  reversalMove(false),
+  backlashMs(MOTOR_BACKLASH_MS),
+  backlashLearnEnabled(MOTOR_BACKLASH_LEARN_ENABLED),
+  forwardLatencyValid(false),
+  reversalLatencyValid(false),
+  forwardLatencyMs(0.0f),
+  reversalLatencyMs(0.0f),
+  reversalCount(0),
+  softLimitsEnabled(MOTOR_SOFT_LIMITS_ENABLED),
+  softLimitMarginDeg(MOTOR_SOFT_LIMIT_MARGIN_DEGREES),
+  returningEast(false),
+  returnEastMs(0),
+  softLimitStopCount(0),
+  pwmEnabled(MOTOR_PWM_ENABLED),
+  pwmAvailable(false),
+  pwmMove(false),
+  approachPercent(MOTOR_PWM_APPROACH_PERCENT),
+  duty(0),
+  approachCount(0),
+  timerAvailable(false),
+  timerTicksRemaining(0),
+  timerCut(false),
+  timerCutTime(0),
+  timedMoveEndMs(0),
+  timerStopCount(0),
+  queueHead(0),
+  queueCount(0),
+  nextCommandId(1),
+  lastCommandId(0),
+  activeId(0),
+  activeStop(false),
+  activeHoldMs(0),
+  activeStartTime(0),
+  lastStopTime(0),
+  deadlineReached(false),
+  commandDoneCallback(nullptr),
+  commandDoneContext(nullptr),
+  queuedCommandCount(0),
+  coalescedCount(0)
 {
 }
 
 void MotorControl::begin() {
-  pinMode(MOTOR_EAST_PIN, OUTPUT);
-  pinMode(MOTOR_WEST_PIN, OUTPUT);
-  digitalWrite(MOTOR_EAST_PIN, LOW);
-  digitalWrite(MOTOR_WEST_PIN, LOW);
+  pinMode(eastPin, OUTPUT);
+  pinMode(westPin, OUTPUT);
+  digitalWrite(eastPin, LOW);
+  digitalWrite(westPin, LOW);
+  pwmAvailable = isPwmPin(eastPin) && isPwmPin(westPin);
+  if (pwmAvailable) {
+    setPwmFrequency(eastPin);
+    setPwmFrequency(westPin);
+  }
+  if (!isInitialized) registerTimer();
+  lastRefillTime = millis();
   isInitialized = true;
 }
 
@@ -25,84 +92,672 @@ void MotorControl::update() {
   if (state == DEAD_TIME) {
     if ((currentTime - deadTimeStart) >= deadTimeMs) {
       state = STOPPED;
-      if (pendingCommand != PENDING_NONE) {
-        switch (pendingCommand) {
-          case PENDING_EAST: moveEast(); break;
-          case PENDING_WEST: moveWest(); break;
-          case PENDING_STOP: stop(); break;
-          default: break;
-        }
-        pendingCommand = PENDING_NONE;
-      }
+      processQueue();
     }
     return;
   }
   if (state == MOVING_EAST || state == MOVING_WEST) {
-    if ((currentTime - moveStartTime) >= (MOTOR_MAX_MOVE_TIME_SECONDS * 1000)) {
-      stop();
+    bool west = (state == MOVING_WEST);
+    if (timerCut) {
+      finishTimerCut();
+      processQueue();
+      return;
+    }
+    applyDrive(currentTime);
+    if (timedMoveEndMs > 0 && (currentTime - moveStartTime) >= timedMoveEndMs) {
+      // Without the timer interrupt the deadline is kept here, to loop resolution
+      halt(0, currentTime);
+    } else if (returningEast && getDriveTime(currentTime) >= returnEastMs) {
+      // The planned time includes a margin, so the panel is seated at the stop
+      halt(0, currentTime);
+      position.confirmEndStop(false, false);
+    } else if ((currentTime - moveStartTime) >= (MOTOR_MAX_MOVE_TIME_SECONDS * 1000)) {
+      halt(0, currentTime);
+      confirmTimeoutStop(west);
+    } else if (!returningEast && isAtSoftLimit(west, getPositionEstimate())) {
+      halt(0, currentTime);
+      softLimitStopCount++;
     }
   }
+  processQueue();
 }
 
-void MotorControl::moveEast() {
-  if (!isInitialized) return;
-  if (state == MOVING_WEST) {
-    stop();
-    state = DEAD_TIME;
-    deadTimeStart = millis();
-    pendingCommand = PENDING_EAST;
-    return;
+bool MotorControl::moveEast(StartPriority priority) {
+  return command(DIRECTION_EAST, 0, priority);
+}
+
+bool MotorControl::moveWest(StartPriority priority) {
+  return command(DIRECTION_WEST, 0, priority);
+}
+
+// Timed move: the timer interrupt cuts the outputs durationMs after the
+// start (plus any backlash take-up), whenever loop() next gets here
+bool MotorControl::moveFor(Direction direction, unsigned long durationMs, StartPriority priority) {
+  if (direction == DIRECTION_NONE || durationMs == 0) return false;
+  return command(direction, durationMs, priority);
+}
+
+// A direct command replaces whatever plan was queued and runs as a new
+// command; false if the start was refused, also when it would only start
+// after the dead time. Repeating the untimed motion already running, with
+// nothing planned, is coalesced into it.
+bool MotorControl::command(Direction direction, unsigned long durationMs, StartPriority priority) {
+  if (!isInitialized) return false;
+  if (durationMs == 0 && queueCount == 0 && activeId == 0 && timedMoveEndMs == 0 &&
+      state == ((direction == DIRECTION_WEST) ? MOVING_WEST : MOVING_EAST)) {
+    coalescedCount++;
+    return true;
   }
-  if (state == DEAD_TIME) {
-    pendingCommand = PENDING_EAST;
-    return;
+  clearQueue();
+  finishActive(COMMAND_CANCELLED);
+  if (!checkStart(direction, priority)) {
+    // Refused or not, a reversal ends the move against it
+    if (state == ((direction == DIRECTION_WEST) ? MOVING_EAST : MOVING_WEST)) halt(0, millis());
+    return false;
   }
-  if (state == MOVING_EAST) return;
-  ensureSafety();
-  digitalWrite(MOTOR_WEST_PIN, LOW);
-  digitalWrite(MOTOR_EAST_PIN, HIGH);
-  state = MOVING_EAST;
-  moveStartTime = millis();
+  return enqueue(direction, durationMs, priority) != 0;
 }
 
-void MotorControl::moveWest() {
-  if (!isInitialized) return;
-  if (state == MOVING_EAST) {
-    stop();
-    state = DEAD_TIME;
-    deadTimeStart = millis();
-    pendingCommand = PENDING_WEST;
-    return;
+//***********************************************************
+//     Function Name: queueMove
+//
+//     Inputs:
+//     - direction : Direction to run
+//     - durationMs : Run time after any backlash take-up;
+//                    0 = run until the next command
+//     - priority : Start priority
+//
+//     Returns:
+//     - uint8_t : Command id for the completion report; 0 if
+//                 the queue is full
+//
+//     Description:
+//     - Appends a move to the plan. An untimed move that only
+//       repeats the motion already planned (or running, with
+//       nothing queued) is coalesced into it and returns its id.
+//
+//***********************************************************
+uint8_t MotorControl::queueMove(Direction direction, unsigned long durationMs, StartPriority priority) {
+  if (!isInitialized || direction == DIRECTION_NONE) return 0;
+  if (durationMs == 0) {
+    State moving = (direction == DIRECTION_WEST) ? MOVING_WEST : MOVING_EAST;
+    if (queueCount > 0) {
+      const QueuedCommand& last = queue[(queueHead + queueCount - 1) % QUEUE_CAPACITY];
+      if (last.direction == direction && last.durationMs == 0) {
+        coalescedCount++;
+        return last.id;
+      }
+    } else if (activeId == 0 && state == moving) {
+      coalescedCount++;
+      return lastCommandId;
+    }
   }
-  if (state == DEAD_TIME) {
-    pendingCommand = PENDING_WEST;
-    return;
+  return enqueue(direction, durationMs, priority);
+}
+
+uint8_t MotorControl::queueStop(unsigned long holdMs) {
+  if (!isInitialized) return 0;
+  if (holdMs == 0) {
+    if (queueCount > 0) {
+      const QueuedCommand& last = queue[(queueHead + queueCount - 1) % QUEUE_CAPACITY];
+      if (last.direction == DIRECTION_NONE && last.durationMs == 0) {
+        coalescedCount++;
+        return last.id;
+      }
+    } else if (activeId == 0 && state == STOPPED) {
+      coalescedCount++;
+      return lastCommandId;
+    }
+  }
+  return enqueue(DIRECTION_NONE, holdMs, PRIORITY_SAFETY);
+}
+
+uint8_t MotorControl::enqueue(Direction direction, unsigned long durationMs, StartPriority priority) {
+  if (queueCount >= QUEUE_CAPACITY) return 0;
+  QueuedCommand& entry = queue[(queueHead + queueCount) % QUEUE_CAPACITY];
+  entry.id = nextCommandId;
+  entry.direction = direction;
+  entry.priority = priority;
+  entry.durationMs = durationMs;
+  queueCount++;
+  queuedCommandCount++;
+  // Ids wrap but skip 0, which means none
+  uint8_t id = nextCommandId;
+  if (++nextCommandId == 0) nextCommandId = 1;
+  processQueue();
+  return id;
+}
+
+void MotorControl::clearQueue() {
+  while (queueCount > 0) {
+    uint8_t id = queue[queueHead].id;
+    queueHead = (queueHead + 1) % QUEUE_CAPACITY;
+    queueCount--;
+    reportCommand(id, COMMAND_CANCELLED);
   }
-  if (state == MOVING_WEST) return;
+}
+
+void MotorControl::setCommandDoneCallback( CommandDoneCallback callback, void* context ) {
+  commandDoneCallback = callback;
+  commandDoneContext = context;
+}
+
+//***********************************************************
+//     Function Name: processQueue
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Runs queued commands in order. A timed move holds the
+//       queue until the motor stops and a stop until its hold
+//       has passed; untimed moves and plain stops finish as
+//       soon as they are applied. A move against the last
+//       direction first waits out the dead time from the stop.
+//
+//***********************************************************
+void MotorControl::processQueue() {
+  unsigned long currentTime = millis();
+  // A cut not yet seen by update() ends the move before anything is retimed
+  if (timerCut) finishTimerCut();
+  while (true) {
+    if (activeId != 0) {
+      if (activeStop) {
+        if (currentTime - activeStartTime < activeHoldMs) return;
+        finishActive(COMMAND_DONE);
+      } else {
+        if (state == MOVING_EAST || state == MOVING_WEST) return;
+        finishActive(deadlineReached ? COMMAND_DONE : COMMAND_STOPPED);
+      }
+    }
+    if (queueCount == 0 || state == DEAD_TIME) return;
+
+    QueuedCommand entry = queue[queueHead];
+    if (entry.direction == DIRECTION_NONE) {
+      halt(0, currentTime);
+      popCommand();
+      startActive(entry.id, true, entry.durationMs, currentTime);
+      continue;
+    }
+
+    bool west = (entry.direction == DIRECTION_WEST);
+    if (state == (west ? MOVING_EAST : MOVING_WEST)) {
+      halt(0, currentTime);
+    }
+    if (state == STOPPED && lastDirection != DIRECTION_NONE && entry.direction != lastDirection &&
+        (currentTime - lastStopTime) < deadTimeMs) {
+      // Reversing: let the motor come to rest first; update() resumes the queue
+      state = DEAD_TIME;
+      deadTimeStart = lastStopTime;
+      return;
+    }
+
+    popCommand();
+    if (!startMove(entry.direction, entry.priority, entry.durationMs)) {
+      reportCommand(entry.id, COMMAND_REFUSED);
+      continue;
+    }
+    lastCommandId = entry.id;
+    if (entry.durationMs > 0) {
+      startActive(entry.id, false, 0, currentTime);
+    } else {
+      reportCommand(entry.id, COMMAND_DONE);
+    }
+  }
+}
+
+void MotorControl::popCommand() {
+  queueHead = (queueHead + 1) % QUEUE_CAPACITY;
+  queueCount--;
+}
+
+void MotorControl::startActive(uint8_t id, bool stop, unsigned long holdMs, unsigned long currentTime) {
+  activeId = id;
+  activeStop = stop;
+  activeHoldMs = holdMs;
+  activeStartTime = currentTime;
+  lastCommandId = id;
+}
+
+void MotorControl::finishActive(CommandResult result) {
+  if (activeId == 0) return;
+  uint8_t id = activeId;
+  activeId = 0;
+  reportCommand(id, result);
+}
+
+void MotorControl::reportCommand(uint8_t id, CommandResult result) {
+  if (commandDoneCallback != nullptr) {
+    commandDoneCallback(this, id, result, commandDoneContext);
+  }
+}
+
+// Starts from rest, or retimes a move already running this way
+bool MotorControl::startMove(Direction direction, StartPriority priority, unsigned long durationMs) {
+  bool west = (direction == DIRECTION_WEST);
+  State moving = west ? MOVING_WEST : MOVING_EAST;
+  if (state == moving) {
+    // A new duration runs from now; an untimed command runs on until the
+    // next one, with only the safety timeout left armed
+    unsigned long endMs = (durationMs > 0) ? (millis() - moveStartTime) + durationMs : 0;
+    if (armTimer(endMs)) {
+      timedMoveEndMs = endMs;
+      return true;
+    }
+    // Cut since the queue last looked: end that move and start afresh
+    finishTimerCut();
+  }
+  if (!checkStart(direction, priority) || !acquireStart(priority)) return false;
   ensureSafety();
-  digitalWrite(MOTOR_EAST_PIN, LOW);
-  digitalWrite(MOTOR_WEST_PIN, HIGH);
-  state = MOVING_WEST;
-  moveStartTime = millis();
+  digitalWrite(west ? eastPin : westPin, LOW);
+  state = moving;
+  timedMoveEndMs = durationMs;
+  beginMove(direction);
+  applyDrive(moveStartTime);
+  return true;
+}
+
+// Refusals are counted here; a start that passes is not refused when it
+// runs, since the tokens only refill and the position holds while stopped
+bool MotorControl::checkStart(Direction direction, StartPriority priority) {
+  bool west = (direction == DIRECTION_WEST);
+  if (state == (west ? MOVING_WEST : MOVING_EAST)) return true;
+  // Tracking moves may not start into a soft limit; safety moves may
+  if (priority == PRIORITY_TRIM && isAtSoftLimit(west, getPositionEstimate())) {
+    softLimitStopCount++;
+    return false;
+  }
+  if (!canStart(priority)) {
+    deniedStartCount++;
+    return false;
+  }
+  return true;
 }
 
 void MotorControl::stop() {
   if (!isInitialized) return;
+  clearQueue();
+  finishActive(COMMAND_CANCELLED);
+  halt(0, millis());
+}
+
+// The panel stopped turning overrunMs before the stall was seen; only the
+// time up to the arrival counts towards the learned speed
+void MotorControl::stopAtEndStop( unsigned long overrunMs ) {
+  if (!isInitialized) return;
+  if (state != MOVING_EAST && state != MOVING_WEST) return;
+  bool west = (state == MOVING_WEST);
+  clearQueue();
+  halt(overrunMs, millis());
+  position.confirmEndStop(west, true);
+}
+
+// The interrupt already cut the outputs; account for the move up to that instant
+void MotorControl::finishTimerCut() {
+  if (state != MOVING_EAST && state != MOVING_WEST) {
+    disarmTimer();
+    return;
+  }
+  bool west = (state == MOVING_WEST);
+  unsigned long cutTime;
+  noInterrupts();
+  cutTime = timerCutTime;
+  interrupts();
+  bool timeout = (timedMoveEndMs == 0 || timedMoveEndMs > MOTOR_MAX_MOVE_TIME_SECONDS * 1000UL);
+  timerStopCount++;
+  halt(0, cutTime);
+  if (timeout) confirmTimeoutStop(west);
+}
+
+// A move that ran into the safety timeout re-zeroes the estimate only if
+// the estimate already has it at the stop; a slow or PWM-approach move
+// can time out short of it, and a false re-zero would skew the learned speed
+void MotorControl::confirmTimeoutStop( bool west ) {
+  if (position.isAtEndStop(west)) position.confirmEndStop(west, false);
+}
+
+void MotorControl::halt( unsigned long overrunMs, unsigned long stopTime ) {
   ensureSafety();
-  digitalWrite(MOTOR_EAST_PIN, LOW);
-  digitalWrite(MOTOR_WEST_PIN, LOW);
+  disarmTimer();
+  digitalWrite(eastPin, LOW);
+  digitalWrite(westPin, LOW);
+  duty = 0;
+  if (state == MOVING_EAST || state == MOVING_WEST) {
+    lastStopTime = stopTime;
+    deadlineReached = (timedMoveEndMs > 0 && stopTime - moveStartTime >= timedMoveEndMs);
+    totalRunTimeMs += stopTime - moveStartTime;
+    unsigned long panelMs = getPanelRunTime(getDriveTime(stopTime));
+    position.addMove(state == MOVING_WEST, (panelMs > overrunMs) ? panelMs - overrunMs : 0);
+  }
   state = STOPPED;
-  pendingCommand = PENDING_NONE;
+  returningEast = false;
+  timedMoveEndMs = 0;
+}
+
+// Night return: run east for the time the estimate needs to reach the stop
+bool MotorControl::returnEast() {
+  if (!moveEast(PRIORITY_SAFETY)) return false;
+  // Planned after any reversal stop has been integrated
+  returningEast = true;
+  returnEastMs = position.getReturnEastTime() + getTakeUpTime();
+  return true;
+}
+
+int32_t MotorControl::getPositionEstimate() const {
+  if (state == MOVING_EAST || state == MOVING_WEST) {
+    return position.getPositionAfter(state == MOVING_WEST, getPanelRunTime(getDriveTime(millis())));
+  }
+  return position.getPosition();
+}
+
+bool MotorControl::isNearEndStop() const {
+  if (state != MOVING_EAST && state != MOVING_WEST) return false;
+  if (returningEast) return true;
+  if (!position.isKnown()) return false;
+  int32_t zoneMdeg = TRACKER_STALL_END_STOP_ZONE_DEGREES * 1000L;
+  int32_t positionMdeg = getPositionEstimate();
+  if (state == MOVING_WEST) return positionMdeg >= (int32_t)position.getTravel() * 1000L - zoneMdeg;
+  return positionMdeg <= zoneMdeg;
+}
+
+void MotorControl::setSoftLimitsEnabled( bool enabled ) {
+  softLimitsEnabled = enabled;
+}
+
+void MotorControl::setSoftLimitMargin( uint16_t marginDegrees ) {
+  softLimitMarginDeg = marginDegrees;
+}
+
+void MotorControl::setTravel( uint16_t travelDegrees ) {
+  position.setTravel(travelDegrees);
+}
+
+// The panel does not turn while a reversal takes up gear backlash
+unsigned long MotorControl::getPanelRunTime( unsigned long runMs ) const {
+  unsigned long takeUpMs = getTakeUpTime();
+  return (runMs > takeUpMs) ? runMs - takeUpMs : 0;
+}
+
+// Panel speed follows the duty, so a PWM move counts its full-speed equivalent
+unsigned long MotorControl::getDriveTime( unsigned long currentTime ) const {
+  if (pwmMove) return ramp.getEquivalentTime(currentTime);
+  return currentTime - moveStartTime;
+}
+
+bool MotorControl::isAtSoftLimit( bool west, int32_t positionMdeg ) const {
+  if (!softLimitsEnabled || !position.isKnown()) return false;
+  int32_t marginMdeg = softLimitMarginDeg * 1000L;
+  if (west) return positionMdeg >= (int32_t)position.getTravel() * 1000L - marginMdeg;
+  return positionMdeg <= marginMdeg;
 }
 
 MotorControl::State MotorControl::getState() const {
   return state;
 }
 
+unsigned long MotorControl::getTotalRunTime() const {
+  if (state == MOVING_EAST || state == MOVING_WEST) {
+    return totalRunTimeMs + (millis() - moveStartTime);
+  }
+  return totalRunTimeMs;
+}
+
 void MotorControl::ensureSafety() {
   // Add any safety logic here if needed
 }
 
 void MotorControl::setDeadTime( unsigned long deadTimeMs ) {
   this->deadTimeMs = deadTimeMs;
-}
\ No newline at end of file
+}
+void MotorControl::setStartLimitEnabled( bool enabled ) {
+  startLimitEnabled = enabled;
+}
+
+void MotorControl::setStartBurst( uint16_t burst ) {
+  startBurst = burst;
+  if (startTokens > startBurst) startTokens = startBurst;
+}
+
+void MotorControl::setStartRefillRate( uint16_t startsPerHour ) {
+  refillStartTokens();
+  startRefillPerHour = startsPerHour;
+}
+
+bool MotorControl::canStart( StartPriority priority ) {
+  if (!startLimitEnabled || priority == PRIORITY_SAFETY) return true;
+  refillStartTokens();
+  return startTokens > 0;
+}
+
+void MotorControl::refillStartTokens() {
+  unsigned long currentTime = millis();
+  if (startTokens >= startBurst || startRefillPerHour == 0) {
+    lastRefillTime = currentTime;
+    return;
+  }
+  unsigned long intervalMs = 3600000UL / startRefillPerHour;
+  unsigned long earned = (currentTime - lastRefillTime) / intervalMs;
+  if (earned == 0) return;
+  if (earned >= (unsigned long)(startBurst - startTokens)) {
+    startTokens = startBurst;
+    lastRefillTime = currentTime;
+  } else {
+    startTokens += earned;
+    lastRefillTime += earned * intervalMs;  // Keep the partial interval
+  }
+}
+
+bool MotorControl::acquireStart( StartPriority priority ) {
+  if (!startLimitEnabled) return true;
+  refillStartTokens();
+  if (startTokens > 0) {
+    startTokens--;
+    return true;
+  }
+  // Bucket empty: only safety moves may start
+  if (priority == PRIORITY_SAFETY) {
+    priorityStartCount++;
+    return true;
+  }
+  deniedStartCount++;
+  return false;
+}
+
+void MotorControl::beginMove( Direction direction ) {
+  moveStartTime = millis();
+  startCount++;
+  // The first part of a move against the previous direction only takes up gear backlash
+  reversalMove = (lastDirection != DIRECTION_NONE && direction != lastDirection);
+  if (reversalMove) reversalCount++;
+  lastDirection = direction;
+  pwmMove = pwmEnabled && pwmAvailable;
+  ramp.start(moveStartTime);
+  duty = 0;
+  // Every move is cut by the interrupt at its deadline or at the safety timeout
+  if (timedMoveEndMs > 0) timedMoveEndMs += getTakeUpTime();
+  armTimer(timedMoveEndMs);
+}
+
+// Drives the pin for the current direction; pins are only rewritten when the duty changes
+void MotorControl::applyDrive( unsigned long currentTime ) {
+  uint8_t target = pwmMove ? ramp.getDuty(currentTime) : MotorRamp::FULL_DUTY;
+  if (target == duty) return;
+  duty = target;
+  uint8_t pin = (state == MOVING_WEST) ? westPin : eastPin;
+  // Checked with interrupts off so a cut at the deadline is never undone
+  noInterrupts();
+  if (!timerCut) {
+    if (pwmMove) {
+      analogWrite(pin, duty);
+    } else {
+      digitalWrite(pin, HIGH);
+    }
+  }
+  interrupts();
+}
+
+void MotorControl::setApproach() {
+  if (state != MOVING_EAST && state != MOVING_WEST) return;
+  // Night returns are timed and run at full speed
+  if (!pwmMove || returningEast || ramp.isApproach()) return;
+  ramp.setApproach(millis());
+  approachCount++;
+  applyDrive(millis());
+}
+
+void MotorControl::setPwmEnabled( bool enabled ) {
+  pwmEnabled = enabled;  // Applies from the next move
+}
+
+void MotorControl::setRampTime( unsigned long rampMs ) {
+  ramp.setRampTime(rampMs);
+}
+
+void MotorControl::setApproachSpeed( uint8_t percent ) {
+  if (percent > 100) percent = 100;
+  approachPercent = percent;
+  ramp.setApproachDuty(MotorRamp::percentToDuty(percent));
+}
+
+// Adds this motor to the ones the timer interrupt serves, starting the
+// timer with the first
+void MotorControl::registerTimer() {
+#if defined(TIMSK5)
+  if (timerMotorCount >= MAX_TIMER_MOTORS) return;
+  noInterrupts();
+  if (timerMotorCount == 0) {
+    // CTC mode, clock / 64, compare every 250 counts: 1 ms
+    TCCR5A = 0;
+    TCCR5B = _BV(WGM52) | _BV(CS51) | _BV(CS50);
+    TCNT5 = 0;
+    OCR5A = (F_CPU / 64 / 1000) - 1;
+    TIMSK5 |= _BV(OCIE5A);
+  }
+  timerMotors[timerMotorCount++] = this;
+  timerAvailable = true;
+  interrupts();
+#endif
+}
+
+// Counts down to endMs of run time (0 = untimed), or to the safety
+// timeout if that comes first. Returns false, leaving the timer alone, if
+// the interrupt has already cut the move and the cut is not yet finished.
+bool MotorControl::armTimer( unsigned long endMs ) {
+  if (!timerAvailable) return true;
+  unsigned long timeoutMs = MOTOR_MAX_MOVE_TIME_SECONDS * 1000UL;
+  if (endMs == 0 || endMs > timeoutMs) endMs = timeoutMs;
+  unsigned long elapsedMs = millis() - moveStartTime;
+  unsigned long ticks = (endMs > elapsedMs) ? endMs - elapsedMs : 1;
+  if (ticks > UINT16_MAX) ticks = UINT16_MAX;
+  noInterrupts();
+  bool cut = timerCut;
+  if (!cut) timerTicksRemaining = (uint16_t)ticks;
+  interrupts();
+  return !cut;
+}
+
+void MotorControl::disarmTimer() {
+  noInterrupts();
+  timerTicksRemaining = 0;
+  timerCut = false;
+  interrupts();
+}
+
+void MotorControl::onTimerTick() {
+  for (uint8_t i = 0; i < timerMotorCount; i++) {
+    timerMotors[i]->timerTick();
+  }
+}
+
+// Interrupt context: only the pins and the cut flag are touched
+void MotorControl::timerTick() {
+  if (timerTicksRemaining == 0) return;
+  if (--timerTicksRemaining == 0) {
+    digitalWrite(eastPin, LOW);
+    digitalWrite(westPin, LOW);
+    timerCutTime = millis();
+    timerCut = true;
+  }
+}
+
+// Timer0 runs millis() and Timer5 the stop interrupt; neither may be retuned
+bool MotorControl::isPwmPin( uint8_t pin ) {
+  uint8_t timer = digitalPinToTimer(pin);
+  return timer != NOT_ON_TIMER && timer != TIMER0A && timer != TIMER0B &&
+         timer != TIMER5A && timer != TIMER5B && timer != TIMER5C;
+}
+
+// Phase-correct PWM with no prescaler runs at 31 kHz, above hearing and
+// smooth for the motor; the default 490 Hz makes it whine
+void MotorControl::setPwmFrequency( uint8_t pin ) {
+  switch (digitalPinToTimer(pin)) {
+#if defined(TCCR1B)
+    case TIMER1A: case TIMER1B: case TIMER1C:
+      TCCR1B = (TCCR1B & 0xF8) | 0x01;
+      break;
+#endif
+#if defined(TCCR2B)
+    case TIMER2A: case TIMER2B:
+      TCCR2B = (TCCR2B & 0xF8) | 0x01;
+      break;
+#endif
+#if defined(TCCR3B)
+    case TIMER3A: case TIMER3B: case TIMER3C:
+      TCCR3B = (TCCR3B & 0xF8) | 0x01;
+      break;
+#endif
+#if defined(TCCR4B)
+    case TIMER4A: case TIMER4B: case TIMER4C:
+      TCCR4B = (TCCR4B & 0xF8) | 0x01;
+      break;
+#endif
+    default:
+      break;
+  }
+}
+
+void MotorControl::setBacklash( unsigned long backlashMs ) {
+  if (backlashMs > MOTOR_BACKLASH_MAX_MS) backlashMs = MOTOR_BACKLASH_MAX_MS;
+  this->backlashMs = backlashMs;
+}
+
+void MotorControl::setBacklashLearnEnabled( bool enabled ) {
+  backlashLearnEnabled = enabled;
+}
+
+void MotorControl::recordResponseLatency( unsigned long latencyMs, bool reversal ) {
+  // Filtered separately so sensor filter lag cancels out of the difference
+  if (reversal) {
+    if (!reversalLatencyValid) {
+      reversalLatencyMs = latencyMs;
+      reversalLatencyValid = true;
+    } else {
+      reversalLatencyMs += MOTOR_BACKLASH_FILTER_ALPHA * (latencyMs - reversalLatencyMs);
+    }
+  } else {
+    if (!forwardLatencyValid) {
+      forwardLatencyMs = latencyMs;
+      forwardLatencyValid = true;
+    } else {
+      forwardLatencyMs += MOTOR_BACKLASH_FILTER_ALPHA * (latencyMs - forwardLatencyMs);
+    }
+  }
+}
+
+float MotorControl::getLearnedBacklash() const {
+  if (!isBacklashEstimateValid()) return 0.0f;
+  float backlash = reversalLatencyMs - forwardLatencyMs;
+  if (backlash < 0.0f) backlash = 0.0f;
+  if (backlash > MOTOR_BACKLASH_MAX_MS) backlash = MOTOR_BACKLASH_MAX_MS;
+  return backlash;
+}
+
+unsigned long MotorControl::getBacklash() const {
+  if (backlashLearnEnabled && isBacklashEstimateValid()) {
+    return (unsigned long)getLearnedBacklash();
+  }
+  return backlashMs;
+}
@@ -3,6 +3,14 @@
 
 #include <Arduino.h>
 #include "param_config.h"
+#include "pins_config.h"
+#include "PanelPosition.h"
+#include "MotorRamp.h"
+
+class MotorControl;
+
+// Called when a queued command finishes; result is a MotorControl::CommandResult
+typedef void (*CommandDoneCallback)( MotorControl* motor, uint8_t commandId, uint8_t result, void* context );
 
 class MotorControl {
 public:
@@ -13,34 +21,230 @@ public:
     MOVING_WEST,
     DEAD_TIME
   };
-  enum PendingCommand
+  enum Direction
+  {
+    DIRECTION_NONE,
+    DIRECTION_EAST,
+    DIRECTION_WEST
+  };
+  enum StartPriority
+  {
+    PRIORITY_TRIM,    // Tracking moves; refused when the start budget is spent
+    PRIORITY_SAFETY   // Safety and night return; always allowed
+  };
+  enum CommandResult
   {
-    PENDING_NONE,
-    PENDING_EAST,
-    PENDING_WEST,
-    PENDING_STOP
+    COMMAND_DONE,       // Applied; a timed move ran to its deadline
+    COMMAND_STOPPED,    // Timed move ended early (limit, stall or timeout)
+    COMMAND_REFUSED,    // Start refused by the start or soft limit
+    COMMAND_CANCELLED   // Dropped or cut short by a direct command
   };
 
-  MotorControl();
+  MotorControl( uint8_t eastPin = MOTOR_EAST_PIN, uint8_t westPin = MOTOR_WEST_PIN );
   void begin();
   void update();
-  void moveEast();
-  void moveWest();
+  bool moveEast( StartPriority priority = PRIORITY_TRIM );
+  bool moveWest( StartPriority priority = PRIORITY_TRIM );
+  bool moveFor( Direction direction, unsigned long durationMs, StartPriority priority = PRIORITY_TRIM );
+
+  // Command queue: direct commands above replace it and return false when
+  // their start is refused; queued ones run in order, with dead time
+  // inserted between opposite directions. Returns the command id (0 =
+  // queue full) reported to the completion callback
+  uint8_t queueMove( Direction direction, unsigned long durationMs = 0, StartPriority priority = PRIORITY_TRIM );
+  uint8_t queueStop( unsigned long holdMs = 0 );
+  void clearQueue();  // Drop commands not yet started
+  void setCommandDoneCallback( CommandDoneCallback callback, void* context );
+  uint8_t getQueueLength() const { return queueCount; }
+  uint8_t getActiveCommand() const { return activeId; }   // Timed move or stop hold running; 0 = none
+  unsigned long getQueuedCommandCount() const { return queuedCommandCount; }
+  unsigned long getCoalescedCommandCount() const { return coalescedCount; }
   void stop();
   State getState() const;
   void ensureSafety();
   void setDeadTime( unsigned long deadTimeMs );
+
+  // Start rate limiter (token bucket)
+  void setStartLimitEnabled( bool enabled );
+  void setStartBurst( uint16_t burst );
+  void setStartRefillRate( uint16_t startsPerHour );
+  bool canStart( StartPriority priority = PRIORITY_TRIM );
+
+  // Backlash compensation
+  void setBacklash( unsigned long backlashMs );
+  void setBacklashLearnEnabled( bool enabled );
+  void recordResponseLatency( unsigned long latencyMs, bool reversal );
+  unsigned long getBacklash() const;
+  unsigned long getTakeUpTime() const { return reversalMove ? getBacklash() : 0; }
+  bool isReversalMove() const { return reversalMove; }
+  Direction getLastDirection() const { return lastDirection; }
+  unsigned long getMoveStartTime() const { return moveStartTime; }
+
+  // Dead-reckoning position and soft end limits
+  bool returnEast();  // Safety move for the planned time to the east end stop
+  void setSoftLimitsEnabled( bool enabled );
+  void setSoftLimitMargin( uint16_t marginDegrees );
+  void setTravel( uint16_t travelDegrees );
+  bool getSoftLimitsEnabled() const { return softLimitsEnabled; }
+  uint16_t getSoftLimitMargin() const { return softLimitMarginDeg; }
+  uint16_t getTravel() const { return position.getTravel(); }
+  int32_t getPositionEstimate() const;  // Millidegrees west of the east stop, including a move in progress
+  bool isReturningEast() const { return returningEast; }
+  bool isSoftLimitReached( bool west ) const { return isAtSoftLimit( west, getPositionEstimate() ); }
+  unsigned long getSoftLimitStopCount() const { return softLimitStopCount; }
+  bool isNearEndStop() const;  // Moving within the stall zone of the end stop ahead
+  void stopAtEndStop( unsigned long overrunMs );  // Stop on a stall detected at an end stop
+  PanelPosition* getPosition() { return &position; }
+  const PanelPosition* getPosition() const { return &position; }
+
+  // PWM drive: soft-start ramp and slow final approach
+  void setApproach();  // Nearly balanced: cap the duty until the motor stops
+  void setPwmEnabled( bool enabled );
+  void setRampTime( unsigned long rampMs );
+  void setApproachSpeed( uint8_t percent );
+  bool getPwmEnabled() const { return pwmEnabled; }
+  bool isPwmAvailable() const { return pwmAvailable; }   // Both pins on a timer other than Timer0
+  unsigned long getRampTime() const { return ramp.getRampTime(); }
+  uint8_t getApproachSpeed() const { return approachPercent; }
+  uint8_t getDuty() const { return duty; }   // Duty applied now, 0-255
+  bool isApproaching() const { return pwmMove && ramp.isApproach(); }
+  unsigned long getApproachCount() const { return approachCount; }
+
+  // Timer interrupt: cuts timed moves at their deadline and any move at the safety timeout
+  static void onTimerTick();   // Called from the timer compare interrupt
+  bool isTimerAvailable() const { return timerAvailable; }
+  bool isTimedMove() const { return timedMoveEndMs > 0; }
+  unsigned long getTimerStopCount() const { return timerStopCount; }
   
   // Getters for configuration
   unsigned long getDeadTime() const { return deadTimeMs; }
+  bool getStartLimitEnabled() const { return startLimitEnabled; }
+  uint16_t getStartBurst() const { return startBurst; }
+  uint16_t getStartRefillRate() const { return startRefillPerHour; }
+  unsigned long getConfiguredBacklash() const { return backlashMs; }
+  bool getBacklashLearnEnabled() const { return backlashLearnEnabled; }
+
+  // Usage statistics
+  unsigned long getTotalRunTime() const;
+  unsigned long getStartCount() const { return startCount; }
+  uint16_t getStartTokens() const { return startTokens; }
+  unsigned long getDeniedStartCount() const { return deniedStartCount; }
+  unsigned long getPriorityStartCount() const { return priorityStartCount; }
+  bool isBacklashEstimateValid() const { return forwardLatencyValid && reversalLatencyValid; }
+  float getLearnedBacklash() const;
+  float getForwardLatency() const { return forwardLatencyMs; }
+  float getReversalLatency() const { return reversalLatencyMs; }
+  unsigned long getReversalCount() const { return reversalCount; }
 
 private:
+  uint8_t eastPin;               // East (or up) output
+  uint8_t westPin;               // West (or down) output
   State state;
   unsigned long moveStartTime;
   unsigned long deadTimeStart;
-  PendingCommand pendingCommand;
   bool isInitialized;
   unsigned long deadTimeMs;
+  unsigned long totalRunTimeMs;  // Accumulated time with a motor output energized
+  unsigned long startCount;      // Number of times the motor was started
+
+  // Start rate limiter
+  bool startLimitEnabled;
+  uint16_t startBurst;           // Bucket capacity
+  uint16_t startRefillPerHour;   // Tokens added per hour
+  uint16_t startTokens;          // Starts currently available
+  unsigned long lastRefillTime;  // Time the last token was added
+  unsigned long deniedStartCount;   // Trim starts refused for lack of tokens
+  unsigned long priorityStartCount; // Safety starts made with the bucket empty
+
+  // Backlash compensation
+  Direction lastDirection;       // Direction of the most recent move (persists while stopped)
+  bool reversalMove;             // Current/last move started opposite to the previous one
+  unsigned long backlashMs;      // Configured take-up time
+  bool backlashLearnEnabled;
+  bool forwardLatencyValid;
+  bool reversalLatencyValid;
+  float forwardLatencyMs;        // Start to sensor response, same direction
+  float reversalLatencyMs;       // Start to sensor response, after a direction change
+  unsigned long reversalCount;   // Starts opposite to the previous direction
+
+  // Position estimate
+  PanelPosition position;
+  bool softLimitsEnabled;
+  uint16_t softLimitMarginDeg;   // Soft limits stop this far short of the end stops
+  bool returningEast;            // Current move is a planned return to the east stop
+  unsigned long returnEastMs;    // Planned run time of that return
+  unsigned long softLimitStopCount; // Moves stopped or refused at a soft limit
+
+  // PWM drive
+  bool pwmEnabled;
+  bool pwmAvailable;
+  bool pwmMove;                  // Current/last move is PWM driven (fixed at the start)
+  uint8_t approachPercent;
+  uint8_t duty;
+  MotorRamp ramp;
+  unsigned long approachCount;   // Moves slowed for the final approach
+
+  // Timer interrupt
+  static const uint8_t MAX_TIMER_MOTORS = 2;   // Azimuth and elevation
+  static MotorControl* timerMotors[MAX_TIMER_MOTORS];
+  static uint8_t timerMotorCount;
+  bool timerAvailable;
+  volatile uint16_t timerTicksRemaining;   // ms until the interrupt cuts the outputs; 0 = not armed
+  volatile bool timerCut;                  // Outputs cut; update() finishes the move
+  volatile unsigned long timerCutTime;
+  unsigned long timedMoveEndMs;  // Run time at which the current move ends; 0 = untimed
+  unsigned long timerStopCount;  // Moves ended by the interrupt
+
+  // Command queue
+  struct QueuedCommand
+  {
+    uint8_t id;
+    Direction direction;         // DIRECTION_NONE = stop
+    StartPriority priority;
+    unsigned long durationMs;    // Move run time or stop hold; 0 = move until the next command
+  };
+  static const uint8_t QUEUE_CAPACITY = MOTOR_QUEUE_CAPACITY;
+  QueuedCommand queue[QUEUE_CAPACITY];
+  uint8_t queueHead;
+  uint8_t queueCount;
+  uint8_t nextCommandId;
+  uint8_t lastCommandId;         // Last command applied
+  uint8_t activeId;              // Command holding the queue; 0 = none
+  bool activeStop;
+  unsigned long activeHoldMs;
+  unsigned long activeStartTime;
+  unsigned long lastStopTime;    // Dead time before a reversal runs from here
+  bool deadlineReached;          // The last move stopped at its deadline
+  CommandDoneCallback commandDoneCallback;
+  void* commandDoneContext;
+  unsigned long queuedCommandCount;
+  unsigned long coalescedCount;  // Commands that repeated the planned motion
+
+  void halt( unsigned long overrunMs, unsigned long stopTime );
+  bool startMove( Direction direction, StartPriority priority, unsigned long durationMs );
+  bool checkStart( Direction direction, StartPriority priority );
+  void finishTimerCut();
+  bool command( Direction direction, unsigned long durationMs, StartPriority priority );
+  uint8_t enqueue( Direction direction, unsigned long durationMs, StartPriority priority );
+  void processQueue();
+  void popCommand();
+  void startActive( uint8_t id, bool stop, unsigned long holdMs, unsigned long currentTime );
+  void finishActive( CommandResult result );
+  void reportCommand( uint8_t id, CommandResult result );
+  void registerTimer();
+  bool armTimer( unsigned long endMs );
+  void disarmTimer();
+  void confirmTimeoutStop( bool west );
+  void timerTick();
+  void refillStartTokens();
+  void beginMove( Direction direction );
+  bool acquireStart( StartPriority priority );
+  unsigned long getPanelRunTime( unsigned long runMs ) const;
+  unsigned long getDriveTime( unsigned long currentTime ) const;
+  void applyDrive( unsigned long currentTime );
+  static bool isPwmPin( uint8_t pin );
+  static void setPwmFrequency( uint8_t pin );
+  bool isAtSoftLimit( bool west, int32_t positionMdeg ) const;
 };
 
 #endif // MOTOR_CONTROL_H
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "MotorRamp.h"
+
+//***********************************************************
+//     Constructor: MotorRamp
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Loads the ramp time and the start and approach duties
+//       from param_config.h.
+//
+//***********************************************************
+MotorRamp::MotorRamp()
+  : rampMs(MOTOR_PWM_RAMP_MS),
+    startDuty(percentToDuty( MOTOR_PWM_START_PERCENT )),
+    approachDuty(percentToDuty( MOTOR_PWM_APPROACH_PERCENT )),
+    startTime(0),
+    approach(false),
+    approachOffset(0)
+{
+}
+
+void MotorRamp::start( unsigned long currentTime )
+{
+  startTime = currentTime;
+  approach = false;
+  approachOffset = 0;
+}
+
+void MotorRamp::setApproach( unsigned long currentTime )
+{
+  if( approach )
+  {
+    return;
+  }
+  // Keep the integral continuous: the full profile up to now, the capped one after
+  unsigned long elapsedMs = currentTime - startTime;
+  approachOffset = getDutyIntegral( elapsedMs, FULL_DUTY ) - getDutyIntegral( elapsedMs, approachDuty );
+  approach = true;
+}
+
+uint8_t MotorRamp::getDuty( unsigned long currentTime ) const
+{
+  uint8_t duty = getRampDuty( currentTime - startTime );
+  return ( approach && duty > approachDuty ) ? approachDuty : duty;
+}
+
+unsigned long MotorRamp::getEquivalentTime( unsigned long currentTime ) const
+{
+  unsigned long elapsedMs = currentTime - startTime;
+  uint32_t dutyMs = approach ? approachOffset + getDutyIntegral( elapsedMs, approachDuty ) :
+                               getDutyIntegral( elapsedMs, FULL_DUTY );
+  return dutyMs / FULL_DUTY;
+}
+
+uint8_t MotorRamp::percentToDuty( uint8_t percent )
+{
+  if( percent >= 100 )
+  {
+    return FULL_DUTY;
+  }
+  return (uint8_t)(( percent * (uint16_t)FULL_DUTY + 50 ) / 100 );
+}
+
+uint8_t MotorRamp::getRampDuty( unsigned long elapsedMs ) const
+{
+  if( elapsedMs >= rampMs || startDuty >= FULL_DUTY )
+  {
+    return FULL_DUTY;
+  }
+  return startDuty + (uint8_t)(( FULL_DUTY - startDuty ) * elapsedMs / rampMs );
+}
+
+//***********************************************************
+//     Function Name: getDutyIntegral
+//
+//     Inputs:
+//     - elapsedMs : Time since the start of the move
+//     - cap : Highest duty allowed
+//
+//     Returns:
+//     - uint32_t : Integral of the capped duty, duty-ms
+//
+//     Description:
+//     - Closed form over the linear ramp, the time it meets
+//       the cap and the flat part after it. The ramp slope is
+//       applied before the second factor of time so the
+//       products stay within 32 bits for moves of minutes.
+//
+//***********************************************************
+uint32_t MotorRamp::getDutyIntegral( unsigned long elapsedMs, uint8_t cap ) const
+{
+  // No ramp below the cap: the duty is the cap throughout
+  if( cap <= startDuty || rampMs == 0 )
+  {
+    return (uint32_t)cap * elapsedMs;
+  }
+
+  // Ramp time until the duty reaches the cap
+  unsigned long capMs = ( cap >= FULL_DUTY ) ? rampMs :
+                        (unsigned long)( cap - startDuty ) * rampMs / ( FULL_DUTY - startDuty );
+  unsigned long rampPartMs = ( elapsedMs < capMs ) ? elapsedMs : capMs;
+  uint32_t rise = (uint32_t)( FULL_DUTY - startDuty ) * rampPartMs / rampMs;
+  uint32_t integral = (uint32_t)startDuty * rampPartMs + rise * rampPartMs / 2;
+  if( elapsedMs > capMs )
+  {
+    integral += (uint32_t)cap * ( elapsedMs - capMs );
+  }
+  return integral;
+}
@@ -0,0 +1,47 @@
+#ifndef MOTOR_RAMP_H
+#define MOTOR_RAMP_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+// Duty profile of one PWM move: a linear ramp from the start duty to full
+// duty, capped at a lower approach duty once the tracker reports the panel
+// is nearly balanced. Panel speed is taken as proportional to duty, so the
+// profile also gives the equivalent full-speed run time the position
+// estimate needs. Pure arithmetic on times; no timer or pin access.
+class MotorRamp {
+public:
+  static const uint8_t FULL_DUTY = 255;
+
+  MotorRamp();
+  void start( unsigned long currentTime );
+  void setApproach( unsigned long currentTime );   // Cap the duty until the next start
+  bool isApproach() const { return approach; }
+
+  uint8_t getDuty( unsigned long currentTime ) const;
+  unsigned long getEquivalentTime( unsigned long currentTime ) const;   // Run time at full duty
+
+  // Configuration
+  void setRampTime( unsigned long rampMs ) { this->rampMs = rampMs; }
+  void setStartDuty( uint8_t duty ) { startDuty = duty; }
+  void setApproachDuty( uint8_t duty ) { approachDuty = duty; }
+  unsigned long getRampTime() const { return rampMs; }
+  uint8_t getStartDuty() const { return startDuty; }
+  uint8_t getApproachDuty() const { return approachDuty; }
+
+  static uint8_t percentToDuty( uint8_t percent );
+
+private:
+  unsigned long rampMs;
+  uint8_t startDuty;
+  uint8_t approachDuty;
+
+  unsigned long startTime;
+  bool approach;
+  uint32_t approachOffset;          // Duty-ms before the cap less the capped profile's share
+
+  uint8_t getRampDuty( unsigned long elapsedMs ) const;
+  uint32_t getDutyIntegral( unsigned long elapsedMs, uint8_t cap ) const;
+};
+
+#endif // MOTOR_RAMP_H
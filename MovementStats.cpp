@@ -0,0 +1,215 @@
+#include "MovementStats.h"
+#include <math.h>
+#include <string.h>
+
+//***********************************************************
+//     Constructor: MovementStats
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Starts with an empty window of the default size and
+//       the default average mode from param_config.h.
+//
+//***********************************************************
+MovementStats::MovementStats()
+  : windowSize(TRACKER_MOVEMENT_HISTORY_SIZE),
+    averageMode(TRACKER_MOVEMENT_AVERAGE_MODE)
+{
+  setWindowSize( windowSize );
+  reset();
+}
+
+void MovementStats::reset()
+{
+  clearWindow();
+  memset( durationCounts, 0, sizeof( durationCounts ));
+  memset( reversalCounts, 0, sizeof( reversalCounts ));
+  moveCount[0] = 0;
+  moveCount[1] = 0;
+}
+
+void MovementStats::clearWindow()
+{
+  index = 0;
+  count = 0;
+  sum = 0;
+  sumSquares = 0;
+}
+
+//***********************************************************
+//     Function Name: record
+//
+//     Inputs:
+//     - durationMs : Duration of the balanced movement
+//     - east : Direction of the final move
+//     - reversals : Reversals made before balance
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Replaces the oldest duration in a full window, updating
+//       the running sums and the sorted copy (at most CAPACITY
+//       steps), and counts the movement in the histograms.
+//
+//***********************************************************
+void MovementStats::record( unsigned long durationMs, bool east, uint8_t reversals )
+{
+  uint32_t value = durationMs;
+  if( count == windowSize )
+  {
+    uint32_t oldest = ring[index];
+    sum -= oldest;
+    sumSquares -= (uint64_t)oldest * oldest;
+    removeSorted( oldest );
+    count--;
+  }
+  ring[index] = value;
+  index = ( index + 1 ) % windowSize;
+  sum += value;
+  sumSquares += (uint64_t)value * value;
+  insertSorted( value );
+  count++;
+
+  uint8_t dir = east ? 0 : 1;
+  uint8_t bucket = 0;
+  while( bucket < DURATION_BUCKETS - 1 && value > getDurationBucketLimitMs( bucket ) )
+  {
+    bucket++;
+  }
+  if( durationCounts[dir][bucket] < UINT16_MAX ) durationCounts[dir][bucket]++;
+  if( reversals >= REVERSAL_BUCKETS )
+  {
+    reversals = REVERSAL_BUCKETS - 1;
+  }
+  if( reversalCounts[dir][reversals] < UINT16_MAX ) reversalCounts[dir][reversals]++;
+  if( moveCount[dir] < UINT16_MAX ) moveCount[dir]++;
+}
+
+void MovementStats::removeSorted( uint32_t value )
+{
+  uint8_t i = 0;
+  while( i < count && sorted[i] != value )
+  {
+    i++;
+  }
+  for( ; i + 1 < count; i++ )
+  {
+    sorted[i] = sorted[i + 1];
+  }
+}
+
+void MovementStats::insertSorted( uint32_t value )
+{
+  uint8_t i = count;
+  while( i > 0 && sorted[i - 1] > value )
+  {
+    sorted[i] = sorted[i - 1];
+    i--;
+  }
+  sorted[i] = value;
+}
+
+void MovementStats::setWindowSize( uint8_t size )
+{
+  if( size < 1 )
+  {
+    size = 1;
+  }
+  if( size > CAPACITY )
+  {
+    size = CAPACITY;
+  }
+  windowSize = size;
+  clearWindow();
+}
+
+void MovementStats::setAverageMode( uint8_t mode )
+{
+  averageMode = ( mode <= AVERAGE_MEDIAN ) ? mode : (uint8_t)AVERAGE_MEAN;
+}
+
+const char* MovementStats::getAverageModeName( uint8_t mode )
+{
+  switch( mode )
+  {
+    case AVERAGE_TRIMMED: return "TRIMMED_MEAN";
+    case AVERAGE_MEDIAN: return "MEDIAN";
+    default: return "MEAN";
+  }
+}
+
+unsigned long MovementStats::getAverage( unsigned long fallbackMs ) const
+{
+  if( count == 0 )
+  {
+    return fallbackMs;
+  }
+  switch( averageMode )
+  {
+    case AVERAGE_TRIMMED: return getTrimmedMean();
+    case AVERAGE_MEDIAN: return getMedian();
+    default: return getMean();
+  }
+}
+
+unsigned long MovementStats::getMean() const
+{
+  return ( count > 0 ) ? sum / count : 0;
+}
+
+unsigned long MovementStats::getTrimmedMean() const
+{
+  // Needs three movements to leave anything after trimming
+  if( count < 3 )
+  {
+    return getMean();
+  }
+  return ( sum - sorted[0] - sorted[count - 1] ) / ( count - 2 );
+}
+
+unsigned long MovementStats::getMedian() const
+{
+  if( count == 0 )
+  {
+    return 0;
+  }
+  uint8_t middle = count / 2;
+  if( count % 2 )
+  {
+    return sorted[middle];
+  }
+  return ( sorted[middle - 1] + sorted[middle] ) / 2;
+}
+
+float MovementStats::getStdDev() const
+{
+  if( count < 2 )
+  {
+    return 0.0f;
+  }
+  // Population variance, n^2 * var = n * sum(x^2) - sum(x)^2, exact in 64 bits
+  uint64_t scaledVariance = count * sumSquares - (uint64_t)sum * sum;
+  return sqrt( (float)scaledVariance ) / count;
+}
+
+unsigned long MovementStats::getDurationBucketLimitMs( uint8_t bucket )
+{
+  // Upper bound of each histogram bucket; the last bucket is open-ended
+  static const unsigned long limitsMs[DURATION_BUCKETS] = {
+    500UL, 1000UL, 2000UL, 5000UL, 10000UL, 20000UL, 60000UL, 0xFFFFFFFFUL
+  };
+  return ( bucket < DURATION_BUCKETS ) ? limitsMs[bucket] : limitsMs[DURATION_BUCKETS - 1];
+}
+
+uint16_t MovementStats::getDurationBucketCount( bool east, uint8_t bucket ) const
+{
+  return ( bucket < DURATION_BUCKETS ) ? durationCounts[east ? 0 : 1][bucket] : 0;
+}
+
+uint16_t MovementStats::getReversalBucketCount( bool east, uint8_t bucket ) const
+{
+  return ( bucket < REVERSAL_BUCKETS ) ? reversalCounts[east ? 0 : 1][bucket] : 0;
+}
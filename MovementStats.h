@@ -0,0 +1,74 @@
+#ifndef MOVEMENT_STATS_H
+#define MOVEMENT_STATS_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+// Durations of successful movements: a fixed-capacity window of the most
+// recent ones with running sum, sum of squares and a sorted copy, so every
+// query is O(1), plus per-direction histograms of durations and reversals
+// since boot.
+class MovementStats {
+public:
+  static const uint8_t CAPACITY = TRACKER_MOVEMENT_HISTORY_CAPACITY;
+  static const uint8_t DURATION_BUCKETS = 8;
+  static const uint8_t REVERSAL_BUCKETS = 4;  // 0, 1, 2, 3 or more reversals
+
+  enum AverageMode
+  {
+    AVERAGE_MEAN,
+    AVERAGE_TRIMMED,    // Mean without the shortest and longest movement
+    AVERAGE_MEDIAN
+  };
+
+  MovementStats();
+  void reset();   // Clear the window and the histograms
+
+  // A balanced movement: total duration, direction of the final move and
+  // the reversals it took
+  void record( unsigned long durationMs, bool east, uint8_t reversals );
+
+  // Configuration
+  void setWindowSize( uint8_t size );   // Clears the window
+  void setAverageMode( uint8_t mode );
+  uint8_t getWindowSize() const { return windowSize; }
+  uint8_t getAverageMode() const { return averageMode; }
+  static const char* getAverageModeName( uint8_t mode );
+
+  // Window statistics; fallbackMs is returned while the window is empty
+  uint8_t getCount() const { return count; }
+  unsigned long getAverage( unsigned long fallbackMs ) const;
+  unsigned long getMean() const;
+  unsigned long getTrimmedMean() const;
+  unsigned long getMedian() const;
+  unsigned long getMin() const { return ( count > 0 ) ? sorted[0] : 0; }
+  unsigned long getMax() const { return ( count > 0 ) ? sorted[count - 1] : 0; }
+  float getStdDev() const;
+
+  // Histograms since boot
+  static unsigned long getDurationBucketLimitMs( uint8_t bucket );
+  uint16_t getDurationBucketCount( bool east, uint8_t bucket ) const;
+  uint16_t getReversalBucketCount( bool east, uint8_t bucket ) const;
+  uint16_t getMoveCount( bool east ) const { return moveCount[east ? 0 : 1]; }
+
+private:
+  uint32_t ring[CAPACITY];          // Window in arrival order
+  uint32_t sorted[CAPACITY];        // Same window, ascending
+  uint8_t windowSize;
+  uint8_t averageMode;
+  uint8_t index;                    // Next ring slot
+  uint8_t count;
+  uint32_t sum;
+  uint64_t sumSquares;              // Exact; durations squared overflow 32 bits
+
+  // Indexed [0] east, [1] west
+  uint16_t durationCounts[2][DURATION_BUCKETS];
+  uint16_t reversalCounts[2][REVERSAL_BUCKETS];
+  uint16_t moveCount[2];
+
+  void clearWindow();
+  void removeSorted( uint32_t value );
+  void insertSorted( uint32_t value );
+};
+
+#endif // MOVEMENT_STATS_H
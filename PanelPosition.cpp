@@ -0,0 +1,249 @@
+#include "PanelPosition.h"
+
+// Distance covered at speedMdegPerS in runMs, without overflowing 32 bits
+static int32_t distanceMdeg( uint16_t speedMdegPerS, unsigned long runMs )
+{
+  return (int32_t)( speedMdegPerS * ( runMs / 1000UL ) +
+                    ( speedMdegPerS * ( runMs % 1000UL )) / 1000UL );
+}
+
+//***********************************************************
+//     Constructor: PanelPosition
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Starts with an unknown position, the default travel and
+//       the default speed in both directions.
+//
+//***********************************************************
+PanelPosition::PanelPosition()
+  : travelMdeg(MOTOR_TRAVEL_DEGREES * 1000L)
+{
+  reset();
+}
+
+void PanelPosition::reset()
+{
+  positionMdeg = 0;
+  speedMdegPerS[0] = (uint16_t)( MOTOR_SPEED_DEG_PER_S * 1000.0f );
+  speedMdegPerS[1] = speedMdegPerS[0];
+  known = false;
+  anchored = false;
+  anchorMdeg = 0;
+  runSinceAnchorMs[0] = 0;
+  runSinceAnchorMs[1] = 0;
+  endStopCount = 0;
+}
+
+//***********************************************************
+//     Function Name: addMove
+//
+//     Inputs:
+//     - west : Direction of the move
+//     - runMs : Time the panel was moving
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Integrates a finished move at the learned speed for its
+//       direction. The estimate never passes the end stops.
+//
+//***********************************************************
+void PanelPosition::addMove( bool west, unsigned long runMs )
+{
+  positionMdeg = getPositionAfter( west, runMs );
+  runSinceAnchorMs[west ? 1 : 0] += runMs;
+}
+
+int32_t PanelPosition::getPositionAfter( bool west, unsigned long runMs ) const
+{
+  int32_t position = positionMdeg + ( west ? 1 : -1 ) * distanceMdeg( speedMdegPerS[west ? 1 : 0], runMs );
+  if( position < 0 )
+  {
+    position = 0;
+  }
+  if( position > travelMdeg )
+  {
+    position = travelMdeg;
+  }
+  return position;
+}
+
+//***********************************************************
+//     Function Name: confirmEndStop
+//
+//     Inputs:
+//     - west : Which end stop was reached
+//     - exactArrival : The last move ended on arrival (stall)
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Re-zeroes the estimate at the end stop. If every move since
+//       the previous end stop was counted, the true displacement is
+//       known and the speed of the arriving direction is learned
+//       from it.
+//
+//***********************************************************
+void PanelPosition::confirmEndStop( bool west, bool exactArrival )
+{
+  int32_t stopMdeg = west ? travelMdeg : 0;
+  if( anchored )
+  {
+    learnSpeed( west, stopMdeg - anchorMdeg, exactArrival );
+  }
+
+  positionMdeg = stopMdeg;
+  anchorMdeg = stopMdeg;
+  runSinceAnchorMs[0] = 0;
+  runSinceAnchorMs[1] = 0;
+  known = true;
+  anchored = true;
+  endStopCount++;
+}
+
+//***********************************************************
+//     Function Name: learnSpeed
+//
+//     Inputs:
+//     - west : Direction that arrived at the end stop
+//     - displacementMdeg : True displacement since the anchor
+//     - exactArrival : Run time ended on arrival
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Solves the displacement for the arriving direction's speed,
+//       taking the other direction's travel at its learned speed.
+//       An exact arrival moves the speed part of the way to the
+//       measurement. Otherwise the run time includes time pushed
+//       against the stop, so the measurement is only a lower bound
+//       and can only raise the speed. Each step is limited to a
+//       factor of two.
+//
+//***********************************************************
+void PanelPosition::learnSpeed( bool west, int32_t displacementMdeg, bool exactArrival )
+{
+  uint8_t dir = west ? 1 : 0;
+  unsigned long runMs = runSinceAnchorMs[dir];
+  int32_t needed = ( west ? displacementMdeg : -displacementMdeg ) +
+                   distanceMdeg( speedMdegPerS[1 - dir], runSinceAnchorMs[1 - dir] );
+  if( runMs < 1000UL || needed <= 0 )
+  {
+    return;  // Too short to measure
+  }
+
+  // needed (mdeg) / runMs (ms) * 1000 = mdeg/s, in two parts to stay in 32 bits
+  uint32_t measured = (uint32_t)needed / runMs * 1000UL +
+                      ( (uint32_t)needed % runMs ) * 1000UL / runMs;
+  uint32_t speed = speedMdegPerS[dir];
+  if( measured > speed * 2UL )
+  {
+    measured = speed * 2UL;
+  }
+  if( measured < speed / 2UL )
+  {
+    measured = speed / 2UL;
+  }
+
+  if( exactArrival )
+  {
+    speed = ( speed * (( 1UL << MOTOR_SPEED_LEARN_SHIFT ) - 1 ) + measured ) >> MOTOR_SPEED_LEARN_SHIFT;
+  }
+  else if( measured > speed )
+  {
+    speed = measured;
+  }
+  speedMdegPerS[dir] = ( speed > 0xFFFFUL ) ? 0xFFFF : (uint16_t)speed;
+}
+
+//***********************************************************
+//     Function Name: getReturnEastTime
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - unsigned long : Planned run time in milliseconds
+//
+//     Description:
+//     - Time to reach the east end stop at the learned east speed
+//       plus a margin to seat against it, limited to the motor
+//       timeout. An unknown position uses the full timeout.
+//
+//***********************************************************
+unsigned long PanelPosition::getReturnEastTime() const
+{
+  unsigned long maxMs = MOTOR_MAX_MOVE_TIME_SECONDS * 1000UL;
+  if( !known || speedMdegPerS[0] == 0 )
+  {
+    return maxMs;
+  }
+  unsigned long runMs = (uint32_t)positionMdeg / speedMdegPerS[0] * 1000UL +
+                        ( (uint32_t)positionMdeg % speedMdegPerS[0] ) * 1000UL / speedMdegPerS[0] +
+                        MOTOR_HOME_MARGIN_MS;
+  return ( runMs < maxMs ) ? runMs : maxMs;
+}
+
+void PanelPosition::setTravel( uint16_t travelDegrees )
+{
+  travelMdeg = travelDegrees * 1000L;
+  if( positionMdeg > travelMdeg )
+  {
+    positionMdeg = travelMdeg;
+  }
+}
+
+//***********************************************************
+//     Function Name: toRecord / fromRecord
+//
+//     Inputs:
+//     - record : RECORD_SIZE bytes
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Packs the position, learned speeds and known flag for
+//       EEPROM. A restored position is known but not anchored:
+//       a move interrupted by the reset was never counted.
+//
+//***********************************************************
+void PanelPosition::toRecord( uint8_t* record ) const
+{
+  uint32_t position = (uint32_t)positionMdeg;
+  for( uint8_t i = 0; i < 4; i++ )
+  {
+    record[i] = (uint8_t)( position >> ( 8 * i ));
+  }
+  record[4] = (uint8_t)speedMdegPerS[0];
+  record[5] = (uint8_t)( speedMdegPerS[0] >> 8 );
+  record[6] = (uint8_t)speedMdegPerS[1];
+  record[7] = (uint8_t)( speedMdegPerS[1] >> 8 );
+  record[8] = known ? 1 : 0;
+}
+
+void PanelPosition::fromRecord( const uint8_t* record )
+{
+  uint32_t position = 0;
+  for( uint8_t i = 0; i < 4; i++ )
+  {
+    position |= (uint32_t)record[i] << ( 8 * i );
+  }
+  uint16_t eastSpeed = record[4] | ( (uint16_t)record[5] << 8 );
+  uint16_t westSpeed = record[6] | ( (uint16_t)record[7] << 8 );
+  if( (int32_t)position < 0 || (int32_t)position > travelMdeg || eastSpeed == 0 || westSpeed == 0 )
+  {
+    return;  // Stored for a different travel; keep the position unknown
+  }
+  positionMdeg = (int32_t)position;
+  speedMdegPerS[0] = eastSpeed;
+  speedMdegPerS[1] = westSpeed;
+  known = ( record[8] != 0 );
+  anchored = false;
+}
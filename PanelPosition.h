@@ -0,0 +1,57 @@
+#ifndef PANEL_POSITION_H
+#define PANEL_POSITION_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+// Dead-reckoning panel angle from motor run time, in millidegrees west of
+// the east end stop. Speeds are learned separately for each direction from
+// the run time between confirmed end stops.
+class PanelPosition {
+public:
+  static const uint8_t RECORD_SIZE = 9;  // Stored position, speeds and flags
+
+  PanelPosition();
+  void reset();   // Position unknown, default speeds
+
+  // A finished move (run time after any backlash take-up)
+  void addMove( bool west, unsigned long runMs );
+
+  // An end stop was reached: re-zero and learn speeds. exactArrival is false
+  // when the run time only bounds the arrival (timeout or planned return)
+  void confirmEndStop( bool west, bool exactArrival );
+
+  // Estimate while a move of runMs is in progress
+  int32_t getPositionAfter( bool west, unsigned long runMs ) const;
+
+  // The estimate has already run into that end stop
+  bool isAtEndStop( bool west ) const { return positionMdeg == ( west ? travelMdeg : 0 ); }
+
+  // Run time that reaches the east end stop from here, including the margin
+  unsigned long getReturnEastTime() const;
+
+  void setTravel( uint16_t travelDegrees );
+  uint16_t getTravel() const { return (uint16_t)( travelMdeg / 1000L ); }
+  bool isKnown() const { return known; }
+  int32_t getPosition() const { return positionMdeg; }
+  uint16_t getSpeed( bool west ) const { return speedMdegPerS[west ? 1 : 0]; }
+  uint16_t getEndStopCount() const { return endStopCount; }
+
+  // Storage
+  void toRecord( uint8_t* record ) const;
+  void fromRecord( const uint8_t* record );
+
+private:
+  int32_t positionMdeg;
+  int32_t travelMdeg;               // East stop to west stop
+  uint16_t speedMdegPerS[2];        // [0] east, [1] west
+  bool known;                       // Position has been referenced to an end stop
+  bool anchored;                    // Moves since the last end stop were all counted
+  int32_t anchorMdeg;               // End stop the run times are counted from
+  unsigned long runSinceAnchorMs[2];
+  uint16_t endStopCount;            // End stops confirmed since boot
+
+  void learnSpeed( bool west, int32_t displacementMdeg, bool exactArrival );
+};
+
+#endif // PANEL_POSITION_H
@@ -26,6 +26,11 @@ PhotoSensor::PhotoSensor(uint8_t pin, uint32_t seriesResistor)
   this->filteredValue = 0.0f;
   this->filterInitialized = false;
 
+  // No sample-ready listener until one is registered
+  this->sampleReadyCallback = nullptr;
+  this->sampleReadyContext = nullptr;
+  this->lastSampleMicros = 0;
+
   // Calculate EMA filter coefficient: alpha = dt / (tau + dt)
   // where dt = sampling period, tau = time constant
   float dt = PHOTOSENSOR_SAMPLING_RATE_MS / 1000.0f;  // Convert to seconds
@@ -98,6 +103,7 @@ void PhotoSensor::update()
     filteredValue = (float)value;
     filterInitialized = true;
     lastUpdate = now;
+    notifySampleReady();
     return;
   }
 
@@ -126,6 +132,7 @@ void PhotoSensor::update()
 
     // Apply EMA filter: filtered = alpha * new + (1-alpha) * filtered_old
     filteredValue = alpha * (float)value + (1.0f - alpha) * filteredValue;
+    notifySampleReady();
   }
 }
 
@@ -167,3 +174,50 @@ float PhotoSensor::getFilteredValue() const
 {
   return filteredValue;
 }
+
+//***********************************************************
+//     Function Name: setSampleReadyCallback
+//
+//     Inputs:
+//     - callback : Function to invoke after each new filtered sample
+//                  (nullptr to disable notification)
+//     - context : Opaque pointer passed back to the callback
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Registers a listener that is called from update() every time
+//       a new reading has been taken and the EMA filter advanced.
+//       Allows consumers to react to fresh data immediately instead
+//       of polling at their own rate.
+//
+//***********************************************************
+void PhotoSensor::setSampleReadyCallback( SampleReadyCallback callback, void* context )
+{
+  sampleReadyCallback = callback;
+  sampleReadyContext = context;
+}
+
+//***********************************************************
+//     Function Name: notifySampleReady
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Timestamps the sample that was just filtered and invokes the
+//       registered sample-ready callback, if any.
+//
+//***********************************************************
+void PhotoSensor::notifySampleReady()
+{
+  lastSampleMicros = micros();
+  if( sampleReadyCallback != nullptr )
+  {
+    sampleReadyCallback( this, sampleReadyContext );
+  }
+}
@@ -4,6 +4,11 @@
 #include <Arduino.h>
 #include <stdint.h>
 
+class PhotoSensor;
+
+// Invoked after every new filtered sample with the sensor that produced it
+typedef void (*SampleReadyCallback)( PhotoSensor* sensor, void* context );
+
 class PhotoSensor {
 private:
   uint8_t pin;
@@ -16,6 +21,13 @@ private:
   float alpha;  // EMA filter coefficient
   bool filterInitialized;
 
+  // Sample-ready notification
+  SampleReadyCallback sampleReadyCallback;
+  void* sampleReadyContext;
+  unsigned long lastSampleMicros;  // micros() timestamp of the most recent sample
+
+  void notifySampleReady();
+
 public:
   // Constructor
   PhotoSensor( uint8_t pin, uint32_t seriesResistor );
@@ -28,6 +40,12 @@ public:
   int32_t getValue() const;
   float getFilteredValue() const;  // Get filtered value
 
+  // Event notification
+  void setSampleReadyCallback( SampleReadyCallback callback, void* context );
+  unsigned long getLastSampleMicros() const {
+    return lastSampleMicros;
+  }
+
   // Getters for external access
   uint8_t getPin() const {
     return pin;
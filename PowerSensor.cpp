@@ -0,0 +1,225 @@
+#include "PowerSensor.h"
+#include <math.h>
+
+//***********************************************************
+//     Constructor: PowerSensor
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Initializes the filtered readings and energy counter.
+//     - Calculates EMA filter coefficient from the configured
+//       time constant and sampling rate.
+//
+//***********************************************************
+PowerSensor::PowerSensor()
+  : lastUpdate(0),
+    voltage(0.0f),
+    current(0.0f),
+    filteredPower(0.0f),
+    filterInitialized(false),
+    energyWh(0.0f)
+{
+  float dt = POWER_SENSOR_SAMPLING_RATE_MS / 1000.0f;
+  float tau = POWER_SENSOR_EMA_TIME_CONSTANT_MS / 1000.0f;
+  alpha = dt / ( tau + dt );
+}
+
+//***********************************************************
+//     Function Name: begin
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Starts the sampling timer.
+//
+//***********************************************************
+void PowerSensor::begin()
+{
+  lastUpdate = millis();
+}
+
+//***********************************************************
+//     Function Name: update
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Reads the source at the configured sampling rate, filters
+//       the power and integrates it into the energy counter.
+//
+//***********************************************************
+void PowerSensor::update()
+{
+  unsigned long currentTime = millis();
+  unsigned long elapsed = currentTime - lastUpdate;
+  if( elapsed < POWER_SENSOR_SAMPLING_RATE_MS )
+  {
+    return;
+  }
+  lastUpdate = currentTime;
+
+  read( &voltage, &current );
+  float power = voltage * current;
+  if( power < 0.0f ) power = 0.0f;
+
+  if( !filterInitialized )
+  {
+    filteredPower = power;
+    filterInitialized = true;
+    return;
+  }
+
+  filteredPower += ( alpha * ( power - filteredPower ));
+  energyWh += ( power * elapsed / 3600000.0f );
+}
+
+//***********************************************************
+//     Constructor: AnalogPowerSensor
+//
+//     Inputs:
+//     - voltagePin : Analog pin of the panel voltage divider
+//     - currentPin : Analog pin of the current sensor output
+//
+//     Description:
+//     - Stores the measurement pins.
+//
+//***********************************************************
+AnalogPowerSensor::AnalogPowerSensor( uint8_t voltagePin, uint8_t currentPin )
+  : voltagePin(voltagePin),
+    currentPin(currentPin)
+{
+}
+
+//***********************************************************
+//     Function Name: begin
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Configures the measurement pins as inputs and starts
+//       sampling.
+//
+//***********************************************************
+void AnalogPowerSensor::begin()
+{
+  pinMode( voltagePin, INPUT );
+  pinMode( currentPin, INPUT );
+  PowerSensor::begin();
+}
+
+//***********************************************************
+//     Function Name: read
+//
+//     Inputs:
+//     - volts : Receives panel voltage
+//     - amps : Receives panel current
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Converts the oversampled ADC readings to panel voltage and
+//       current using the divider ratio and current sensor scale.
+//
+//***********************************************************
+void AnalogPowerSensor::read( float* volts, float* amps )
+{
+  *volts = readPinVolts( voltagePin ) * POWER_VOLTAGE_DIVIDER_RATIO;
+  *amps = ( readPinVolts( currentPin ) - POWER_CURRENT_OFFSET_V ) / POWER_CURRENT_SENSITIVITY_V_PER_A;
+}
+
+//***********************************************************
+//     Function Name: readPinVolts
+//
+//     Inputs:
+//     - pin : Analog pin to read
+//
+//     Returns:
+//     - float : Averaged pin voltage
+//
+//     Description:
+//     - Averages POWER_SENSOR_OVERSAMPLE conversions of one pin.
+//
+//***********************************************************
+float AnalogPowerSensor::readPinVolts( uint8_t pin )
+{
+  uint16_t sum = 0;
+  for( uint8_t i = 0; i < POWER_SENSOR_OVERSAMPLE; i++ )
+  {
+    sum += analogRead( pin );
+  }
+  return ( sum * POWER_ADC_REFERENCE_V ) / ( 1023.0f * POWER_SENSOR_OVERSAMPLE );
+}
+
+//***********************************************************
+//     Constructor: SimulatedPowerSensor
+//
+//     Inputs:
+//     - eastSensor : Pointer to east photosensor
+//     - westSensor : Pointer to west photosensor
+//
+//     Description:
+//     - Stores the photosensors the model is driven from.
+//
+//***********************************************************
+SimulatedPowerSensor::SimulatedPowerSensor( PhotoSensor* eastSensor, PhotoSensor* westSensor )
+  : eastSensor(eastSensor),
+    westSensor(westSensor)
+{
+}
+
+//***********************************************************
+//     Function Name: read
+//
+//     Inputs:
+//     - volts : Receives simulated panel voltage
+//     - amps : Receives simulated panel current
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Models panel output as full power scaled by the light level
+//       and the cosine of the pointing error. The error is the sensor
+//       imbalance minus a fixed mismatch, so peak power sits slightly
+//       off sensor balance the way a soiled or mismatched pair would.
+//
+//***********************************************************
+void SimulatedPowerSensor::read( float* volts, float* amps )
+{
+  float eastValue = eastSensor->getFilteredValue();
+  float westValue = westSensor->getFilteredValue();
+  float lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  float averageValue = ( eastValue + westValue ) / 2.0f;
+
+  *volts = POWER_SIM_VOLTAGE;
+  if( lowerValue <= 0.0f )
+  {
+    *amps = 0.0f;
+    return;
+  }
+
+  float lightFraction = TRACKER_FULL_SUN_OHMS / averageValue;
+  if( lightFraction > 1.0f ) lightFraction = 1.0f;
+
+  float imbalancePercent = (( eastValue - westValue ) / lowerValue ) * 100.0f;
+  float errorDegrees = ( imbalancePercent - POWER_SIM_SENSOR_OFFSET_PERCENT ) * TRACKER_DEGREES_PER_PERCENT;
+  float pointing = cos( errorDegrees * PI / 180.0f );
+  if( pointing < 0.0f ) pointing = 0.0f;
+
+  *amps = ( TRACKER_PANEL_POWER_W * lightFraction * pointing ) / POWER_SIM_VOLTAGE;
+}
@@ -0,0 +1,63 @@
+#ifndef POWER_SENSOR_H
+#define POWER_SENSOR_H
+
+#include <Arduino.h>
+#include "param_config.h"
+#include "Photosensor.h"
+
+// Filtered panel voltage, current and power with energy accumulation.
+// Concrete sources only provide the raw voltage/current reading.
+class PowerSensor {
+public:
+  PowerSensor();
+  virtual void begin();
+  void update();
+
+  float getVoltage() const { return voltage; }
+  float getCurrent() const { return current; }
+  float getPower() const { return filteredPower; }
+  float getEnergyWh() const { return energyWh; }
+
+protected:
+  virtual void read( float* volts, float* amps ) = 0;
+
+private:
+  unsigned long lastUpdate;
+  float voltage;
+  float current;
+  float filteredPower;
+  float alpha;                      // EMA filter coefficient
+  bool filterInitialized;
+  float energyWh;                   // Energy integrated since startup
+};
+
+// Panel voltage through a resistor divider and current from a Hall sensor
+class AnalogPowerSensor : public PowerSensor {
+public:
+  AnalogPowerSensor( uint8_t voltagePin, uint8_t currentPin );
+  void begin();
+
+protected:
+  void read( float* volts, float* amps );
+
+private:
+  uint8_t voltagePin;
+  uint8_t currentPin;
+
+  float readPinVolts( uint8_t pin );
+};
+
+// Panel power modelled from the photosensors for bench testing and simulation
+class SimulatedPowerSensor : public PowerSensor {
+public:
+  SimulatedPowerSensor( PhotoSensor* eastSensor, PhotoSensor* westSensor );
+
+protected:
+  void read( float* volts, float* amps );
+
+private:
+  PhotoSensor* eastSensor;
+  PhotoSensor* westSensor;
+};
+
+#endif // POWER_SENSOR_H
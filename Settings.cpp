@@ -11,12 +11,15 @@ static const char MEASUREMENTS_TITLE[] PROGMEM = "MEASUREMENTS";
 static const char HELP_TITLE[] PROGMEM = "HELP";
 static const char STATUS_TITLE[] PROGMEM = "STATUS";
 static const char FACTORY_RESET_TITLE[] PROGMEM = "FACTORY RESET";
+static const char TRACE_TITLE[] PROGMEM = "STATE TRACE";
+static const char ROWS_TITLE[] PROGMEM = "TRACKER ROWS";
+static const char MOVES_TITLE[] PROGMEM = "MOVEMENT STATISTICS";
 
 // Parameter descriptions stored in program memory
 static const char DESC_BALANCE_TOL[] PROGMEM = "Tolerance percentage for sensor balance detection";
 static const char DESC_MAX_MOVE_TIME[] PROGMEM = "Maximum time allowed for a single movement";
 static const char DESC_ADJUSTMENT_PERIOD[] PROGMEM = "Time between automatic adjustment attempts";
-static const char DESC_SAMPLING_RATE[] PROGMEM = "Rate at which sensors are sampled during adjustment";
+static const char DESC_SAMPLING_RATE[] PROGMEM = "Rate of direction updates during adjustment";
 static const char DESC_BRIGHTNESS_THRESHOLD[] PROGMEM = "Brightness level below which tracking is disabled";
 static const char DESC_BRIGHTNESS_FILTER_TAU[] PROGMEM = "Time constant for brightness EMA filter";
 static const char DESC_NIGHT_THRESHOLD[] PROGMEM = "Brightness level that triggers night mode";
@@ -38,6 +41,47 @@ static const char DESC_TERMINAL_PRINT_PERIOD[] PROGMEM = "Period between termina
 static const char DESC_TERMINAL_MOVING_PERIOD[] PROGMEM = "Period between terminal updates during movement";
 static const char DESC_TERMINAL_PERIODIC_LOGS[] PROGMEM = "Enable periodic logging to terminal";
 static const char DESC_TERMINAL_LOG_ONLY_MOVING[] PROGMEM = "Only log sensor data while motor is moving";
+static const char DESC_ADAPTIVE_SCHEDULE[] PROGMEM = "Schedule adjustments from the estimated drift rate";
+static const char DESC_ADJ_PERIOD_MIN[] PROGMEM = "Shortest adaptively scheduled adjustment period";
+static const char DESC_ADJ_PERIOD_MAX[] PROGMEM = "Longest adaptively scheduled adjustment period";
+static const char DESC_CLOUD_DETECT[] PROGMEM = "Hold off adjustments while light is unstable";
+static const char DESC_CLOUD_THRESHOLD[] PROGMEM = "Light variation/rate limit for stable conditions";
+static const char DESC_CLOUD_HOLDOFF[] PROGMEM = "Stable time required before adjusting";
+static const char DESC_ENERGY_AWARE[] PROGMEM = "Skip moves whose yield gain is below motor energy";
+static const char DESC_PANEL_POWER[] PROGMEM = "Panel output at full sun";
+static const char DESC_MOTOR_POWER[] PROGMEM = "Power drawn by the motor while running";
+static const char DESC_DEG_PER_PCT[] PROGMEM = "Panel angle error per percent of sensor imbalance";
+static const char DESC_KALMAN_FILTER[] PROGMEM = "Use Kalman sun-angle estimate for adjust/stop decisions";
+static const char DESC_SUN_SEARCH[] PROGMEM = "Search for brightest orientation after night";
+static const char DESC_SUN_SEARCH_STEPS[] PROGMEM = "Maximum brightness probes per sun search";
+static const char DESC_SUN_SEARCH_TIMEOUT[] PROGMEM = "Abandon sun search after this long";
+static const char DESC_SUN_SEARCH_SPAN[] PROGMEM = "Motor travel west of full east to search";
+static const char DESC_TRACKING_STRATEGY[] PROGMEM = "0=sensor balance, 1=panel power hill climb, 2=model-predictive plan";
+static const char DESC_HC_STEP[] PROGMEM = "Motor time per hill climb perturbation";
+static const char DESC_HC_MAX_STEPS[] PROGMEM = "Maximum perturbations per hill climb";
+static const char DESC_HC_DEADBAND[] PROGMEM = "Power gain required to keep a perturbation";
+static const char DESC_START_LIMIT[] PROGMEM = "Rate-limit tracking motor starts";
+static const char DESC_START_BURST[] PROGMEM = "Motor starts available back to back";
+static const char DESC_START_RATE[] PROGMEM = "Sustained motor starts per hour";
+static const char DESC_AUTO_TUNE[] PROGMEM = "Retune tolerance, thresholds and filters nightly";
+static const char DESC_BACKLASH[] PROGMEM = "Gear backlash take-up time on reversals";
+static const char DESC_BACKLASH_LEARN[] PROGMEM = "Estimate backlash from sensor response latency";
+static const char DESC_SHADING_MAP[] PROGMEM = "Defer adjustments during learned one-sided shading (0=off, 1=on)";
+static const char DESC_ELEV_TOL[] PROGMEM = "Up/down sensor balance tolerance";
+static const char DESC_ELEV_PERIOD[] PROGMEM = "Time between elevation adjustments";
+static const char DESC_ELEV_MAX_MOVE[] PROGMEM = "Maximum time for one elevation movement";
+static const char DESC_MAX_MOTORS[] PROGMEM = "Motors the supply can run at once (1=axes take turns)";
+static const char DESC_TRAVEL[] PROGMEM = "Panel rotation between the east and west end stops";
+static const char DESC_SOFT_LIMITS[] PROGMEM = "Stop tracking moves short of the end stops (position estimate)";
+static const char DESC_SOFT_MARGIN[] PROGMEM = "Distance the soft limits keep from the end stops";
+static const char DESC_STALL_DETECT[] PROGMEM = "Stop the motor when the sensors stop following it (0=off, 1=on)";
+static const char DESC_MOVEMENT_AVERAGE[] PROGMEM = "History average (0=mean, 1=trimmed mean, 2=median)";
+static const char DESC_BACKTRACKING[] PROGMEM = "Tilt back from the sun near sunrise and sunset so rows do not shade each other (0=off, 1=on)";
+static const char DESC_ROW_PITCH[] PROGMEM = "Distance between the rotation axes of neighbouring rows";
+static const char DESC_PANEL_WIDTH[] PROGMEM = "Panel width across the rotation axis";
+static const char DESC_MOTOR_PWM[] PROGMEM = "Drive the motor with PWM: soft-start ramp and slow final approach";
+static const char DESC_RAMP_TIME[] PROGMEM = "Time for the PWM duty to ramp up to full at each start";
+static const char DESC_APPROACH_SPEED[] PROGMEM = "PWM duty once nearly balanced (stall windows allow down to 1/3 speed)";
 
 // Section headers stored in program memory
 static const char SECTION_SENSOR[] PROGMEM = "SENSOR PARAMETERS:";
@@ -53,6 +97,119 @@ static const char SECTION_SYSTEM[] PROGMEM = "SYSTEM STATE:";
 static const char SECTION_TIMING[] PROGMEM = "TIMING INFORMATION:";
 static const char SECTION_DEFAULT_WEST[] PROGMEM = "DEFAULT WEST MOVEMENT:";
 
+// Parameter metadata and defaults stored in program memory; parameters[]
+// holds the value for the entry at the same index
+static const ParameterMetadata PARAMETER_TABLE[] PROGMEM = {
+  // Tracker parameters
+  { "balance_tol", "tol", "%", 0.0f, 100.0f, TRACKER_TOLERANCE_PERCENT, false, false, true, false },
+  { "max_move_time", "mmt", "s", 1.0f, 3600.0f, TRACKER_MAX_MOVEMENT_TIME_SECONDS, true, true, false, false },
+  { "adjustment_period", "adjp", "s", 1.0f, 3600.0f, TRACKER_ADJUSTMENT_PERIOD_SECONDS, true, true, false, false },
+  { "sampling_rate", "samp", "ms", 10.0f, 10000.0f, TRACKER_SAMPLING_RATE_MS, true, false, false, false },
+  { "brightness_threshold", "bth", "ohms", 0.0f, SENSOR_MAX_RESISTANCE_OHMS, TRACKER_BRIGHTNESS_THRESHOLD_OHMS, true, false, false, true },
+  { "brightness_filter_tau", "bft", "s", 0.1f, 300.0f, TRACKER_BRIGHTNESS_FILTER_TIME_CONSTANT_S, false, false, false, false },
+  { "night_threshold", "nth", "ohms", 0.0f, SENSOR_MAX_RESISTANCE_OHMS, TRACKER_NIGHT_THRESHOLD_OHMS, true, false, false, true },
+  { "night_hysteresis", "nhys", "%", 0.0f, 100.0f, TRACKER_NIGHT_HYSTERESIS_PERCENT, false, false, true, false },
+  { "night_detection_time", "ndt", "s", 1.0f, 3600.0f, TRACKER_NIGHT_DETECTION_TIME_SECONDS, true, true, false, false },
+  { "reversal_dead_time", "rdt", "ms", 0.0f, 60000.0f, 1000.0f, true, false, false, false },
+  { "reversal_time_limit", "rtl", "ms", 100.0f, 60000.0f, TRACKER_REVERSAL_TIME_LIMIT_MS, true, false, false, false },
+  { "max_reversal_tries", "mrt", "", 1.0f, 10.0f, 3.0f, true, false, false, false },
+  { "default_west_enabled", "dwe", "", 0.0f, 1.0f, TRACKER_ENABLE_DEFAULT_WEST_MOVEMENT ? 1.0f : 0.0f, true, false, false, false },
+  { "default_west_time", "dwt", "ms", 100.0f, 60000.0f, TRACKER_DEFAULT_WEST_MOVEMENT_MS, true, false, false, false },
+  { "use_average_movement", "uam", "", 0.0f, 1.0f, TRACKER_USE_AVERAGE_MOVEMENT_TIME ? 1.0f : 0.0f, true, false, false, false },
+  { "movement_history_size", "mhs", "", 1.0f, 10.0f, TRACKER_MOVEMENT_HISTORY_SIZE, true, false, false, false },
+  
+  // Monitor mode parameters
+  { "monitor_mode", "mon", "", 0.0f, 1.0f, TRACKER_MONITOR_MODE_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "start_move_thresh", "smt", "%", 0.0f, 100.0f, TRACKER_START_MOVE_THRESHOLD_PERCENT, false, false, true, false },
+  { "min_wait", "mwt", "s", 1.0f, 3600.0f, TRACKER_MIN_WAIT_TIME_SECONDS, true, true, false, false },
+  { "monitor_filt_tau", "mft", "s", 0.1f, 300.0f, TRACKER_MONITOR_FILTER_TIME_CONSTANT_S, false, false, false, false },
+  
+  // Motor parameters
+  { "motor_dead_time", "mdt", "ms", 0.0f, 10000.0f, MOTOR_DEAD_TIME_MS, true, false, false, false },
+  
+  // Terminal parameters
+  { "terminal_print_period", "tpp", "ms", 100.0f, 60000.0f, TERMINAL_PRINT_PERIOD_MS, true, false, false, false },
+  { "terminal_moving_period", "tmp", "ms", 50.0f, 60000.0f, TERMINAL_MOVING_PRINT_PERIOD_MS, true, false, false, false },
+  { "terminal_periodic_logs", "tpl", "", 0.0f, 1.0f, TERMINAL_ENABLE_PERIODIC_LOGS ? 1.0f : 0.0f, true, false, false, false },
+  { "terminal_log_only_moving", "tlm", "", 0.0f, 1.0f, TERMINAL_LOG_ONLY_WHILE_MOVING ? 1.0f : 0.0f, true, false, false, false },
+  
+  // Adaptive scheduling parameters
+  { "adaptive_schedule", "ads", "", 0.0f, 1.0f, TRACKER_ADAPTIVE_SCHEDULE_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "adj_period_min", "apmn", "s", 1.0f, 3600.0f, TRACKER_ADJUSTMENT_PERIOD_MIN_SECONDS, true, true, false, false },
+  { "adj_period_max", "apmx", "s", 1.0f, 3600.0f, TRACKER_ADJUSTMENT_PERIOD_MAX_SECONDS, true, true, false, false },
+  
+  // Cloud detection parameters
+  { "cloud_detect", "cld", "", 0.0f, 1.0f, TRACKER_CLOUD_DETECT_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "cloud_threshold", "cdt", "%", 0.1f, 100.0f, TRACKER_CLOUD_THRESHOLD_PERCENT, false, false, true, false },
+  { "cloud_holdoff", "cdh", "s", 0.0f, 3600.0f, TRACKER_CLOUD_HOLDOFF_SECONDS, true, true, false, false },
+  
+  // Energy-aware tracking parameters
+  { "energy_aware", "eaw", "", 0.0f, 1.0f, TRACKER_ENERGY_AWARE_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "panel_power", "ppw", "W", 1.0f, 10000.0f, TRACKER_PANEL_POWER_W, false, false, false, false },
+  { "motor_power", "mpw", "W", 0.1f, 1000.0f, TRACKER_MOTOR_POWER_W, false, false, false, false },
+  { "deg_per_pct", "dpp", "deg", 0.01f, 10.0f, TRACKER_DEGREES_PER_PERCENT, false, false, false, false },
+  
+  // Kalman estimator parameters
+  { "kalman_filter", "kfe", "", 0.0f, 1.0f, TRACKER_KALMAN_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  
+  // Sun search parameters
+  { "sun_search", "ssr", "", 0.0f, 1.0f, TRACKER_SUN_SEARCH_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "sun_search_steps", "sss", "", 2.0f, 20.0f, TRACKER_SUN_SEARCH_STEPS, true, false, false, false },
+  { "sun_search_timeout", "sst", "s", 10.0f, 600.0f, TRACKER_SUN_SEARCH_TIMEOUT_SECONDS, true, true, false, false },
+  { "sun_search_span", "ssp", "s", 1.0f, 120.0f, TRACKER_SUN_SEARCH_SPAN_SECONDS, true, true, false, false },
+  
+  // Tracking strategy parameters
+  { "tracking_strategy", "tst", "", 0.0f, 2.0f, TRACKER_STRATEGY, true, false, false, false },
+  { "hc_step", "hcs", "ms", 50.0f, 5000.0f, TRACKER_HILL_CLIMB_STEP_MS, true, false, false, false },
+  { "hc_max_steps", "hcm", "", 1.0f, 20.0f, TRACKER_HILL_CLIMB_MAX_STEPS, true, false, false, false },
+  { "hc_deadband", "hcd", "%", 0.0f, 20.0f, TRACKER_HILL_CLIMB_DEADBAND_PERCENT, false, false, true, false },
+  
+  // Motor start limiter parameters
+  { "start_limit", "msl", "", 0.0f, 1.0f, MOTOR_START_LIMIT_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "start_burst", "msb", "", 1.0f, 100.0f, MOTOR_START_BURST, true, false, false, false },
+  { "start_rate", "msr", "/h", 1.0f, 3600.0f, MOTOR_START_REFILL_PER_HOUR, true, false, false, false },
+  
+  // Auto-tuning parameters
+  { "auto_tune", "atn", "", 0.0f, 1.0f, AUTOTUNE_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  
+  // Backlash compensation parameters
+  { "backlash", "mbl", "ms", 0.0f, 5000.0f, MOTOR_BACKLASH_MS, true, false, false, false },
+  { "backlash_learn", "mbk", "", 0.0f, 1.0f, MOTOR_BACKLASH_LEARN_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  
+  // Shading map parameters
+  { "shading_map", "shm", "", 0.0f, 1.0f, SHADING_MAP_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  
+  // Dual-axis parameters
+  { "elev_tol", "etol", "%", 0.0f, 100.0f, TRACKER_ELEVATION_TOLERANCE_PERCENT, false, false, true, false },
+  { "elev_period", "eadp", "s", 1.0f, 3600.0f, TRACKER_ELEVATION_ADJUSTMENT_PERIOD_SECONDS, true, true, false, false },
+  { "elev_max_move", "emmt", "s", 1.0f, 3600.0f, TRACKER_ELEVATION_MAX_MOVEMENT_TIME_SECONDS, true, true, false, false },
+  { "max_motors", "mxm", "", 1.0f, 2.0f, TRACKER_MAX_MOTORS_RUNNING, true, false, false, false },
+  
+  // Position estimate parameters
+  { "travel", "trv", "deg", 10.0f, 360.0f, MOTOR_TRAVEL_DEGREES, true, false, false, false },
+  { "soft_limits", "sle", "", 0.0f, 1.0f, MOTOR_SOFT_LIMITS_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "soft_margin", "slm", "deg", 0.0f, 45.0f, MOTOR_SOFT_LIMIT_MARGIN_DEGREES, true, false, false, false },
+  
+  // Motor stall detection settings
+  { "stall_detect", "std", "", 0.0f, 1.0f, TRACKER_STALL_DETECT_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  
+  // Movement statistics settings
+  { "movement_average", "mav", "", 0.0f, 2.0f, (float)TRACKER_MOVEMENT_AVERAGE_MODE, true, false, false, false },
+  
+  // Backtracking parameters
+  { "backtracking", "btk", "", 0.0f, 1.0f, TRACKER_BACKTRACK_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "row_pitch", "rpt", "mm", 100.0f, 60000.0f, (float)TRACKER_ROW_PITCH_MM, true, false, false, false },
+  { "panel_width", "pwd", "mm", 100.0f, 60000.0f, (float)TRACKER_PANEL_WIDTH_MM, true, false, false, false },
+  
+  // PWM drive parameters
+  { "motor_pwm", "pwm", "", 0.0f, 1.0f, MOTOR_PWM_ENABLED ? 1.0f : 0.0f, true, false, false, false },
+  { "ramp_time", "prt", "ms", 0.0f, 10000.0f, (float)MOTOR_PWM_RAMP_MS, true, false, false, false },
+  { "approach_speed", "pas", "%", 35.0f, 100.0f, (float)MOTOR_PWM_APPROACH_PERCENT, true, false, true, false }
+};
+
+static const int PARAMETER_COUNT = sizeof( PARAMETER_TABLE ) / sizeof( PARAMETER_TABLE[0] );
+static_assert( PARAMETER_COUNT == Settings::MAX_PARAMETERS, "Settings::MAX_PARAMETERS must match PARAMETER_TABLE" );
+
 Settings::Settings()
   : tracker( nullptr ),
     motorControl( nullptr ),
@@ -76,49 +233,8 @@ void Settings::begin( Tracker* tracker, MotorControl* motorControl, PhotoSensor*
   // Default to saving to EEPROM
   saveToEeprom = true;
   
-  // Initialize parameter metadata
-  parameterCount = 0;
-  const ParameterMetadata metadata[] = {
-    // Tracker parameters
-    { "balance_tol", "tol", "%", 0.0f, 100.0f, false, false, true, false },
-    { "max_move_time", "mmt", "s", 1.0f, 3600.0f, true, true, false, false },
-    { "adjustment_period", "adjp", "s", 1.0f, 3600.0f, true, true, false, false },
-    { "sampling_rate", "samp", "ms", 10.0f, 10000.0f, true, false, false, false },
-    { "brightness_threshold", "bth", "ohms", 0.0f, SENSOR_MAX_RESISTANCE_OHMS, true, false, false, true },
-    { "brightness_filter_tau", "bft", "s", 0.1f, 300.0f, false, false, false, false },
-    { "night_threshold", "nth", "ohms", 0.0f, SENSOR_MAX_RESISTANCE_OHMS, true, false, false, true },
-    { "night_hysteresis", "nhys", "%", 0.0f, 100.0f, false, false, true, false },
-    { "night_detection_time", "ndt", "s", 1.0f, 3600.0f, true, true, false, false },
-    { "reversal_dead_time", "rdt", "ms", 0.0f, 60000.0f, true, false, false, false },
-    { "reversal_time_limit", "rtl", "ms", 100.0f, 60000.0f, true, false, false, false },
-    { "max_reversal_tries", "mrt", "", 1.0f, 10.0f, true, false, false, false },
-    { "default_west_enabled", "dwe", "", 0.0f, 1.0f, true, false, false, false },
-    { "default_west_time", "dwt", "ms", 100.0f, 60000.0f, true, false, false, false },
-    { "use_average_movement", "uam", "", 0.0f, 1.0f, true, false, false, false },
-    { "movement_history_size", "mhs", "", 1.0f, 10.0f, true, false, false, false },
-    
-    // Monitor mode parameters
-    { "monitor_mode", "mon", "", 0.0f, 1.0f, true, false, false, false },
-    { "start_move_thresh", "smt", "%", 0.0f, 100.0f, false, false, true, false },
-    { "min_wait", "mwt", "s", 1.0f, 3600.0f, true, true, false, false },
-    { "monitor_filt_tau", "mft", "s", 0.1f, 300.0f, false, false, false, false },
-    
-    // Motor parameters
-    { "motor_dead_time", "mdt", "ms", 0.0f, 10000.0f, true, false, false, false },
-    
-    // Terminal parameters
-    { "terminal_print_period", "tpp", "ms", 100.0f, 60000.0f, true, false, false, false },
-    { "terminal_moving_period", "tmp", "ms", 50.0f, 60000.0f, true, false, false, false },
-    { "terminal_periodic_logs", "tpl", "", 0.0f, 1.0f, true, false, false, false },
-    { "terminal_log_only_moving", "tlm", "", 0.0f, 1.0f, true, false, false, false }
-  };
-  
-  // Initialize parameter metadata
-  for( size_t i = 0; i < sizeof(metadata) / sizeof(metadata[0]); i++ )
-  {
-    parameters[parameterCount].meta = metadata[i];
-    parameterCount++;
-  }
+  // Metadata is read from PARAMETER_TABLE, only the values are kept here
+  parameterCount = PARAMETER_COUNT;
   
   // If EEPROM is valid, load values from it
   if( eeprom.isValid() )
@@ -137,102 +253,12 @@ void Settings::begin( Tracker* tracker, MotorControl* motorControl, PhotoSensor*
 
 void Settings::initializeParameters()
 {
-  parameterCount = 0;
-  
-  // Define parameter metadata
-  const ParameterMetadata metadata[] = {
-    // Tracker parameters
-    { "balance_tol", "tol", "%", 0.0f, 100.0f, false, false, true, false },
-    { "max_move_time", "mmt", "s", 1.0f, 3600.0f, true, true, false, false },
-    { "adjustment_period", "adjp", "s", 1.0f, 3600.0f, true, true, false, false },
-    { "sampling_rate", "samp", "ms", 10.0f, 10000.0f, true, false, false, false },
-    { "brightness_threshold", "bth", "ohms", 0.0f, SENSOR_MAX_RESISTANCE_OHMS, true, false, false, true },
-    { "brightness_filter_tau", "bft", "s", 0.1f, 300.0f, false, false, false, false },
-    { "night_threshold", "nth", "ohms", 0.0f, SENSOR_MAX_RESISTANCE_OHMS, true, false, false, true },
-    { "night_hysteresis", "nhys", "%", 0.0f, 100.0f, false, false, true, false },
-    { "night_detection_time", "ndt", "s", 1.0f, 3600.0f, true, true, false, false },
-    { "reversal_dead_time", "rdt", "ms", 0.0f, 60000.0f, true, false, false, false },
-    { "reversal_time_limit", "rtl", "ms", 100.0f, 60000.0f, true, false, false, false },
-    { "max_reversal_tries", "mrt", "", 1.0f, 10.0f, true, false, false, false },
-    { "default_west_enabled", "dwe", "", 0.0f, 1.0f, true, false, false, false },
-    { "default_west_time", "dwt", "ms", 100.0f, 60000.0f, true, false, false, false },
-    { "use_average_movement", "uam", "", 0.0f, 1.0f, true, false, false, false },
-    { "movement_history_size", "mhs", "", 1.0f, 10.0f, true, false, false, false },
-    
-    // Monitor mode parameters
-    { "monitor_mode", "mon", "", 0.0f, 1.0f, true, false, false, false },
-    { "start_move_thresh", "smt", "%", 0.0f, 100.0f, false, false, true, false },
-    { "min_wait", "mwt", "s", 1.0f, 3600.0f, true, true, false, false },
-    { "monitor_filt_tau", "mft", "s", 0.1f, 300.0f, false, false, false, false },
-    
-    // Motor parameters
-    { "motor_dead_time", "mdt", "ms", 0.0f, 10000.0f, true, false, false, false },
-    
-    // Terminal parameters
-    { "terminal_print_period", "tpp", "ms", 100.0f, 60000.0f, true, false, false, false },
-    { "terminal_moving_period", "tmp", "ms", 50.0f, 60000.0f, true, false, false, false },
-    { "terminal_periodic_logs", "tpl", "", 0.0f, 1.0f, true, false, false, false },
-    { "terminal_log_only_moving", "tlm", "", 0.0f, 1.0f, true, false, false, false }
-  };
+  parameterCount = PARAMETER_COUNT;
   
-  // Initialize parameters with metadata and default values
-  for( size_t i = 0; i < sizeof(metadata) / sizeof(metadata[0]); i++ )
+  // Default values from param_config.h
+  for( int i = 0; i < parameterCount; i++ )
   {
-    parameters[parameterCount].meta = metadata[i];
-    
-    // Set default value from param_config.h
-    if( isParameterName( metadata[i].name, "balance_tol" ) )
-      parameters[parameterCount].currentValue = TRACKER_TOLERANCE_PERCENT;
-    else if( isParameterName( metadata[i].name, "max_move_time" ) )
-      parameters[parameterCount].currentValue = TRACKER_MAX_MOVEMENT_TIME_SECONDS;
-    else if( isParameterName( metadata[i].name, "adjustment_period" ) )
-      parameters[parameterCount].currentValue = TRACKER_ADJUSTMENT_PERIOD_SECONDS;
-    else if( isParameterName( metadata[i].name, "sampling_rate" ) )
-      parameters[parameterCount].currentValue = TRACKER_SAMPLING_RATE_MS;
-    else if( isParameterName( metadata[i].name, "brightness_threshold" ) )
-      parameters[parameterCount].currentValue = TRACKER_BRIGHTNESS_THRESHOLD_OHMS;
-    else if( isParameterName( metadata[i].name, "brightness_filter_tau" ) )
-      parameters[parameterCount].currentValue = TRACKER_BRIGHTNESS_FILTER_TIME_CONSTANT_S;
-    else if( isParameterName( metadata[i].name, "night_threshold" ) )
-      parameters[parameterCount].currentValue = TRACKER_NIGHT_THRESHOLD_OHMS;
-    else if( isParameterName( metadata[i].name, "night_hysteresis" ) )
-      parameters[parameterCount].currentValue = TRACKER_NIGHT_HYSTERESIS_PERCENT;
-    else if( isParameterName( metadata[i].name, "night_detection_time" ) )
-      parameters[parameterCount].currentValue = TRACKER_NIGHT_DETECTION_TIME_SECONDS;
-    else if( isParameterName( metadata[i].name, "reversal_dead_time" ) )
-      parameters[parameterCount].currentValue = 1000.0f; // Default value
-    else if( isParameterName( metadata[i].name, "reversal_time_limit" ) )
-      parameters[parameterCount].currentValue = TRACKER_REVERSAL_TIME_LIMIT_MS;
-    else if( isParameterName( metadata[i].name, "max_reversal_tries" ) )
-      parameters[parameterCount].currentValue = 3.0f; // Default value
-    else if( isParameterName( metadata[i].name, "default_west_enabled" ) )
-      parameters[parameterCount].currentValue = TRACKER_ENABLE_DEFAULT_WEST_MOVEMENT ? 1.0f : 0.0f;
-    else if( isParameterName( metadata[i].name, "default_west_time" ) )
-      parameters[parameterCount].currentValue = TRACKER_DEFAULT_WEST_MOVEMENT_MS;
-    else if( isParameterName( metadata[i].name, "use_average_movement" ) )
-      parameters[parameterCount].currentValue = TRACKER_USE_AVERAGE_MOVEMENT_TIME ? 1.0f : 0.0f;
-    else if( isParameterName( metadata[i].name, "movement_history_size" ) )
-      parameters[parameterCount].currentValue = TRACKER_MOVEMENT_HISTORY_SIZE;
-    else if( isParameterName( metadata[i].name, "monitor_mode" ) )
-      parameters[parameterCount].currentValue = TRACKER_MONITOR_MODE_ENABLED ? 1.0f : 0.0f;
-    else if( isParameterName( metadata[i].name, "start_move_thresh" ) )
-      parameters[parameterCount].currentValue = TRACKER_START_MOVE_THRESHOLD_PERCENT;
-    else if( isParameterName( metadata[i].name, "min_wait" ) )
-      parameters[parameterCount].currentValue = TRACKER_MIN_WAIT_TIME_SECONDS;
-    else if( isParameterName( metadata[i].name, "monitor_filt_tau" ) )
-      parameters[parameterCount].currentValue = TRACKER_MONITOR_FILTER_TIME_CONSTANT_S;
-    else if( isParameterName( metadata[i].name, "motor_dead_time" ) )
-      parameters[parameterCount].currentValue = MOTOR_DEAD_TIME_MS;
-    else if( isParameterName( metadata[i].name, "terminal_print_period" ) )
-      parameters[parameterCount].currentValue = TERMINAL_PRINT_PERIOD_MS;
-    else if( isParameterName( metadata[i].name, "terminal_moving_period" ) )
-      parameters[parameterCount].currentValue = TERMINAL_MOVING_PRINT_PERIOD_MS;
-    else if( isParameterName( metadata[i].name, "terminal_periodic_logs" ) )
-      parameters[parameterCount].currentValue = TERMINAL_ENABLE_PERIODIC_LOGS ? 1.0f : 0.0f;
-    else if( isParameterName( metadata[i].name, "terminal_log_only_moving" ) )
-      parameters[parameterCount].currentValue = TERMINAL_LOG_ONLY_WHILE_MOVING ? 1.0f : 0.0f;
-    
-    parameterCount++;
+    parameters[i].currentValue = pgm_read_float( &PARAMETER_TABLE[i].defaultValue );
   }
 }
 
@@ -240,7 +266,9 @@ void Settings::refreshParameterValues()
 {
   for( int i = 0; i < parameterCount; i++ )
   {
-    parameters[i].currentValue = getCurrentParameterValue( parameters[i].meta.name );
+    ParameterMetadata meta;
+    getParameterMetadata( i, &meta );
+    parameters[i].currentValue = getCurrentParameterValue( meta.name );
   }
 }
 
@@ -297,6 +325,88 @@ float Settings::getCurrentParameterValue( const char* name )
     return terminal->getPeriodicLogs() ? 1.0f : 0.0f;
   else if( isParameterName( name, "terminal_log_only_moving" ) )
     return terminal->getLogOnlyWhileMoving() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "adaptive_schedule" ) )
+    return tracker->getAdaptiveScheduleEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "adj_period_min" ) )
+    return tracker->getAdjustmentPeriodMin();
+  else if( isParameterName( name, "adj_period_max" ) )
+    return tracker->getAdjustmentPeriodMax();
+  else if( isParameterName( name, "cloud_detect" ) )
+    return tracker->getCloudDetector()->getEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "cloud_threshold" ) )
+    return tracker->getCloudDetector()->getThreshold();
+  else if( isParameterName( name, "cloud_holdoff" ) )
+    return tracker->getCloudDetector()->getHoldoffTime();
+  else if( isParameterName( name, "energy_aware" ) )
+    return tracker->getEnergyAwareEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "panel_power" ) )
+    return tracker->getPanelPower();
+  else if( isParameterName( name, "motor_power" ) )
+    return tracker->getMotorPower();
+  else if( isParameterName( name, "deg_per_pct" ) )
+    return tracker->getDegreesPerPercent();
+  else if( isParameterName( name, "kalman_filter" ) )
+    return tracker->getKalmanEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "sun_search" ) )
+    return tracker->getSunSearchEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "sun_search_steps" ) )
+    return tracker->getSunSearchSteps();
+  else if( isParameterName( name, "sun_search_timeout" ) )
+    return tracker->getSunSearchTimeout();
+  else if( isParameterName( name, "sun_search_span" ) )
+    return tracker->getSunSearchSpan();
+  else if( isParameterName( name, "tracking_strategy" ) )
+    return tracker->getTrackingStrategy();
+  else if( isParameterName( name, "hc_step" ) )
+    return tracker->getHillClimbStep();
+  else if( isParameterName( name, "hc_max_steps" ) )
+    return tracker->getHillClimbMaxSteps();
+  else if( isParameterName( name, "hc_deadband" ) )
+    return tracker->getHillClimbDeadband();
+  else if( isParameterName( name, "start_limit" ) )
+    return motorControl->getStartLimitEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "start_burst" ) )
+    return motorControl->getStartBurst();
+  else if( isParameterName( name, "start_rate" ) )
+    return motorControl->getStartRefillRate();
+  else if( isParameterName( name, "auto_tune" ) )
+    return tracker->getAutoTuneEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "backlash" ) )
+    return motorControl->getConfiguredBacklash();
+  else if( isParameterName( name, "backlash_learn" ) )
+    return motorControl->getBacklashLearnEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "shading_map" ) )
+    return tracker->getShadingMapEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "elev_tol" ) )
+    return tracker->getElevationTolerance();
+  else if( isParameterName( name, "elev_period" ) )
+    return tracker->getElevationAdjustmentPeriod();
+  else if( isParameterName( name, "elev_max_move" ) )
+    return tracker->getElevationMaxMovementTime();
+  else if( isParameterName( name, "max_motors" ) )
+    return tracker->getMaxMotorsRunning();
+  else if( isParameterName( name, "travel" ) )
+    return motorControl->getTravel();
+  else if( isParameterName( name, "soft_limits" ) )
+    return motorControl->getSoftLimitsEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "soft_margin" ) )
+    return motorControl->getSoftLimitMargin();
+  else if( isParameterName( name, "stall_detect" ) )
+    return tracker->getStallDetector()->getEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "movement_average" ) )
+    return tracker->getMovementAverageMode();
+  else if( isParameterName( name, "backtracking" ) )
+    return tracker->getBacktracker()->getEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "row_pitch" ) )
+    return tracker->getBacktracker()->getRowPitch();
+  else if( isParameterName( name, "panel_width" ) )
+    return tracker->getBacktracker()->getPanelWidth();
+  else if( isParameterName( name, "motor_pwm" ) )
+    return motorControl->getPwmEnabled() ? 1.0f : 0.0f;
+  else if( isParameterName( name, "ramp_time" ) )
+    return motorControl->getRampTime();
+  else if( isParameterName( name, "approach_speed" ) )
+    return motorControl->getApproachSpeed();
   
   return 0.0f;
 }
@@ -306,16 +416,24 @@ bool Settings::isParameterName( const char* name1, const char* name2 )
   return strcasecmp( name1, name2 ) == 0;
 }
 
-Parameter* Settings::findParameter( const char* name )
+int Settings::findParameterIndex( const char* name, bool shortNameOnly ) const
 {
+  // Compared in place, without copying the entries out of flash
   for( int i = 0; i < parameterCount; i++ )
   {
-    if( isParameterName( name, parameters[i].meta.name ) || isParameterName( name, parameters[i].meta.shortName ) )
+    if( strcasecmp_P( name, PARAMETER_TABLE[i].shortName ) == 0 ||
+        ( !shortNameOnly && strcasecmp_P( name, PARAMETER_TABLE[i].name ) == 0 ) )
     {
-      return &parameters[i];
+      return i;
     }
   }
-  return nullptr;
+  return -1;
+}
+
+Parameter* Settings::findParameter( const char* name )
+{
+  int index = findParameterIndex( name );
+  return index >= 0 ? &parameters[index] : nullptr;
 }
 
 bool Settings::validateTimeValue( float value )
@@ -340,7 +458,9 @@ bool Settings::validateParameterConstraints( const char* paramName, float value
   if( !param )
     return false;
     
-  if( value < param->meta.minValue || value > param->meta.maxValue )
+  ParameterMetadata meta;
+  getParameterMetadata( param, &meta );
+  if( value < meta.minValue || value > meta.maxValue )
     return false;
     
   // Check interdependent constraints
@@ -410,6 +530,36 @@ bool Settings::validateParameterConstraints( const char* paramName, float value
       return false;
     }
   }
+  else if( isParameterName( paramName, "travel" ) )
+  {
+    // A move that times out is only taken as arriving at an end stop if
+    // full travel fits in the motor timeout at the slower learned speed
+    const PanelPosition* position = motorControl->getPosition();
+    uint16_t speed = min( position->getSpeed( false ), position->getSpeed( true ));
+    if( value * 1000.0f > (float)MOTOR_MAX_MOVE_TIME_SECONDS * speed )
+    {
+      printParameterConstraintError( paramName, "must fit in the motor timeout at the learned speed" );
+      return false;
+    }
+  }
+  else if( isParameterName( paramName, "adj_period_min" ) )
+  {
+    float periodMax = getCurrentParameterValue( "adj_period_max" );
+    if( value > periodMax )
+    {
+      printParameterConstraintError( paramName, "must be less than or equal to adj_period_max" );
+      return false;
+    }
+  }
+  else if( isParameterName( paramName, "adj_period_max" ) )
+  {
+    float periodMin = getCurrentParameterValue( "adj_period_min" );
+    if( value < periodMin )
+    {
+      printParameterConstraintError( paramName, "must be greater than or equal to adj_period_min" );
+      return false;
+    }
+  }
   
   return true;
 }
@@ -428,7 +578,9 @@ bool Settings::setParameter( const char* paramName, const char* valueStr )
   // Handle boolean values
   if( Parameter* param = findParameter( paramName ) )
   {
-    if( strlen( param->meta.units ) == 0 && param->meta.maxValue == 1.0f && param->meta.minValue == 0.0f )
+    ParameterMetadata meta;
+    getParameterMetadata( param, &meta );
+    if( strlen( meta.units ) == 0 && meta.maxValue == 1.0f && meta.minValue == 0.0f )
     {
       // Convert string to boolean
       bool boolValue;
@@ -452,8 +604,8 @@ bool Settings::setParameter( const char* paramName, const char* valueStr )
     }
     
     // Handle large integer values (like resistance values)
-    if( isParameterName( param->meta.name, "night_threshold" ) ||
-        isParameterName( param->meta.name, "brightness_threshold" ) )
+    if( isParameterName( meta.name, "night_threshold" ) ||
+        isParameterName( meta.name, "brightness_threshold" ) )
     {
       char* endPtr;
       long value = strtol( valueStr, &endPtr, 10 );
@@ -476,27 +628,8 @@ bool Settings::setParameter( const char* paramName, const char* valueStr )
 bool Settings::setParameter( const char* paramName, float value )
 {
   // Look up parameter based on shortNameOnly flag
-  Parameter* param = nullptr;
-  for( int i = 0; i < parameterCount; i++ )
-  {
-    if( shortNameOnly )
-    {
-      if( isParameterName( paramName, parameters[i].meta.shortName ) )
-      {
-        param = &parameters[i];
-        break;
-      }
-    }
-    else
-    {
-      if( isParameterName( paramName, parameters[i].meta.name ) || 
-          isParameterName( paramName, parameters[i].meta.shortName ) )
-      {
-        param = &parameters[i];
-        break;
-      }
-    }
-  }
+  int index = findParameterIndex( paramName, shortNameOnly );
+  Parameter* param = index >= 0 ? &parameters[index] : nullptr;
   
   if( !param )
   {
@@ -507,7 +640,9 @@ bool Settings::setParameter( const char* paramName, float value )
     return false;
   }
   
-  if( !validateParameterConstraints( param->meta.name, value ) )
+  ParameterMetadata meta;
+  getParameterMetadata( index, &meta );
+  if( !validateParameterConstraints( meta.name, value ) )
   {
     return false;
   }
@@ -515,56 +650,138 @@ bool Settings::setParameter( const char* paramName, float value )
   // Apply the parameter change
   bool success = true;
   
-  if( isParameterName( param->meta.name, "balance_tol" ) )
+  if( isParameterName( meta.name, "balance_tol" ) )
     tracker->setTolerance( value );
-  else if( isParameterName( param->meta.name, "max_move_time" ) )
+  else if( isParameterName( meta.name, "max_move_time" ) )
     tracker->setMaxMovementTime( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "adjustment_period" ) )
+  else if( isParameterName( meta.name, "adjustment_period" ) )
     tracker->setAdjustmentPeriod( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "sampling_rate" ) )
+  else if( isParameterName( meta.name, "sampling_rate" ) )
     tracker->setSamplingRate( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "brightness_threshold" ) )
+  else if( isParameterName( meta.name, "brightness_threshold" ) )
     tracker->setBrightnessThreshold( (int32_t)value );
-  else if( isParameterName( param->meta.name, "brightness_filter_tau" ) )
+  else if( isParameterName( meta.name, "brightness_filter_tau" ) )
     tracker->setBrightnessFilterTimeConstant( value );
-  else if( isParameterName( param->meta.name, "night_threshold" ) )
+  else if( isParameterName( meta.name, "night_threshold" ) )
     tracker->setNightThreshold( (int32_t)value );
-  else if( isParameterName( param->meta.name, "night_hysteresis" ) )
+  else if( isParameterName( meta.name, "night_hysteresis" ) )
     tracker->setNightHysteresis( value );
-  else if( isParameterName( param->meta.name, "night_detection_time" ) )
+  else if( isParameterName( meta.name, "night_detection_time" ) )
     tracker->setNightDetectionTime( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "reversal_dead_time" ) )
+  else if( isParameterName( meta.name, "reversal_dead_time" ) )
     tracker->setReversalDeadTime( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "reversal_time_limit" ) )
+  else if( isParameterName( meta.name, "reversal_time_limit" ) )
     tracker->setReversalTimeLimit( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "max_reversal_tries" ) )
+  else if( isParameterName( meta.name, "max_reversal_tries" ) )
     tracker->setMaxReversalTries( (int)value );
-  else if( isParameterName( param->meta.name, "default_west_enabled" ) )
+  else if( isParameterName( meta.name, "default_west_enabled" ) )
     tracker->setDefaultWestMovementEnabled( value != 0.0f );
-  else if( isParameterName( param->meta.name, "default_west_time" ) )
+  else if( isParameterName( meta.name, "default_west_time" ) )
     tracker->setDefaultWestMovementTime( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "use_average_movement" ) )
+  else if( isParameterName( meta.name, "use_average_movement" ) )
     tracker->setUseAverageMovementTime( value != 0.0f );
-  else if( isParameterName( param->meta.name, "movement_history_size" ) )
+  else if( isParameterName( meta.name, "movement_history_size" ) )
     tracker->setMovementHistorySize( (uint8_t)value );
-  else if( isParameterName( param->meta.name, "monitor_mode" ) )
+  else if( isParameterName( meta.name, "monitor_mode" ) )
     tracker->setMonitorModeEnabled( value != 0.0f );
-  else if( isParameterName( param->meta.name, "start_move_thresh" ) )
+  else if( isParameterName( meta.name, "start_move_thresh" ) )
     tracker->setStartMoveThreshold( value );
-  else if( isParameterName( param->meta.name, "min_wait" ) )
+  else if( isParameterName( meta.name, "min_wait" ) )
     tracker->setMinWaitTime( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "monitor_filt_tau" ) )
+  else if( isParameterName( meta.name, "monitor_filt_tau" ) )
     tracker->setMonitorFilterTimeConstant( value );
-  else if( isParameterName( param->meta.name, "motor_dead_time" ) )
+  else if( isParameterName( meta.name, "motor_dead_time" ) )
     motorControl->setDeadTime( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "terminal_print_period" ) )
+  else if( isParameterName( meta.name, "terminal_print_period" ) )
     terminal->setPrintPeriod( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "terminal_moving_period" ) )
+  else if( isParameterName( meta.name, "terminal_moving_period" ) )
     terminal->setMovingPrintPeriod( (unsigned long)value );
-  else if( isParameterName( param->meta.name, "terminal_periodic_logs" ) )
+  else if( isParameterName( meta.name, "terminal_periodic_logs" ) )
     terminal->setPeriodicLogs( value != 0.0f );
-  else if( isParameterName( param->meta.name, "terminal_log_only_moving" ) )
+  else if( isParameterName( meta.name, "terminal_log_only_moving" ) )
     terminal->setLogOnlyWhileMoving( value != 0.0f );
+  else if( isParameterName( meta.name, "adaptive_schedule" ) )
+    tracker->setAdaptiveScheduleEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "adj_period_min" ) )
+    tracker->setAdjustmentPeriodMin( (unsigned long)value );
+  else if( isParameterName( meta.name, "adj_period_max" ) )
+    tracker->setAdjustmentPeriodMax( (unsigned long)value );
+  else if( isParameterName( meta.name, "cloud_detect" ) )
+    tracker->getCloudDetector()->setEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "cloud_threshold" ) )
+    tracker->getCloudDetector()->setThreshold( value );
+  else if( isParameterName( meta.name, "cloud_holdoff" ) )
+    tracker->getCloudDetector()->setHoldoffTime( (unsigned long)value );
+  else if( isParameterName( meta.name, "energy_aware" ) )
+    tracker->setEnergyAwareEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "panel_power" ) )
+    tracker->setPanelPower( value );
+  else if( isParameterName( meta.name, "motor_power" ) )
+    tracker->setMotorPower( value );
+  else if( isParameterName( meta.name, "deg_per_pct" ) )
+    tracker->setDegreesPerPercent( value );
+  else if( isParameterName( meta.name, "kalman_filter" ) )
+    tracker->setKalmanEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "sun_search" ) )
+    tracker->setSunSearchEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "sun_search_steps" ) )
+    tracker->setSunSearchSteps( (uint8_t)value );
+  else if( isParameterName( meta.name, "sun_search_timeout" ) )
+    tracker->setSunSearchTimeout( (unsigned long)value );
+  else if( isParameterName( meta.name, "sun_search_span" ) )
+    tracker->setSunSearchSpan( (unsigned long)value );
+  else if( isParameterName( meta.name, "tracking_strategy" ) )
+    tracker->setTrackingStrategy( (uint8_t)value );
+  else if( isParameterName( meta.name, "hc_step" ) )
+    tracker->setHillClimbStep( (unsigned long)value );
+  else if( isParameterName( meta.name, "hc_max_steps" ) )
+    tracker->setHillClimbMaxSteps( (uint8_t)value );
+  else if( isParameterName( meta.name, "hc_deadband" ) )
+    tracker->setHillClimbDeadband( value );
+  else if( isParameterName( meta.name, "start_limit" ) )
+    motorControl->setStartLimitEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "start_burst" ) )
+    motorControl->setStartBurst( (uint16_t)value );
+  else if( isParameterName( meta.name, "start_rate" ) )
+    motorControl->setStartRefillRate( (uint16_t)value );
+  else if( isParameterName( meta.name, "auto_tune" ) )
+    tracker->setAutoTuneEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "backlash" ) )
+    motorControl->setBacklash( (unsigned long)value );
+  else if( isParameterName( meta.name, "backlash_learn" ) )
+    motorControl->setBacklashLearnEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "shading_map" ) )
+    tracker->setShadingMapEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "elev_tol" ) )
+    tracker->setElevationTolerance( value );
+  else if( isParameterName( meta.name, "elev_period" ) )
+    tracker->setElevationAdjustmentPeriod( (unsigned long)value );
+  else if( isParameterName( meta.name, "elev_max_move" ) )
+    tracker->setElevationMaxMovementTime( (unsigned long)value );
+  else if( isParameterName( meta.name, "max_motors" ) )
+    tracker->setMaxMotorsRunning( (uint8_t)value );
+  else if( isParameterName( meta.name, "travel" ) )
+    motorControl->setTravel( (uint16_t)value );
+  else if( isParameterName( meta.name, "soft_limits" ) )
+    motorControl->setSoftLimitsEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "soft_margin" ) )
+    motorControl->setSoftLimitMargin( (uint16_t)value );
+  else if( isParameterName( meta.name, "stall_detect" ) )
+    tracker->setStallDetectEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "movement_average" ) )
+    tracker->setMovementAverageMode( (uint8_t)value );
+  else if( isParameterName( meta.name, "backtracking" ) )
+    tracker->getBacktracker()->setEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "row_pitch" ) )
+    tracker->getBacktracker()->setRowPitch( (uint16_t)value );
+  else if( isParameterName( meta.name, "panel_width" ) )
+    tracker->getBacktracker()->setPanelWidth( (uint16_t)value );
+  else if( isParameterName( meta.name, "motor_pwm" ) )
+    motorControl->setPwmEnabled( value != 0.0f );
+  else if( isParameterName( meta.name, "ramp_time" ) )
+    motorControl->setRampTime( (unsigned long)value );
+  else if( isParameterName( meta.name, "approach_speed" ) )
+    motorControl->setApproachSpeed( (uint8_t)value );
   else
   {
     Serial.println();
@@ -577,20 +794,20 @@ bool Settings::setParameter( const char* paramName, float value )
   if( success )
   {
     // Update Parameter struct and EEPROM
-    updateParameterValue( param->meta.name, value );
+    updateParameterValue( meta.name, value );
     
     Serial.println();
     Serial.print( "Parameter '" );
-    Serial.print( param->meta.name );
+    Serial.print( meta.name );
     Serial.print( "' set to " );
     
     // Special handling for large integer values
-    if( isParameterName( param->meta.name, "night_threshold" ) ||
-        isParameterName( param->meta.name, "brightness_threshold" ) )
+    if( isParameterName( meta.name, "night_threshold" ) ||
+        isParameterName( meta.name, "brightness_threshold" ) )
     {
       Serial.print( (int32_t)value );
     }
-    else if( param->meta.isInteger )
+    else if( meta.isInteger )
     {
       Serial.print( (int)value );
     }
@@ -599,10 +816,10 @@ bool Settings::setParameter( const char* paramName, float value )
       Serial.print( value );
     }
     
-    if( strlen( param->meta.units ) > 0 )
+    if( strlen( meta.units ) > 0 )
     {
       Serial.print( " " );
-      Serial.print( param->meta.units );
+      Serial.print( meta.units );
     }
     Serial.println();
   }
@@ -633,57 +850,141 @@ void Settings::updateModuleValues()
   {
     Parameter* param = &parameters[i];
     float value = param->currentValue;
+    ParameterMetadata meta;
+    getParameterMetadata( i, &meta );
     
-    if( isParameterName( param->meta.name, "balance_tol" ) )
+    if( isParameterName( meta.name, "balance_tol" ) )
       tracker->setTolerance( value );
-    else if( isParameterName( param->meta.name, "max_move_time" ) )
+    else if( isParameterName( meta.name, "max_move_time" ) )
       tracker->setMaxMovementTime( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "adjustment_period" ) )
+    else if( isParameterName( meta.name, "adjustment_period" ) )
       tracker->setAdjustmentPeriod( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "sampling_rate" ) )
+    else if( isParameterName( meta.name, "sampling_rate" ) )
       tracker->setSamplingRate( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "brightness_threshold" ) )
+    else if( isParameterName( meta.name, "brightness_threshold" ) )
       tracker->setBrightnessThreshold( (int32_t)value );
-    else if( isParameterName( param->meta.name, "brightness_filter_tau" ) )
+    else if( isParameterName( meta.name, "brightness_filter_tau" ) )
       tracker->setBrightnessFilterTimeConstant( value );
-    else if( isParameterName( param->meta.name, "night_threshold" ) )
+    else if( isParameterName( meta.name, "night_threshold" ) )
       tracker->setNightThreshold( (int32_t)value );
-    else if( isParameterName( param->meta.name, "night_hysteresis" ) )
+    else if( isParameterName( meta.name, "night_hysteresis" ) )
       tracker->setNightHysteresis( value );
-    else if( isParameterName( param->meta.name, "night_detection_time" ) )
+    else if( isParameterName( meta.name, "night_detection_time" ) )
       tracker->setNightDetectionTime( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "reversal_dead_time" ) )
+    else if( isParameterName( meta.name, "reversal_dead_time" ) )
       tracker->setReversalDeadTime( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "reversal_time_limit" ) )
+    else if( isParameterName( meta.name, "reversal_time_limit" ) )
       tracker->setReversalTimeLimit( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "max_reversal_tries" ) )
+    else if( isParameterName( meta.name, "max_reversal_tries" ) )
       tracker->setMaxReversalTries( (int)value );
-    else if( isParameterName( param->meta.name, "default_west_enabled" ) )
+    else if( isParameterName( meta.name, "default_west_enabled" ) )
       tracker->setDefaultWestMovementEnabled( value != 0.0f );
-    else if( isParameterName( param->meta.name, "default_west_time" ) )
+    else if( isParameterName( meta.name, "default_west_time" ) )
       tracker->setDefaultWestMovementTime( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "use_average_movement" ) )
+    else if( isParameterName( meta.name, "use_average_movement" ) )
       tracker->setUseAverageMovementTime( value != 0.0f );
-    else if( isParameterName( param->meta.name, "movement_history_size" ) )
+    else if( isParameterName( meta.name, "movement_history_size" ) )
       tracker->setMovementHistorySize( (uint8_t)value );
-    else if( isParameterName( param->meta.name, "monitor_mode" ) )
+    else if( isParameterName( meta.name, "monitor_mode" ) )
       tracker->setMonitorModeEnabled( value != 0.0f );
-    else if( isParameterName( param->meta.name, "start_move_thresh" ) )
+    else if( isParameterName( meta.name, "start_move_thresh" ) )
       tracker->setStartMoveThreshold( value );
-    else if( isParameterName( param->meta.name, "min_wait" ) )
+    else if( isParameterName( meta.name, "min_wait" ) )
       tracker->setMinWaitTime( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "monitor_filt_tau" ) )
+    else if( isParameterName( meta.name, "monitor_filt_tau" ) )
       tracker->setMonitorFilterTimeConstant( value );
-    else if( isParameterName( param->meta.name, "motor_dead_time" ) )
+    else if( isParameterName( meta.name, "motor_dead_time" ) )
       motorControl->setDeadTime( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "terminal_print_period" ) )
+    else if( isParameterName( meta.name, "terminal_print_period" ) )
       terminal->setPrintPeriod( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "terminal_moving_period" ) )
+    else if( isParameterName( meta.name, "terminal_moving_period" ) )
       terminal->setMovingPrintPeriod( (unsigned long)value );
-    else if( isParameterName( param->meta.name, "terminal_periodic_logs" ) )
+    else if( isParameterName( meta.name, "terminal_periodic_logs" ) )
       terminal->setPeriodicLogs( value != 0.0f );
-    else if( isParameterName( param->meta.name, "terminal_log_only_moving" ) )
+    else if( isParameterName( meta.name, "terminal_log_only_moving" ) )
       terminal->setLogOnlyWhileMoving( value != 0.0f );
+    else if( isParameterName( meta.name, "adaptive_schedule" ) )
+      tracker->setAdaptiveScheduleEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "adj_period_min" ) )
+      tracker->setAdjustmentPeriodMin( (unsigned long)value );
+    else if( isParameterName( meta.name, "adj_period_max" ) )
+      tracker->setAdjustmentPeriodMax( (unsigned long)value );
+    else if( isParameterName( meta.name, "cloud_detect" ) )
+      tracker->getCloudDetector()->setEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "cloud_threshold" ) )
+      tracker->getCloudDetector()->setThreshold( value );
+    else if( isParameterName( meta.name, "cloud_holdoff" ) )
+      tracker->getCloudDetector()->setHoldoffTime( (unsigned long)value );
+    else if( isParameterName( meta.name, "energy_aware" ) )
+      tracker->setEnergyAwareEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "panel_power" ) )
+      tracker->setPanelPower( value );
+    else if( isParameterName( meta.name, "motor_power" ) )
+      tracker->setMotorPower( value );
+    else if( isParameterName( meta.name, "deg_per_pct" ) )
+      tracker->setDegreesPerPercent( value );
+    else if( isParameterName( meta.name, "kalman_filter" ) )
+      tracker->setKalmanEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "sun_search" ) )
+      tracker->setSunSearchEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "sun_search_steps" ) )
+      tracker->setSunSearchSteps( (uint8_t)value );
+    else if( isParameterName( meta.name, "sun_search_timeout" ) )
+      tracker->setSunSearchTimeout( (unsigned long)value );
+    else if( isParameterName( meta.name, "sun_search_span" ) )
+      tracker->setSunSearchSpan( (unsigned long)value );
+    else if( isParameterName( meta.name, "tracking_strategy" ) )
+      tracker->setTrackingStrategy( (uint8_t)value );
+    else if( isParameterName( meta.name, "hc_step" ) )
+      tracker->setHillClimbStep( (unsigned long)value );
+    else if( isParameterName( meta.name, "hc_max_steps" ) )
+      tracker->setHillClimbMaxSteps( (uint8_t)value );
+    else if( isParameterName( meta.name, "hc_deadband" ) )
+      tracker->setHillClimbDeadband( value );
+    else if( isParameterName( meta.name, "start_limit" ) )
+      motorControl->setStartLimitEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "start_burst" ) )
+      motorControl->setStartBurst( (uint16_t)value );
+    else if( isParameterName( meta.name, "start_rate" ) )
+      motorControl->setStartRefillRate( (uint16_t)value );
+    else if( isParameterName( meta.name, "auto_tune" ) )
+      tracker->setAutoTuneEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "backlash" ) )
+      motorControl->setBacklash( (unsigned long)value );
+    else if( isParameterName( meta.name, "backlash_learn" ) )
+      motorControl->setBacklashLearnEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "shading_map" ) )
+      tracker->setShadingMapEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "elev_tol" ) )
+      tracker->setElevationTolerance( value );
+    else if( isParameterName( meta.name, "elev_period" ) )
+      tracker->setElevationAdjustmentPeriod( (unsigned long)value );
+    else if( isParameterName( meta.name, "elev_max_move" ) )
+      tracker->setElevationMaxMovementTime( (unsigned long)value );
+    else if( isParameterName( meta.name, "max_motors" ) )
+      tracker->setMaxMotorsRunning( (uint8_t)value );
+    else if( isParameterName( meta.name, "travel" ) )
+      motorControl->setTravel( (uint16_t)value );
+    else if( isParameterName( meta.name, "soft_limits" ) )
+      motorControl->setSoftLimitsEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "soft_margin" ) )
+      motorControl->setSoftLimitMargin( (uint16_t)value );
+    else if( isParameterName( meta.name, "stall_detect" ) )
+      tracker->setStallDetectEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "movement_average" ) )
+      tracker->setMovementAverageMode( (uint8_t)value );
+    else if( isParameterName( meta.name, "backtracking" ) )
+      tracker->getBacktracker()->setEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "row_pitch" ) )
+      tracker->getBacktracker()->setRowPitch( (uint16_t)value );
+    else if( isParameterName( meta.name, "panel_width" ) )
+      tracker->getBacktracker()->setPanelWidth( (uint16_t)value );
+    else if( isParameterName( meta.name, "motor_pwm" ) )
+      motorControl->setPwmEnabled( value != 0.0f );
+    else if( isParameterName( meta.name, "ramp_time" ) )
+      motorControl->setRampTime( (unsigned long)value );
+    else if( isParameterName( meta.name, "approach_speed" ) )
+      motorControl->setApproachSpeed( (uint8_t)value );
   }
 }
 
@@ -940,7 +1241,7 @@ void Settings::printParameterWithDescription( Parameter* param )
   int maxNameLen = 0;
   for( int i = 0; i < parameterCount; i++ )
   {
-    int nameLen = strlen( parameters[i].meta.name );
+    int nameLen = strlen_P( PARAMETER_TABLE[i].name );
     if( nameLen > maxNameLen )
     {
       maxNameLen = nameLen;
@@ -1002,6 +1303,88 @@ const char* Settings::getParameterDescription( const char* paramName )
     return DESC_TERMINAL_PERIODIC_LOGS;
   else if( isParameterName( paramName, "terminal_log_only_moving" ) )
     return DESC_TERMINAL_LOG_ONLY_MOVING;
+  else if( isParameterName( paramName, "adaptive_schedule" ) )
+    return DESC_ADAPTIVE_SCHEDULE;
+  else if( isParameterName( paramName, "adj_period_min" ) )
+    return DESC_ADJ_PERIOD_MIN;
+  else if( isParameterName( paramName, "adj_period_max" ) )
+    return DESC_ADJ_PERIOD_MAX;
+  else if( isParameterName( paramName, "cloud_detect" ) )
+    return DESC_CLOUD_DETECT;
+  else if( isParameterName( paramName, "cloud_threshold" ) )
+    return DESC_CLOUD_THRESHOLD;
+  else if( isParameterName( paramName, "cloud_holdoff" ) )
+    return DESC_CLOUD_HOLDOFF;
+  else if( isParameterName( paramName, "energy_aware" ) )
+    return DESC_ENERGY_AWARE;
+  else if( isParameterName( paramName, "panel_power" ) )
+    return DESC_PANEL_POWER;
+  else if( isParameterName( paramName, "motor_power" ) )
+    return DESC_MOTOR_POWER;
+  else if( isParameterName( paramName, "deg_per_pct" ) )
+    return DESC_DEG_PER_PCT;
+  else if( isParameterName( paramName, "kalman_filter" ) )
+    return DESC_KALMAN_FILTER;
+  else if( isParameterName( paramName, "sun_search" ) )
+    return DESC_SUN_SEARCH;
+  else if( isParameterName( paramName, "sun_search_steps" ) )
+    return DESC_SUN_SEARCH_STEPS;
+  else if( isParameterName( paramName, "sun_search_timeout" ) )
+    return DESC_SUN_SEARCH_TIMEOUT;
+  else if( isParameterName( paramName, "sun_search_span" ) )
+    return DESC_SUN_SEARCH_SPAN;
+  else if( isParameterName( paramName, "tracking_strategy" ) )
+    return DESC_TRACKING_STRATEGY;
+  else if( isParameterName( paramName, "hc_step" ) )
+    return DESC_HC_STEP;
+  else if( isParameterName( paramName, "hc_max_steps" ) )
+    return DESC_HC_MAX_STEPS;
+  else if( isParameterName( paramName, "hc_deadband" ) )
+    return DESC_HC_DEADBAND;
+  else if( isParameterName( paramName, "start_limit" ) )
+    return DESC_START_LIMIT;
+  else if( isParameterName( paramName, "start_burst" ) )
+    return DESC_START_BURST;
+  else if( isParameterName( paramName, "start_rate" ) )
+    return DESC_START_RATE;
+  else if( isParameterName( paramName, "auto_tune" ) )
+    return DESC_AUTO_TUNE;
+  else if( isParameterName( paramName, "backlash" ) )
+    return DESC_BACKLASH;
+  else if( isParameterName( paramName, "backlash_learn" ) )
+    return DESC_BACKLASH_LEARN;
+  else if( isParameterName( paramName, "shading_map" ) )
+    return DESC_SHADING_MAP;
+  else if( isParameterName( paramName, "elev_tol" ) )
+    return DESC_ELEV_TOL;
+  else if( isParameterName( paramName, "elev_period" ) )
+    return DESC_ELEV_PERIOD;
+  else if( isParameterName( paramName, "elev_max_move" ) )
+    return DESC_ELEV_MAX_MOVE;
+  else if( isParameterName( paramName, "max_motors" ) )
+    return DESC_MAX_MOTORS;
+  else if( isParameterName( paramName, "travel" ) )
+    return DESC_TRAVEL;
+  else if( isParameterName( paramName, "soft_limits" ) )
+    return DESC_SOFT_LIMITS;
+  else if( isParameterName( paramName, "soft_margin" ) )
+    return DESC_SOFT_MARGIN;
+  else if( isParameterName( paramName, "stall_detect" ) )
+    return DESC_STALL_DETECT;
+  else if( isParameterName( paramName, "movement_average" ) )
+    return DESC_MOVEMENT_AVERAGE;
+  else if( isParameterName( paramName, "backtracking" ) )
+    return DESC_BACKTRACKING;
+  else if( isParameterName( paramName, "row_pitch" ) )
+    return DESC_ROW_PITCH;
+  else if( isParameterName( paramName, "panel_width" ) )
+    return DESC_PANEL_WIDTH;
+  else if( isParameterName( paramName, "motor_pwm" ) )
+    return DESC_MOTOR_PWM;
+  else if( isParameterName( paramName, "ramp_time" ) )
+    return DESC_RAMP_TIME;
+  else if( isParameterName( paramName, "approach_speed" ) )
+    return DESC_APPROACH_SPEED;
   
   return PSTR("");
 }
@@ -1021,7 +1404,7 @@ void Settings::handleSetCommand( const char* paramName, const char* valueStr )
     int maxNameLen = 0;
     for(int i = 0; i < parameterCount; i++)
     {
-      int nameLen = strlen(parameters[i].meta.name);
+      int nameLen = strlen_P(PARAMETER_TABLE[i].name);
       if(nameLen > maxNameLen)
       {
         maxNameLen = nameLen;
@@ -1056,7 +1439,11 @@ void Settings::handleSetCommand( const char* paramName, const char* valueStr )
       "adjustment_period",
       "reversal_dead_time",
       "reversal_time_limit",
-      "max_reversal_tries"
+      "max_reversal_tries",
+      "kalman_filter",
+      "auto_tune",
+      "shading_map",
+      "stall_detect"
     };
     
     for(size_t i = 0; i < sizeof(trackerParams) / sizeof(trackerParams[0]); i++)
@@ -1074,7 +1461,8 @@ void Settings::handleSetCommand( const char* paramName, const char* valueStr )
       "default_west_enabled",
       "default_west_time",
       "use_average_movement",
-      "movement_history_size"
+      "movement_history_size",
+      "movement_average"
     };
     
     for(size_t i = 0; i < sizeof(defaultWestParams) / sizeof(defaultWestParams[0]); i++)
@@ -1086,6 +1474,94 @@ void Settings::handleSetCommand( const char* paramName, const char* valueStr )
       }
     }
     
+    Serial.println();
+    Serial.println(F("ADAPTIVE SCHEDULING PARAMETERS:"));
+    const char* scheduleParams[] = {
+      "adaptive_schedule",
+      "adj_period_min",
+      "adj_period_max"
+    };
+    
+    for(size_t i = 0; i < sizeof(scheduleParams) / sizeof(scheduleParams[0]); i++)
+    {
+      Parameter* param = findParameter(scheduleParams[i]);
+      if(param)
+      {
+        printFormattedParameterWithValue(param, maxNameLen);
+      }
+    }
+    
+    Serial.println();
+    Serial.println(F("CLOUD DETECTION PARAMETERS:"));
+    const char* cloudParams[] = {
+      "cloud_detect",
+      "cloud_threshold",
+      "cloud_holdoff"
+    };
+    
+    for(size_t i = 0; i < sizeof(cloudParams) / sizeof(cloudParams[0]); i++)
+    {
+      Parameter* param = findParameter(cloudParams[i]);
+      if(param)
+      {
+        printFormattedParameterWithValue(param, maxNameLen);
+      }
+    }
+    
+    Serial.println();
+    Serial.println(F("ENERGY-AWARE TRACKING PARAMETERS:"));
+    const char* energyParams[] = {
+      "energy_aware",
+      "panel_power",
+      "motor_power",
+      "deg_per_pct"
+    };
+    
+    for(size_t i = 0; i < sizeof(energyParams) / sizeof(energyParams[0]); i++)
+    {
+      Parameter* param = findParameter(energyParams[i]);
+      if(param)
+      {
+        printFormattedParameterWithValue(param, maxNameLen);
+      }
+    }
+    
+    Serial.println();
+    Serial.println(F("SUN SEARCH PARAMETERS:"));
+    const char* sunSearchParams[] = {
+      "sun_search",
+      "sun_search_steps",
+      "sun_search_timeout",
+      "sun_search_span"
+    };
+    
+    for(size_t i = 0; i < sizeof(sunSearchParams) / sizeof(sunSearchParams[0]); i++)
+    {
+      Parameter* param = findParameter(sunSearchParams[i]);
+      if(param)
+      {
+        printFormattedParameterWithValue(param, maxNameLen);
+      }
+    }
+    
+    Serial.println();
+    Serial.println(F("TRACKING STRATEGY PARAMETERS:"));
+    const char* strategyParams[] = {
+      "tracking_strategy",
+      "hc_step",
+      "hc_max_steps",
+      "hc_deadband"
+    };
+    
+    for(size_t i = 0; i < sizeof(strategyParams) / sizeof(strategyParams[0]); i++)
+    {
+      Parameter* param = findParameter(strategyParams[i]);
+      if(param)
+      {
+        printFormattedParameterWithValue(param, maxNameLen);
+      }
+    }
+    
     Serial.println();
     Serial.println(F("MONITOR MODE PARAMETERS:"));
     const char* monitorParams[] = {
@@ -1104,9 +1580,44 @@ void Settings::handleSetCommand( const char* paramName, const char* valueStr )
       }
     }
     
+    Serial.println();
+    Serial.println(F("DUAL-AXIS PARAMETERS:"));
+    const char* dualAxisParams[] = {
+      "elev_tol",
+      "elev_period",
+      "elev_max_move",
+      "max_motors"
+    };
+    
+    for(size_t i = 0; i < sizeof(dualAxisParams) / sizeof(dualAxisParams[0]); i++)
+    {
+      Parameter* param = findParameter(dualAxisParams[i]);
+      if(param)
+      {
+        printFormattedParameterWithValue(param, maxNameLen);
+      }
+    }
+    
+    Serial.println();
+    Serial.println(F("BACKTRACKING PARAMETERS:"));
+    const char* backtrackParams[] = {
+      "backtracking",
+      "row_pitch",
+      "panel_width"
+    };
+    
+    for(size_t i = 0; i < sizeof(backtrackParams) / sizeof(backtrackParams[0]); i++)
+    {
+      Parameter* param = findParameter(backtrackParams[i]);
+      if(param)
+      {
+        printFormattedParameterWithValue(param, maxNameLen);
+      }
+    }
+    
     Serial.println();
     Serial.println(F("MOTOR PARAMETERS:"));
-    const char* motorParams[] = { "motor_dead_time" };
+    const char* motorParams[] = { "motor_dead_time", "start_limit", "start_burst", "start_rate", "backlash", "backlash_learn", "travel", "soft_limits", "soft_margin", "motor_pwm", "ramp_time", "approach_speed" };
     
     for(size_t i = 0; i < sizeof(motorParams) / sizeof(motorParams[0]); i++)
     {
@@ -1168,6 +1679,12 @@ void Settings::handleHelpCommand()
   Serial.print(F("  ")); // Add 2-space indent
   printLeftAlignedName(CMD_FACTORY_RESET, "Reset all parameters to default values", 30);
   Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName(CMD_TRACE, "Display state transition counts and trace", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName(CMD_ROW, "Show rows, or row <n> [on|off|<tolerance>]", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName(CMD_MOVES, "Display movement duration statistics", 30);
+  Serial.print(F("  ")); // Add 2-space indent
   printLeftAlignedName(CMD_HELP, "Display this help message", 30);
 }
 
@@ -1178,45 +1695,21 @@ void Settings::handleFactoryResetCommand()
   Serial.println(F("Resetting all parameters to default values..."));
   Serial.println();
   
-  // Reset all parameters to their default values
+  // Reset all parameters to their default values, in table order
   bool success = true;
-  
-  // Tracker parameters
-  success &= setParameter("tol", TRACKER_TOLERANCE_PERCENT);
-  success &= setParameter("mmt", TRACKER_MAX_MOVEMENT_TIME_SECONDS);
-  success &= setParameter("adjp", TRACKER_ADJUSTMENT_PERIOD_SECONDS);
-  success &= setParameter("samp", TRACKER_SAMPLING_RATE_MS);
-  success &= setParameter("bth", TRACKER_BRIGHTNESS_THRESHOLD_OHMS);
-  success &= setParameter("bft", TRACKER_BRIGHTNESS_FILTER_TIME_CONSTANT_S);
-  success &= setParameter("nth", TRACKER_NIGHT_THRESHOLD_OHMS);
-  success &= setParameter("nhys", TRACKER_NIGHT_HYSTERESIS_PERCENT);
-  success &= setParameter("ndt", TRACKER_NIGHT_DETECTION_TIME_SECONDS);
-  success &= setParameter("rdt", 1000.0f); // Default value
-  success &= setParameter("rtl", TRACKER_REVERSAL_TIME_LIMIT_MS);
-  success &= setParameter("mrt", 3.0f); // Default value
-  success &= setParameter("dwe", TRACKER_ENABLE_DEFAULT_WEST_MOVEMENT ? 1.0f : 0.0f);
-  success &= setParameter("dwt", TRACKER_DEFAULT_WEST_MOVEMENT_MS);
-  success &= setParameter("uam", TRACKER_USE_AVERAGE_MOVEMENT_TIME ? 1.0f : 0.0f);
-  success &= setParameter("mhs", TRACKER_MOVEMENT_HISTORY_SIZE);
-  
-  // Monitor mode parameters
-  success &= setParameter("mon", TRACKER_MONITOR_MODE_ENABLED ? 1.0f : 0.0f);
-  success &= setParameter("smt", TRACKER_START_MOVE_THRESHOLD_PERCENT);
-  success &= setParameter("mwt", TRACKER_MIN_WAIT_TIME_SECONDS);
-  success &= setParameter("mft", TRACKER_MONITOR_FILTER_TIME_CONSTANT_S);
-  
-  // Motor parameters
-  success &= setParameter("mdt", MOTOR_DEAD_TIME_MS);
-  
-  // Terminal parameters
-  success &= setParameter("tpp", TERMINAL_PRINT_PERIOD_MS);
-  success &= setParameter("tmp", TERMINAL_MOVING_PRINT_PERIOD_MS);
-  success &= setParameter("tpl", TERMINAL_ENABLE_PERIODIC_LOGS ? 1.0f : 0.0f);
-  success &= setParameter("tlm", TERMINAL_LOG_ONLY_WHILE_MOVING ? 1.0f : 0.0f);
+  for(int i = 0; i < parameterCount; i++)
+  {
+    ParameterMetadata meta;
+    getParameterMetadata(i, &meta);
+    success &= setParameter(meta.shortName, meta.defaultValue);
+  }
   
   // Reset EEPROM
   eeprom.factoryReset(this);
   
+  // Forget learned shading
+  tracker->clearShadingMap();
+  
   if(success)
   {
     Serial.println(F("Factory reset completed successfully!"));
@@ -1280,6 +1773,582 @@ void Settings::handleStatusCommand()
     Serial.print(F("  ")); // Add 2-space indent
     printLeftAlignedName("Last Movement Duration", "N/A", 30);
   }
+
+  Serial.println();
+  Serial.println(F("ADAPTIVE SCHEDULING:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Adaptive Schedule", tracker->getAdaptiveScheduleEnabled(), 30);
+  if( tracker->isDriftEstimateValid() )
+  {
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Drift Rate", tracker->getDriftRate(), "ms/min", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Motor Gain", tracker->getMotorGain(), "ms/%", 30);
+  }
+  else
+  {
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Drift Rate", "N/A", 30);
+  }
+  formatTime(tracker->getEffectiveAdjustmentPeriod(), timeBuffer);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Effective Period", timeBuffer, 30);
+
+  Serial.println();
+  Serial.println(F("CLOUD DETECTION:"));
+  const CloudDetector* cloudDetector = tracker->getCloudDetector();
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Cloud Detection", cloudDetector->getEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Light Conditions", cloudDetector->isStable( millis() ) ? "STABLE" : "UNSTABLE", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Brightness Variation", cloudDetector->getBrightnessVariationPercent(), "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Brightness Rate", cloudDetector->getBrightnessRatePercent(), "%/s", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Difference Deviation", cloudDetector->getDifferenceDeviationPercent(), "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Difference Rate", cloudDetector->getDifferenceRatePercent(), "%/s", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Suppressed Adjustments", (unsigned long)tracker->getSuppressedAdjustmentCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Deferred Adjustments", (unsigned long)tracker->getDeferredAdjustmentCount(), "", 30);
+
+  Serial.println();
+  Serial.println(F("ENERGY:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Energy-Aware Tracking", tracker->getEnergyAwareEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Energy Spent Moving", tracker->getEnergySpentMoving(), "mWh", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Estimated Energy Gained", tracker->getEnergyGained(), "mWh", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Expected Gain", tracker->getLastExpectedGain(), "mWh", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Expected Cost", tracker->getLastExpectedCost(), "mWh", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Unprofitable Moves Skipped", (unsigned long)tracker->getUnprofitableSkipCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Motor Run Time", motorControl->getTotalRunTime(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Motor Starts", motorControl->getStartCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Stop Timer Interrupt", motorControl->isTimerAvailable(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Moves Stopped By Timer", motorControl->getTimerStopCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Commands Queued", (unsigned long)motorControl->getQueueLength(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Commands Accepted", motorControl->getQueuedCommandCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Commands Coalesced", motorControl->getCoalescedCommandCount(), "", 30);
+
+  const SunEstimator* estimator = tracker->getSunEstimator();
+  Serial.println(F("SUN ESTIMATOR:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Kalman Filter", tracker->getKalmanEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Estimate Initialized", estimator->isInitialized(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Estimated Imbalance", estimator->getAngle(), "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Estimated Drift", estimator->getRate() * 60.0f, "%/min", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Estimate Uncertainty", estimator->getUncertainty(), "%", 30);
+
+  Serial.println(F("SUN SEARCH:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Sun Search", tracker->getSunSearchEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Search Probes", (unsigned long)tracker->getLastSunSearchProbes(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Search Position", tracker->getLastSunSearchPosition(), "ms", 30);
+
+  PowerSensor* powerSensor = tracker->getPowerSensor();
+  Serial.println(F("PANEL POWER:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Tracking Strategy", tracker->getTrackingStrategyName(), 30);
+  if( powerSensor != nullptr )
+  {
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Panel Voltage", powerSensor->getVoltage(), "V", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Panel Current", powerSensor->getCurrent(), "A", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Panel Power", powerSensor->getPower(), "W", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Energy Harvested Today", tracker->getEnergyHarvestedToday(), "Wh", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Energy Harvested Last Day", tracker->getEnergyHarvestedLastDay(), "Wh", 30);
+  }
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Hill Climb Steps", (unsigned long)tracker->getLastHillClimbSteps(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Hill Climb Gain", tracker->getLastHillClimbGain(), "W", 30);
+
+  const MotionPlanner* planner = tracker->getMotionPlanner();
+  const MotionPlanner::Plan& plan = tracker->getLastPlan();
+  Serial.println(F("MOTION PLANNER:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Model Valid", planner->isGainValid(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Motor Gain", planner->getGain(), "ms/%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Drift Rate", planner->getDriftRate(), "%/min", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Reversal Take-Up", planner->getReversalTakeUp(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Plan Delay", (unsigned long)plan.delaySteps, "steps", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Plan Move", plan.durationMs, "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Plan Direction", plan.west ? "WEST" : "EAST", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Plan Cost", plan.costMwh, "mWh", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Last Idle Cost", plan.idleCostMwh, "mWh", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Planned Moves", (unsigned long)tracker->getPlannedMoveCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Planned Waits", (unsigned long)tracker->getPlannerDeferCount(), "", 30);
+
+  Serial.println(F("MOTOR START LIMITER:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Start Limit", motorControl->getStartLimitEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Starts Available", (unsigned long)motorControl->getStartTokens(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Starts Denied", motorControl->getDeniedStartCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Safety Starts Over Limit", motorControl->getPriorityStartCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Adjustments Rate Limited", (unsigned long)tracker->getStartLimitedAdjustmentCount(), "", 30);
+
+  const AutoTuner* autoTuner = tracker->getAutoTuner();
+  Serial.println(F("AUTO-TUNING:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Auto-Tune", tracker->getAutoTuneEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Active Tolerance", tracker->getActiveTolerance(), "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Low Light Tolerance", tracker->getLowLightTolerance(), "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Imbalance Noise", autoTuner->getImbalanceNoisePercent(), "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Low Light Imbalance Noise", autoTuner->getLowLightImbalanceNoisePercent(), "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Brightness Noise", autoTuner->getBrightnessNoisePercent(), "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Adjustments Today", (unsigned long)autoTuner->getAdjustmentCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Reversals Today", (unsigned long)autoTuner->getReversalCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Aborts Today", (unsigned long)autoTuner->getAbortCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Repeat Moves Today", (unsigned long)autoTuner->getRepeatCount(), "", 30);
+
+  Serial.println(F("BACKLASH:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Backlash Learning", motorControl->getBacklashLearnEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Active Backlash", motorControl->getBacklash(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Learned Backlash", motorControl->getLearnedBacklash(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Forward Response Latency", motorControl->getForwardLatency(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Reversal Response Latency", motorControl->getReversalLatency(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Direction Reversals", motorControl->getReversalCount(), "", 30);
+
+  Serial.println(F("PWM DRIVE:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("PWM Drive", motorControl->getPwmEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("PWM Pins Available", motorControl->isPwmAvailable(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Duty", motorControl->getDuty() * 100.0f / MotorRamp::FULL_DUTY, "%", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Slow Approach", motorControl->isApproaching(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Slow Approaches", motorControl->getApproachCount(), "", 30);
+
+  const PanelPosition* position = motorControl->getPosition();
+  Serial.println(F("PANEL POSITION:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Position Known", position->isKnown(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Angle From East Stop", motorControl->getPositionEstimate() / 1000.0f, "deg", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("East Speed", position->getSpeed( false ) / 1000.0f, "deg/s", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("West Speed", position->getSpeed( true ) / 1000.0f, "deg/s", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Planned Return East", position->getReturnEastTime(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("End Stops Confirmed", (unsigned long)position->getEndStopCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Soft Limit Stops", motorControl->getSoftLimitStopCount(), "", 30);
+
+  const StallDetector* stallDetector = tracker->getStallDetector();
+  Serial.println(F("STALL DETECTION:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Stall Detection", stallDetector->getEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Response Window", stallDetector->getResponseWindow(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Progress Window", stallDetector->getProgressWindow(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Jams", (unsigned long)tracker->getStallJamCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("End Stops Detected", (unsigned long)tracker->getStallEndStopCount(), "", 30);
+
+  const ShadingMap* shadingMap = tracker->getShadingMap();
+  Serial.println(F("SHADING MAP:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Shading Map", tracker->getShadingMapEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Day Clock Known", shadingMap->isDayStarted(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Shading Active", shadingMap->isAnomalyActive(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Shading Predicted Now", shadingMap->isShadingPredicted( millis() ), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Predicted Slots", (unsigned long)shadingMap->getPredictedSlotCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Shading Events Today", (unsigned long)shadingMap->getAnomalyCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Deferred Adjustments", (unsigned long)tracker->getShadingDeferredCount(), "", 30);
+
+  const Backtracker* backtracker = tracker->getBacktracker();
+  unsigned long now = millis();
+  Serial.println(F("BACKTRACKING:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Backtracking", backtracker->getEnabled(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Ground Coverage Ratio", backtracker->getGroundCoverage() / 32768.0f, "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Day Clock Known", backtracker->isDayStarted(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Day Length", backtracker->getDayLength() / 60000UL, "min", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Day Length Measured", backtracker->isDayLengthMeasured(), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Sun Tilt", backtracker->getSunTilt( now ) / 1000.0f, "deg", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Shade-Free Tilt", backtracker->getTargetTilt( now ) / 1000.0f, "deg", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Overriding Balancing", backtracker->isActive( now ), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Backtracking Moves", (unsigned long)tracker->getBacktrackMoveCount(), "", 30);
+
+  TrackerCore* elevation = tracker->getElevation();
+  if( elevation != nullptr )
+  {
+    Serial.println(F("ELEVATION AXIS:"));
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Elevation State", getStateString( elevation->getState() ), 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Elevation Motor", getMotorStateString( tracker->getElevationMotor()->getState() ), 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Next Adjustment In", elevation->getTimeUntilNextAdjustment() / 1000UL, "s", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Motors At Once", (unsigned long)tracker->getMaxMotorsRunning(), "", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Azimuth Supply Waits", (unsigned long)tracker->getSupplyDeferredCount(), "", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Elevation Supply Waits", (unsigned long)elevation->getSupplyDeferredCount(), "", 30);
+  }
+
+  TrackerRows* rows = tracker->getRows();
+  if( rows != nullptr )
+  {
+    Serial.println(F("TRACKER ROWS:"));
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Rows", (unsigned long)TRACKER_ROW_COUNT, "", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Start Stagger", (unsigned long)TRACKER_ROW_START_STAGGER_MS, "ms", 30);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Staggered Row Starts", rows->getStaggerDeferredCount(), "", 30);
+    for( uint8_t row = 1; row <= TrackerRows::COUNT; row++ )
+    {
+      char label[24];
+      sprintf( label, "Row %u State", row );
+      Serial.print(F("  ")); // Add 2-space indent
+      printLeftAlignedName(label, rows->isRowEnabled( row ) ?
+                           TrackerRows::getRowStateName( rows->getRowState( row )) : "DISABLED", 30);
+    }
+  }
+
+  Serial.println();
+  Serial.println(F("STATE MACHINE:"));
+  for( uint8_t i = 0; i < Tracker::STATE_COUNT; i++ )
+  {
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName(getStateString( (Tracker::State)i ), tracker->getTimeInState( (Tracker::State)i ) / 1000UL, "s", 30);
+  }
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Transitions", (unsigned long)tracker->getTraceSequence(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Invalid Events", (unsigned long)tracker->getInvalidEventCount(), "", 30);
+
+  Serial.println();
+  Serial.println(F("STOP LATENCY:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Sensor-Driven Stops", (unsigned long)tracker->getStopLatencyCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Average Latency", tracker->getStopLatencyAverageUs(), "us", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Maximum Latency", tracker->getStopLatencyMaxUs(), "us", 30);
+  for( uint8_t i = 0; i < Tracker::STOP_LATENCY_BUCKETS; i++ )
+  {
+    char label[24];
+    if( i < Tracker::STOP_LATENCY_BUCKETS - 1 )
+    {
+      sprintf( label, "<= %lu us", Tracker::getStopLatencyBucketLimitUs( i ));
+    }
+    else
+    {
+      sprintf( label, "> %lu us", Tracker::getStopLatencyBucketLimitUs( i - 1 ));
+    }
+    Serial.print(F("    ")); // Add 4-space indent
+    printLeftAlignedName(label, (unsigned long)tracker->getStopLatencyBucketCount( i ), "", 28);
+  }
+
+  Serial.println();
+  Serial.println(F("STEP TIME:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Average Step Time", tracker->getStepTimeAverageUs(), "us", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Average Step Cycles",
+                       tracker->getStepTimeAverageUs() * clockCyclesPerMicrosecond(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Maximum Step Time", tracker->getStepTimeMaxUs(), "us", 30);
+}
+
+void Settings::handleTraceCommand()
+{
+  printHeader(TRACE_TITLE);
+
+  Serial.println(F("TRANSITION COUNTS:"));
+  for( uint8_t s = 0; s < Tracker::STATE_COUNT; s++ )
+  {
+    Serial.print(F("  From "));
+    Serial.print(getStateString( (Tracker::State)s ));
+    Serial.println(F(":"));
+    for( uint8_t i = 0; i < Tracker::TRANSITION_COUNT; i++ )
+    {
+      uint8_t from, event, to;
+      Tracker::getTransition( i, &from, &event, &to );
+      if( from != s )
+      {
+        continue;
+      }
+      char label[40];
+      strncpy_P( label, Tracker::getEventName( event ), sizeof( label ) - 1 );
+      label[sizeof( label ) - 1] = '\0';
+      Serial.print(F("    ")); // Add 4-space indent
+      printLeftAlignedName(label, (unsigned long)tracker->getTransitionCount( i ), "", 36);
+    }
+  }
+
+  Serial.println();
+  Serial.println(F("RECENT TRANSITIONS:"));
+  extern Terminal terminal;
+  uint16_t last = tracker->getTraceSequence();
+  uint16_t first = ( last > Tracker::TRACE_SIZE ) ? last - Tracker::TRACE_SIZE : 0;
+  if( first == last )
+  {
+    Serial.println(F("  None"));
+  }
+  for( uint16_t seq = first; seq != last; seq++ )
+  {
+    Tracker::TraceEntry entry;
+    if( tracker->getTraceEntry( seq, &entry ))
+    {
+      Serial.print(F("  ")); // Add 2-space indent
+      terminal.logTrackerStateChange( entry );
+    }
+  }
+}
+
+//***********************************************************
+//     Function Name: handleMovesCommand
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Shows the movement history window used for the default
+//       west movement and the per-direction duration and
+//       reversal histograms since boot.
+//
+//***********************************************************
+void Settings::handleMovesCommand()
+{
+  const MovementStats* stats = tracker->getMovementStats();
+  printHeader(MOVES_TITLE);
+
+  Serial.println(F("MOVEMENT HISTORY:"));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Movements In Window", (unsigned long)stats->getCount(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Window Size", (unsigned long)stats->getWindowSize(), "", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Average Mode", MovementStats::getAverageModeName( stats->getAverageMode() ), 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Average In Use", tracker->getAverageMovementTime(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Mean", stats->getMean(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Trimmed Mean", stats->getTrimmedMean(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Median", stats->getMedian(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Standard Deviation", stats->getStdDev(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Shortest", stats->getMin(), "ms", 30);
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Longest", stats->getMax(), "ms", 30);
+
+  char label[24];
+  char value[24];
+  Serial.println();
+  Serial.println(F("DURATIONS SINCE BOOT:"));
+  sprintf( value, "E %u  W %u", stats->getMoveCount( true ), stats->getMoveCount( false ));
+  Serial.print(F("  ")); // Add 2-space indent
+  printLeftAlignedName("Movements", value, 30);
+  for( uint8_t i = 0; i < MovementStats::DURATION_BUCKETS; i++ )
+  {
+    if( i < MovementStats::DURATION_BUCKETS - 1 )
+    {
+      sprintf( label, "<= %lu ms", MovementStats::getDurationBucketLimitMs( i ));
+    }
+    else
+    {
+      sprintf( label, "> %lu ms", MovementStats::getDurationBucketLimitMs( i - 1 ));
+    }
+    sprintf( value, "E %u  W %u", stats->getDurationBucketCount( true, i ),
+             stats->getDurationBucketCount( false, i ));
+    Serial.print(F("    ")); // Add 4-space indent
+    printLeftAlignedName(label, value, 28);
+  }
+
+  Serial.println();
+  Serial.println(F("REVERSALS PER MOVEMENT:"));
+  for( uint8_t i = 0; i < MovementStats::REVERSAL_BUCKETS; i++ )
+  {
+    if( i < MovementStats::REVERSAL_BUCKETS - 1 )
+    {
+      sprintf( label, "%u", i );
+    }
+    else
+    {
+      sprintf( label, "%u or more", i );
+    }
+    sprintf( value, "E %u  W %u", stats->getReversalBucketCount( true, i ),
+             stats->getReversalBucketCount( false, i ));
+    Serial.print(F("    ")); // Add 4-space indent
+    printLeftAlignedName(label, value, 28);
+  }
+}
+
+//***********************************************************
+//     Function Name: handleRowCommand
+//
+//     Inputs:
+//     - rowStr : Row index (empty = all rows)
+//     - valueStr : "on", "off", a tolerance percentage, or empty
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Lists every row, shows one row, or enables, disables or
+//       sets the tolerance of an extra row. Row 0 is the main
+//       tracker and is configured with the set command.
+//
+//***********************************************************
+void Settings::handleRowCommand( const char* rowStr, const char* valueStr )
+{
+  TrackerRows* rows = tracker->getRows();
+  uint8_t first = 0;
+  uint8_t last = ( rows != nullptr ) ? TrackerRows::COUNT : 0;
+
+  if( strlen( rowStr ) > 0 )
+  {
+    char* endPtr;
+    long row = strtol( rowStr, &endPtr, 10 );
+    if( *endPtr != '\0' || row < 0 || row > last )
+    {
+      Serial.println();
+      Serial.print(F("ERROR: Row must be 0 to "));
+      Serial.println( last );
+      return;
+    }
+    first = last = (uint8_t)row;
+
+    if( strlen( valueStr ) > 0 )
+    {
+      Serial.println();
+      bool ok = false;
+      if( row == 0 )
+      {
+        Serial.println(F("ERROR: Row 0 is the main tracker; use the set command"));
+        return;
+      }
+      if( strcmp( valueStr, "on" ) == 0 || strcmp( valueStr, "off" ) == 0 )
+      {
+        ok = rows->setRowEnabled( first, strcmp( valueStr, "on" ) == 0 );
+      }
+      else
+      {
+        long tolerance = strtol( valueStr, &endPtr, 10 );
+        ok = ( *endPtr == '\0' && tolerance >= 0 && tolerance <= 100 &&
+               rows->setRowTolerance( first, (uint8_t)tolerance ));
+      }
+      if( !ok )
+      {
+        Serial.print(F("ERROR: Invalid value '"));
+        Serial.print( valueStr );
+        Serial.println(F("' (on, off or tolerance 0-100)"));
+        return;
+      }
+    }
+  }
+
+  printHeader(ROWS_TITLE);
+  for( uint8_t row = first; row <= last; row++ )
+  {
+    char label[24];
+    char value[48];
+    if( row == 0 )
+    {
+      sprintf( label, "Row 0 (main)" );
+      sprintf( value, "%s, %s", getStateString( tracker->getState() ),
+               getMotorStateString( motorControl->getState() ));
+      printLeftAlignedName(label, value, 24);
+      Serial.print(F("  ")); // Add 2-space indent
+      sprintf( value, "E %ld W %ld ohms, tol %u%%", (long)( eastSensor->getFilteredValue() + 0.5f ),
+               (long)( westSensor->getFilteredValue() + 0.5f ), (unsigned)( tracker->getTolerance() + 0.5f ));
+      printLeftAlignedName("Sensors", value, 22);
+      continue;
+    }
+    sprintf( label, "Row %u", row );
+    sprintf( value, "%s, %s", rows->isRowEnabled( row ) ?
+             TrackerRows::getRowStateName( rows->getRowState( row )) : "DISABLED",
+             getMotorStateString( rows->getRowMotorState( row )));
+    printLeftAlignedName(label, value, 24);
+    Serial.print(F("  ")); // Add 2-space indent
+    sprintf( value, "E %lu W %lu ohms, tol %u%%", (unsigned long)rows->getRowEastValue( row ),
+             (unsigned long)rows->getRowWestValue( row ), rows->getRowTolerance( row ));
+    printLeftAlignedName("Sensors", value, 22);
+    Serial.print(F("  ")); // Add 2-space indent
+    printLeftAlignedName("Moves", (unsigned long)rows->getRowMoveCount( row ), "", 22);
+  }
 }
 
 const char* Settings::getStateString( Tracker::State state )
@@ -1290,6 +2359,10 @@ const char* Settings::getStateString( Tracker::State state )
     case Tracker::ADJUSTING: return "ADJUSTING";
     case Tracker::NIGHT_MODE: return "NIGHT_MODE";
     case Tracker::DEFAULT_WEST_MOVEMENT: return "DEFAULT_WEST_MOVEMENT";
+    case Tracker::SUN_SEARCH: return "SUN_SEARCH";
+    case Tracker::HILL_CLIMBING: return "HILL_CLIMBING";
+    case Tracker::BACKTRACKING: return "BACKTRACKING";
+    case Tracker::PLANNED_MOVE: return "PLANNED_MOVE";
     default: return "UNKNOWN";
   }
 }
@@ -1335,7 +2408,7 @@ void Settings::printParameterList()
   int maxNameLen = 0;
   for(int i = 0; i < parameterCount; i++)
   {
-    int nameLen = strlen(parameters[i].meta.name);
+    int nameLen = strlen_P(PARAMETER_TABLE[i].name);
     if(nameLen > maxNameLen)
     {
       maxNameLen = nameLen;
@@ -1370,7 +2443,11 @@ void Settings::printParameterList()
     "adjustment_period",
     "reversal_dead_time",
     "reversal_time_limit",
-    "max_reversal_tries"
+    "max_reversal_tries",
+    "kalman_filter",
+    "auto_tune",
+    "shading_map",
+    "stall_detect"
   };
   
   for(size_t i = 0; i < sizeof(trackerParams) / sizeof(trackerParams[0]); i++)
@@ -1388,7 +2465,8 @@ void Settings::printParameterList()
     "default_west_enabled",
     "default_west_time",
     "use_average_movement",
-    "movement_history_size"
+    "movement_history_size",
+    "movement_average"
   };
   
   for(size_t i = 0; i < sizeof(defaultWestParams) / sizeof(defaultWestParams[0]); i++)
@@ -1400,6 +2478,94 @@ void Settings::printParameterList()
     }
   }
   
+  Serial.println();
+  Serial.println(F("ADAPTIVE SCHEDULING PARAMETERS:"));
+  const char* scheduleParams[] = {
+    "adaptive_schedule",
+    "adj_period_min",
+    "adj_period_max"
+  };
+  
+  for(size_t i = 0; i < sizeof(scheduleParams) / sizeof(scheduleParams[0]); i++)
+  {
+    Parameter* param = findParameter(scheduleParams[i]);
+    if(param)
+    {
+      printParameterWithDescription(param);
+    }
+  }
+  
+  Serial.println();
+  Serial.println(F("CLOUD DETECTION PARAMETERS:"));
+  const char* cloudParams[] = {
+    "cloud_detect",
+    "cloud_threshold",
+    "cloud_holdoff"
+  };
+  
+  for(size_t i = 0; i < sizeof(cloudParams) / sizeof(cloudParams[0]); i++)
+  {
+    Parameter* param = findParameter(cloudParams[i]);
+    if(param)
+    {
+      printParameterWithDescription(param);
+    }
+  }
+  
+  Serial.println();
+  Serial.println(F("ENERGY-AWARE TRACKING PARAMETERS:"));
+  const char* energyParams[] = {
+    "energy_aware",
+    "panel_power",
+    "motor_power",
+    "deg_per_pct"
+  };
+  
+  for(size_t i = 0; i < sizeof(energyParams) / sizeof(energyParams[0]); i++)
+  {
+    Parameter* param = findParameter(energyParams[i]);
+    if(param)
+    {
+      printParameterWithDescription(param);
+    }
+  }
+  
+  Serial.println();
+  Serial.println(F("SUN SEARCH PARAMETERS:"));
+  const char* sunSearchParams[] = {
+    "sun_search",
+    "sun_search_steps",
+    "sun_search_timeout",
+    "sun_search_span"
+  };
+  
+  for(size_t i = 0; i < sizeof(sunSearchParams) / sizeof(sunSearchParams[0]); i++)
+  {
+    Parameter* param = findParameter(sunSearchParams[i]);
+    if(param)
+    {
+      printParameterWithDescription(param);
+    }
+  }
+  
+  Serial.println();
+  Serial.println(F("TRACKING STRATEGY PARAMETERS:"));
+  const char* strategyParams[] = {
+    "tracking_strategy",
+    "hc_step",
+    "hc_max_steps",
+    "hc_deadband"
+  };
+  
+  for(size_t i = 0; i < sizeof(strategyParams) / sizeof(strategyParams[0]); i++)
+  {
+    Parameter* param = findParameter(strategyParams[i]);
+    if(param)
+    {
+      printParameterWithDescription(param);
+    }
+  }
+  
   Serial.println();
   Serial.println(F("MONITOR MODE PARAMETERS:"));
   const char* monitorParams[] = {
@@ -1418,9 +2584,44 @@ void Settings::printParameterList()
     }
   }
   
+  Serial.println();
+  Serial.println(F("DUAL-AXIS PARAMETERS:"));
+  const char* dualAxisParams[] = {
+    "elev_tol",
+    "elev_period",
+    "elev_max_move",
+    "max_motors"
+  };
+  
+  for(size_t i = 0; i < sizeof(dualAxisParams) / sizeof(dualAxisParams[0]); i++)
+  {
+    Parameter* param = findParameter(dualAxisParams[i]);
+    if(param)
+    {
+      printParameterWithDescription(param);
+    }
+  }
+  
+  Serial.println();
+  Serial.println(F("BACKTRACKING PARAMETERS:"));
+  const char* backtrackParams[] = {
+    "backtracking",
+    "row_pitch",
+    "panel_width"
+  };
+  
+  for(size_t i = 0; i < sizeof(backtrackParams) / sizeof(backtrackParams[0]); i++)
+  {
+    Parameter* param = findParameter(backtrackParams[i]);
+    if(param)
+    {
+      printParameterWithDescription(param);
+    }
+  }
+  
   Serial.println();
   Serial.println(F("MOTOR PARAMETERS:"));
-  const char* motorParams[] = { "motor_dead_time" };
+  const char* motorParams[] = { "motor_dead_time", "start_limit", "start_burst", "start_rate", "backlash", "backlash_learn", "travel", "soft_limits", "soft_margin", "motor_pwm", "ramp_time", "approach_speed" };
   
   for(size_t i = 0; i < sizeof(motorParams) / sizeof(motorParams[0]); i++)
   {
@@ -1452,12 +2653,15 @@ void Settings::printParameterList()
 
 void Settings::printFormattedParameterWithDescription( Parameter* param, int maxNameLen )
 {
+  ParameterMetadata meta;
+  getParameterMetadata( param, &meta );
+  
   // Print parameter name
   Serial.print( "  " ); // Add 2-space indent
-  Serial.print( param->meta.name );
+  Serial.print( meta.name );
   
   // Add spacing to align short name column
-  int nameLen = strlen( param->meta.name );
+  int nameLen = strlen( meta.name );
   for( int i = nameLen; i < maxNameLen + 2; i++ )
   {
     Serial.print( " " );
@@ -1465,14 +2669,14 @@ void Settings::printFormattedParameterWithDescription( Parameter* param, int max
   
   // Print short name in parentheses
   Serial.print( "(" );
-  Serial.print( param->meta.shortName );
+  Serial.print( meta.shortName );
   Serial.print( ")" );
   
   // Get description for this parameter
-  const char* description = getParameterDescription( param->meta.name );
+  const char* description = getParameterDescription( meta.name );
   
   // Calculate spacing for description
-  int shortNameLen = strlen( param->meta.shortName ) + 2; // +2 for "()"
+  int shortNameLen = strlen( meta.shortName ) + 2; // +2 for "()"
   for( int i = shortNameLen; i < 8; i++ ) // Ensure at least 8 chars for short name column
   {
     Serial.print( " " );
@@ -1489,12 +2693,15 @@ void Settings::printFormattedParameterWithDescription( Parameter* param, int max
 
 void Settings::printFormattedParameterWithValue( Parameter* param, int maxNameLen )
 {
+  ParameterMetadata meta;
+  getParameterMetadata( param, &meta );
+  
   // Print parameter name
   Serial.print( "  " ); // Add 2-space indent
-  Serial.print( param->meta.name );
+  Serial.print( meta.name );
   
   // Add spacing to align short name column
-  int nameLen = strlen( param->meta.name );
+  int nameLen = strlen( meta.name );
   for( int i = nameLen; i < maxNameLen + 2; i++ )
   {
     Serial.print( " " );
@@ -1502,27 +2709,27 @@ void Settings::printFormattedParameterWithValue( Parameter* param, int maxNameLe
   
   // Print short name in parentheses
   Serial.print( "(" );
-  Serial.print( param->meta.shortName );
+  Serial.print( meta.shortName );
   Serial.print( ")" );
   
   // Calculate spacing for value
-  int shortNameLen = strlen( param->meta.shortName ) + 2; // +2 for "()"
+  int shortNameLen = strlen( meta.shortName ) + 2; // +2 for "()"
   for( int i = shortNameLen; i < 8; i++ ) // Ensure at least 8 chars for short name column
   {
     Serial.print( " " );
   }
   
   // Print value
-  if( strlen( param->meta.units ) == 0 && param->meta.maxValue == 1.0f && param->meta.minValue == 0.0f )
+  if( strlen( meta.units ) == 0 && meta.maxValue == 1.0f && meta.minValue == 0.0f )
   {
     Serial.print( param->currentValue != 0.0f ? F("true") : F("false") );
   }
-  else if( isParameterName( param->meta.name, "night_threshold" ) ||
-           isParameterName( param->meta.name, "brightness_threshold" ) )
+  else if( isParameterName( meta.name, "night_threshold" ) ||
+           isParameterName( meta.name, "brightness_threshold" ) )
   {
     Serial.print( (int32_t)param->currentValue );
   }
-  else if( param->meta.isInteger )
+  else if( meta.isInteger )
   {
     Serial.print( (int)param->currentValue );
   }
@@ -1532,10 +2739,10 @@ void Settings::printFormattedParameterWithValue( Parameter* param, int maxNameLe
   }
   
   // Print units
-  if( strlen( param->meta.units ) > 0 )
+  if( strlen( meta.units ) > 0 )
   {
     Serial.print( " " );
-    Serial.print( param->meta.units );
+    Serial.print( meta.units );
   }
   
   Serial.println();
@@ -1554,4 +2761,14 @@ Parameter* Settings::getParameter( int index )
 int Settings::getParameterCount() const
 {
   return parameterCount;
-} 
\ No newline at end of file
+}
+
+void Settings::getParameterMetadata( int index, ParameterMetadata* meta ) const
+{
+  memcpy_P( meta, &PARAMETER_TABLE[index], sizeof( ParameterMetadata ) );
+}
+
+void Settings::getParameterMetadata( const Parameter* param, ParameterMetadata* meta ) const
+{
+  getParameterMetadata( (int)( param - parameters ), meta );
+}
@@ -11,22 +11,23 @@
 // Forward declarations
 class Terminal;
 
-// Parameter metadata structure
+// Parameter metadata structure; the table lives in program memory, so the
+// strings are stored inline (see Settings::getParameterMetadata)
 struct ParameterMetadata {
-  const char* name;
-  const char* shortName;
-  const char* units;
+  char name[25];
+  char shortName[5];
+  char units[5];
   float minValue;
   float maxValue;
+  float defaultValue;
   bool isInteger;
   bool isTime;
   bool isPercent;
   bool isResistance;
 };
 
-// Parameter structure
+// Parameter structure; its metadata is the table entry at the same index
 struct Parameter {
-  ParameterMetadata meta;
   float currentValue;
 };
 
@@ -42,16 +43,22 @@ public:
   void handleSetCommand( const char* paramName, const char* valueStr );
   void handleHelpCommand();
   void handleFactoryResetCommand();
+  void handleTraceCommand();
+  void handleRowCommand( const char* rowStr, const char* valueStr );
+  void handleMovesCommand();
   
   // Parameter access
   Parameter* getParameter( int index );
   int getParameterCount() const;
+  void getParameterMetadata( int index, ParameterMetadata* meta ) const;
+  int findParameterIndex( const char* name, bool shortNameOnly = false ) const;
+  
+  static const int MAX_PARAMETERS = 66;
   
   // Make updateModuleValues public for Eeprom class
   void updateModuleValues();
   
 private:
-  static const int MAX_PARAMETERS = 32;
   Parameter parameters[MAX_PARAMETERS];
   int parameterCount;
   bool shortNameOnly;  // Added to control parameter name lookup behavior
@@ -70,6 +77,7 @@ private:
   float getCurrentParameterValue( const char* name );
   bool isParameterName( const char* name1, const char* name2 );
   Parameter* findParameter( const char* name );
+  void getParameterMetadata( const Parameter* param, ParameterMetadata* meta ) const;
   bool validateTimeValue( float value );
   bool validatePercentageValue( float value );
   bool validateResistanceValue( float value );
@@ -0,0 +1,227 @@
+#include "ShadingMap.h"
+#include <math.h>
+#include <string.h>
+
+//***********************************************************
+//     Constructor: ShadingMap
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Initializes an empty map. No time of day is known until
+//       the first night to day transition.
+//
+//***********************************************************
+ShadingMap::ShadingMap()
+  : dayStarted(false),
+    dawnTime(0),
+    baselineValid(false),
+    eastBaseline(0.0f),
+    westBaseline(0.0f),
+    lastSampleTime(0),
+    anomalyActive(false),
+    anomalyEast(false),
+    anomalyStartTime(0),
+    anomalyCount(0)
+{
+  memset( scores, 0, sizeof( scores ));
+  memset( observed, 0, sizeof( observed ));
+}
+
+void ShadingMap::clear()
+{
+  memset( scores, 0, sizeof( scores ));
+  memset( observed, 0, sizeof( observed ));
+}
+
+//***********************************************************
+//     Function Name: startDay
+//
+//     Inputs:
+//     - currentTime : Time of the night to day transition (ms)
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Starts the time-of-day clock and today's observations.
+//
+//***********************************************************
+void ShadingMap::startDay( unsigned long currentTime )
+{
+  dayStarted = true;
+  dawnTime = currentTime;
+  baselineValid = false;
+  anomalyActive = false;
+  anomalyCount = 0;
+  memset( observed, 0, sizeof( observed ));
+}
+
+//***********************************************************
+//     Function Name: endDay
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - True if any slot score changed
+//
+//     Description:
+//     - Folds today's observations into the slot scores. Slots
+//       shaded today gain SHADING_SCORE_HIT; others decay, so a
+//       slot needs about two shaded days to predict shading and
+//       fades out as the obstruction's timing drifts with the
+//       season.
+//
+//***********************************************************
+bool ShadingMap::endDay()
+{
+  if( !dayStarted )
+  {
+    return false;  // Started mid-day; times are unknown
+  }
+
+  bool changed = false;
+  for( uint8_t i = 0; i < SHADING_SLOTS; i++ )
+  {
+    uint8_t previous = scores[i];
+    if( observed[i / 8] & ( 1 << ( i % 8 )))
+    {
+      scores[i] = ( scores[i] > 255 - SHADING_SCORE_HIT ) ? 255 : scores[i] + SHADING_SCORE_HIT;
+    }
+    else
+    {
+      scores[i] -= ( scores[i] >> SHADING_SCORE_DECAY_SHIFT );
+    }
+    if( scores[i] != previous ) changed = true;
+  }
+
+  dayStarted = false;
+  anomalyActive = false;
+  return changed;
+}
+
+//***********************************************************
+//     Function Name: addSample
+//
+//     Inputs:
+//     - eastValue : Filtered east sensor resistance in ohms
+//     - westValue : Filtered west sensor resistance in ohms
+//     - stationary : True when the panel is not moving
+//     - currentTime : Current time (ms)
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Tracks a slow baseline per sensor. An anomaly starts when
+//       one sensor darkens by SHADING_DROP_PERCENT while the other
+//       stays within SHADING_STABLE_PERCENT of its baseline, and is
+//       recorded as shading if the shaded sensor recovers between
+//       the minimum and maximum durations.
+//
+//***********************************************************
+void ShadingMap::addSample( float eastValue, float westValue, bool stationary, unsigned long currentTime )
+{
+  if( !dayStarted || eastValue <= 0.0f || westValue <= 0.0f )
+  {
+    return;
+  }
+  if( !stationary )
+  {
+    // Panel movement changes both sensors; restart detection
+    baselineValid = false;
+    anomalyActive = false;
+    return;
+  }
+  if( !baselineValid )
+  {
+    eastBaseline = eastValue;
+    westBaseline = westValue;
+    lastSampleTime = currentTime;
+    baselineValid = true;
+    return;
+  }
+
+  float eastChange = (( eastValue - eastBaseline ) / eastBaseline ) * 100.0f;
+  float westChange = (( westValue - westBaseline ) / westBaseline ) * 100.0f;
+
+  if( anomalyActive )
+  {
+    unsigned long duration = currentTime - anomalyStartTime;
+    float shadedChange = anomalyEast ? eastChange : westChange;
+    if( shadedChange <= SHADING_RECOVER_PERCENT )
+    {
+      if( duration >= SHADING_MIN_DURATION_SECONDS * 1000UL )
+      {
+        markObserved( anomalyStartTime, currentTime );
+        if( anomalyCount < UINT16_MAX ) anomalyCount++;
+      }
+      anomalyActive = false;
+      lastSampleTime = currentTime;
+    }
+    else if( duration > SHADING_MAX_DURATION_MINUTES * 60000UL )
+    {
+      // Did not reverse: a real change in conditions, adopt the new levels
+      anomalyActive = false;
+      baselineValid = false;
+    }
+    return;  // Baselines are frozen while an anomaly is in progress
+  }
+
+  bool eastShaded = ( eastChange >= SHADING_DROP_PERCENT && fabs( westChange ) <= SHADING_STABLE_PERCENT );
+  bool westShaded = ( westChange >= SHADING_DROP_PERCENT && fabs( eastChange ) <= SHADING_STABLE_PERCENT );
+  if( eastShaded || westShaded )
+  {
+    anomalyActive = true;
+    anomalyEast = eastShaded;
+    anomalyStartTime = currentTime;
+    return;
+  }
+
+  float dt = ( currentTime - lastSampleTime ) / 1000.0f;
+  lastSampleTime = currentTime;
+  float alpha = dt / SHADING_BASELINE_TAU_S;
+  if( alpha > 1.0f ) alpha = 1.0f;
+  eastBaseline += alpha * ( eastValue - eastBaseline );
+  westBaseline += alpha * ( westValue - westBaseline );
+}
+
+bool ShadingMap::isShadingPredicted( unsigned long currentTime ) const
+{
+  int16_t slot = getSlot( currentTime );
+  return ( slot >= 0 && scores[slot] >= SHADING_SCORE_THRESHOLD );
+}
+
+uint8_t ShadingMap::getPredictedSlotCount() const
+{
+  uint8_t count = 0;
+  for( uint8_t i = 0; i < SHADING_SLOTS; i++ )
+  {
+    if( scores[i] >= SHADING_SCORE_THRESHOLD ) count++;
+  }
+  return count;
+}
+
+int16_t ShadingMap::getSlot( unsigned long currentTime ) const
+{
+  if( !dayStarted )
+  {
+    return -1;
+  }
+  unsigned long slot = ( currentTime - dawnTime ) / ( SHADING_SLOT_MINUTES * 60000UL );
+  return ( slot < SHADING_SLOTS ) ? (int16_t)slot : -1;
+}
+
+void ShadingMap::markObserved( unsigned long startTime, unsigned long endTime )
+{
+  int16_t first = getSlot( startTime );
+  int16_t last = getSlot( endTime );
+  if( first < 0 ) return;
+  if( last < 0 ) last = SHADING_SLOTS - 1;
+  for( int16_t i = first; i <= last; i++ )
+  {
+    observed[i / 8] |= ( 1 << ( i % 8 ));
+  }
+}
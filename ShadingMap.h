@@ -0,0 +1,52 @@
+#ifndef SHADING_MAP_H
+#define SHADING_MAP_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+class ShadingMap {
+public:
+  ShadingMap();
+  void clear();   // Forget all learned shading
+
+  // Slot scores, for storing and restoring the map
+  uint8_t* getScores() { return scores; }
+  const uint8_t* getScores() const { return scores; }
+
+  // Day boundaries; the map is indexed by time since startDay()
+  void startDay( unsigned long currentTime );
+  bool endDay();  // Returns true if the scores changed and should be stored
+
+  // Feed one east/west sample pair (filtered ohms); only stationary samples are used
+  void addSample( float eastValue, float westValue, bool stationary, unsigned long currentTime );
+
+  // Status
+  bool isAnomalyActive() const { return anomalyActive; }
+  bool isShadingPredicted( unsigned long currentTime ) const;
+  bool isDayStarted() const { return dayStarted; }
+  uint8_t getPredictedSlotCount() const;
+  uint16_t getAnomalyCount() const { return anomalyCount; }
+
+private:
+  uint8_t scores[SHADING_SLOTS];            // Confidence that each slot is shaded
+  uint8_t observed[( SHADING_SLOTS + 7 ) / 8]; // Slots shaded today
+  bool dayStarted;
+  unsigned long dawnTime;
+
+  // Per-sensor baselines for one-sided drop detection
+  bool baselineValid;
+  float eastBaseline;
+  float westBaseline;
+  unsigned long lastSampleTime;
+
+  // Anomaly in progress
+  bool anomalyActive;
+  bool anomalyEast;                 // Shaded side
+  unsigned long anomalyStartTime;
+  uint16_t anomalyCount;            // Completed anomalies recorded today
+
+  int16_t getSlot( unsigned long currentTime ) const;
+  void markObserved( unsigned long startTime, unsigned long endTime );
+};
+
+#endif // SHADING_MAP_H
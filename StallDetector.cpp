@@ -0,0 +1,134 @@
+#include "StallDetector.h"
+#include <math.h>
+
+//***********************************************************
+//     Constructor: StallDetector
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Initializes the detector with the default from
+//       param_config.h and no learned timing.
+//
+//***********************************************************
+StallDetector::StallDetector()
+  : enabled(TRACKER_STALL_DETECT_ENABLED)
+{
+  reset();
+}
+
+void StallDetector::reset()
+{
+  watching = false;
+  responded = false;
+  watchedMoveStart = 0;
+  baselinePercent = 0.0f;
+  progressPercent = 0.0f;
+  lastProgressTime = 0;
+  responseValid = false;
+  responseMs = 0.0f;
+  stepValid = false;
+  stepMs = 0.0f;
+}
+
+//***********************************************************
+//     Function Name: addSample
+//
+//     Inputs:
+//     - imbalancePercent : East/west imbalance of this sample pair
+//     - moveStartTime : Start time of the running move
+//     - takeUpMs : Backlash take-up time of the running move
+//     - currentTime : Time of the sample pair
+//
+//     Returns:
+//     - bool : True if the panel has stopped responding
+//
+//     Description:
+//     - A new move first waits for the imbalance to change by the
+//       response threshold; the time it takes is learned, and no
+//       response within the response window is a stall. After
+//       that each change of TRACKER_STALL_STEP_PERCENT is a
+//       progress step; the time per step is learned, and no step
+//       within the progress window is a stall.
+//
+//***********************************************************
+bool StallDetector::addSample( float imbalancePercent, unsigned long moveStartTime, unsigned long takeUpMs,
+                               unsigned long currentTime )
+{
+  if( !enabled )
+  {
+    return false;
+  }
+
+  if( !watching || moveStartTime != watchedMoveStart )
+  {
+    watching = true;
+    responded = false;
+    watchedMoveStart = moveStartTime;
+    baselinePercent = imbalancePercent;
+    progressPercent = imbalancePercent;
+    lastProgressTime = currentTime;
+    return false;
+  }
+
+  if( !responded )
+  {
+    unsigned long elapsedMs = currentTime - watchedMoveStart;
+    if( fabs( imbalancePercent - baselinePercent ) >= MOTOR_BACKLASH_RESPONSE_PERCENT )
+    {
+      float latencyMs = ( elapsedMs > takeUpMs ) ? (float)( elapsedMs - takeUpMs ) : 0.0f;
+      responseMs = responseValid ? responseMs + TRACKER_STALL_LEARN_WEIGHT * ( latencyMs - responseMs ) : latencyMs;
+      responseValid = true;
+      responded = true;
+      progressPercent = imbalancePercent;
+      lastProgressTime = currentTime;
+      return false;
+    }
+    return ( elapsedMs >= takeUpMs + getResponseWindow() );
+  }
+
+  float change = fabs( imbalancePercent - progressPercent );
+  if( change >= TRACKER_STALL_STEP_PERCENT )
+  {
+    // Normalize to one step; a sample can cover several
+    float perStepMs = ( currentTime - lastProgressTime ) * TRACKER_STALL_STEP_PERCENT / change;
+    stepMs = stepValid ? stepMs + TRACKER_STALL_LEARN_WEIGHT * ( perStepMs - stepMs ) : perStepMs;
+    stepValid = true;
+    progressPercent = imbalancePercent;
+    lastProgressTime = currentTime;
+    return false;
+  }
+  return ( currentTime - lastProgressTime >= getProgressWindow() );
+}
+
+unsigned long StallDetector::getResponseWindow() const
+{
+  if( !responseValid )
+  {
+    return TRACKER_STALL_DEFAULT_WINDOW_MS;
+  }
+  return clampWindow( responseMs * TRACKER_STALL_WINDOW_FACTOR );
+}
+
+unsigned long StallDetector::getProgressWindow() const
+{
+  if( !stepValid )
+  {
+    return getResponseWindow();
+  }
+  return clampWindow( stepMs * TRACKER_STALL_WINDOW_FACTOR );
+}
+
+unsigned long StallDetector::clampWindow( float windowMs )
+{
+  if( windowMs < TRACKER_STALL_MIN_WINDOW_MS )
+  {
+    return TRACKER_STALL_MIN_WINDOW_MS;
+  }
+  if( windowMs > TRACKER_STALL_MAX_WINDOW_MS )
+  {
+    return TRACKER_STALL_MAX_WINDOW_MS;
+  }
+  return (unsigned long)windowMs;
+}
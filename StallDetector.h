@@ -0,0 +1,52 @@
+#ifndef STALL_DETECTOR_H
+#define STALL_DETECTOR_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+// Watches the east/west imbalance while the motor runs and reports a stall
+// when it stops changing: no response within the learned response window
+// after the start, or no progress step within the learned step window.
+class StallDetector {
+public:
+  StallDetector();
+  void reset();   // Forget learned timing
+
+  // Feed one sample pair while the motor runs. moveStartTime identifies the
+  // move and takeUpMs is its backlash take-up. Returns true on a stall.
+  bool addSample( float imbalancePercent, unsigned long moveStartTime, unsigned long takeUpMs,
+                  unsigned long currentTime );
+  void stopWatching() { watching = false; }  // Motor stopped
+
+  // Time the motor ran since the panel last made progress
+  unsigned long getOverrunMs( unsigned long currentTime ) const { return currentTime - lastProgressTime; }
+
+  // Configuration
+  void setEnabled( bool enabled ) { this->enabled = enabled; }
+  bool getEnabled() const { return enabled; }
+
+  // Learned windows
+  unsigned long getResponseWindow() const;
+  unsigned long getProgressWindow() const;
+
+private:
+  bool enabled;
+
+  // Move being watched
+  bool watching;
+  bool responded;                   // Imbalance has moved since the start
+  unsigned long watchedMoveStart;
+  float baselinePercent;            // Imbalance at the start
+  float progressPercent;            // Imbalance at the last progress step
+  unsigned long lastProgressTime;
+
+  // Learned timing
+  bool responseValid;
+  float responseMs;                 // Start (after take-up) to first response
+  bool stepValid;
+  float stepMs;                     // Time per progress step while moving
+
+  static unsigned long clampWindow( float windowMs );
+};
+
+#endif // STALL_DETECTOR_H
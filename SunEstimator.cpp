@@ -0,0 +1,133 @@
+#include "SunEstimator.h"
+#include <math.h>
+
+//***********************************************************
+//     Constructor: SunEstimator
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Creates an uninitialized estimator. The first measurement
+//       passed to correct() initializes the angle state.
+//
+//***********************************************************
+SunEstimator::SunEstimator()
+{
+  reset();
+}
+
+//***********************************************************
+//     Function Name: reset
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Clears the state and marks the estimator uninitialized.
+//
+//***********************************************************
+void SunEstimator::reset()
+{
+  initialized = false;
+  angle = 0.0f;
+  rate = 0.0f;
+  p00 = 0.0f;
+  p01 = 0.0f;
+  p11 = 0.0f;
+}
+
+//***********************************************************
+//     Function Name: predict
+//
+//     Inputs:
+//     - dtS : Time since the previous prediction in seconds
+//     - motorPercent : Known angle change from motor motion
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Time update with F = [1 dt; 0 1]. The covariance is kept
+//       as three scalars and expanded by hand so each step costs a
+//       handful of float multiplies on the AVR.
+//
+//***********************************************************
+void SunEstimator::predict( float dtS, float motorPercent )
+{
+  if( !initialized || dtS <= 0.0f )
+  {
+    return;
+  }
+
+  angle += ( rate * dtS ) + motorPercent;
+
+  // P = F P F' + Q
+  float dtP11 = dtS * p11;
+  p00 += ( dtS * ( 2.0f * p01 + dtP11 )) + ( TRACKER_KALMAN_ANGLE_NOISE * dtS );
+  p01 += dtP11;
+  p11 += ( TRACKER_KALMAN_RATE_NOISE * dtS );
+}
+
+//***********************************************************
+//     Function Name: correct
+//
+//     Inputs:
+//     - measuredPercent : Measured sensor imbalance in percent
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Measurement update with H = [1 0]. Initializes the
+//       filter from the first measurement.
+//
+//***********************************************************
+void SunEstimator::correct( float measuredPercent )
+{
+  if( !initialized )
+  {
+    angle = measuredPercent;
+    rate = 0.0f;
+    p00 = TRACKER_KALMAN_MEASUREMENT_NOISE;
+    p01 = 0.0f;
+    p11 = TRACKER_KALMAN_INITIAL_RATE_VARIANCE;
+    initialized = true;
+    return;
+  }
+
+  float s = p00 + TRACKER_KALMAN_MEASUREMENT_NOISE;
+  float k0 = p00 / s;
+  float k1 = p01 / s;
+  float innovation = measuredPercent - angle;
+
+  angle += k0 * innovation;
+  rate += k1 * innovation;
+
+  // P = (I - K H) P
+  p11 -= k1 * p01;
+  p01 -= k0 * p01;
+  p00 -= k0 * p00;
+}
+
+//***********************************************************
+//     Function Name: getUncertainty
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - float : One standard deviation of the angle estimate in
+//               percent of imbalance
+//
+//     Description:
+//     - Confidence measure used to gate adjust/stop decisions.
+//
+//***********************************************************
+float SunEstimator::getUncertainty() const
+{
+  return sqrt( p00 );
+}
@@ -0,0 +1,38 @@
+#ifndef SUN_ESTIMATOR_H
+#define SUN_ESTIMATOR_H
+
+#include <Arduino.h>
+#include "param_config.h"
+
+// Two-state Kalman filter tracking the sun angle relative to the panel
+// (in percent of sensor imbalance, positive = sun west of the panel) and
+// its drift rate. Motor motion enters as a known control input.
+class SunEstimator {
+public:
+  SunEstimator();
+  void reset();
+
+  // Advance the model by dtS seconds; motorPercent is the angle change
+  // caused by the motor over that interval (negative while moving west)
+  void predict( float dtS, float motorPercent );
+
+  // Fuse one measured imbalance (percent, (east - west) / lower * 100)
+  void correct( float measuredPercent );
+
+  bool isInitialized() const { return initialized; }
+  float getAngle() const { return angle; }
+  float getRate() const { return rate; }
+  float getUncertainty() const;
+
+private:
+  bool initialized;
+  float angle;                      // Estimated imbalance in percent
+  float rate;                       // Estimated drift in percent per second
+
+  // Symmetric covariance matrix [p00 p01; p01 p11]
+  float p00;
+  float p01;
+  float p11;
+};
+
+#endif // SUN_ESTIMATOR_H
@@ -10,6 +10,9 @@ static const char CMD_STATUS_P[] PROGMEM = CMD_STATUS;
 static const char CMD_SET_P[] PROGMEM = CMD_SET;
 static const char CMD_HELP_P[] PROGMEM = CMD_HELP;
 static const char CMD_FACTORY_RESET_P[] PROGMEM = CMD_FACTORY_RESET;
+static const char CMD_TRACE_P[] PROGMEM = CMD_TRACE;
+static const char CMD_ROW_P[] PROGMEM = CMD_ROW;
+static const char CMD_MOVES_P[] PROGMEM = CMD_MOVES;
 
 Terminal::Terminal()
     : printPeriodMs(TERMINAL_PRINT_PERIOD_MS),
@@ -17,7 +20,8 @@ Terminal::Terminal()
       lastPrintTime(0),
       enablePeriodicLogs(TERMINAL_ENABLE_PERIODIC_LOGS),
       logOnlyWhileMoving(TERMINAL_LOG_ONLY_WHILE_MOVING),
-      lastTrackerState(Tracker::IDLE),
+      lastTraceSequence(0),
+      lastElevationTraceSequence(0),
       lastMotorState(MotorControl::STOPPED),
       lastBalanced(false),
       settings(nullptr),
@@ -203,6 +207,18 @@ void Terminal::processCommand( const char* command )
   {
     settings->handleFactoryResetCommand();
   }
+  else if( strcmp_P( cmd, CMD_TRACE_P ) == 0 )
+  {
+    settings->handleTraceCommand();
+  }
+  else if( strcmp_P( cmd, CMD_ROW_P ) == 0 )
+  {
+    settings->handleRowCommand( param1, param2 );
+  }
+  else if( strcmp_P( cmd, CMD_MOVES_P ) == 0 )
+  {
+    settings->handleMovesCommand();
+  }
   else
   {
     Serial.println();
@@ -218,46 +234,12 @@ void Terminal::update(Tracker* tracker, MotorControl* motorControl, PhotoSensor*
     processSerialInput();
     
     unsigned long currentTime = millis();
-    // Check for tracker state changes
+    // Log every tracker transition from the trace, including ones between updates
     Tracker::State currentTrackerState = tracker->getState();
-    if( currentTrackerState != lastTrackerState )
+    bool adjustmentStarted = logTrace( tracker, &lastTraceSequence, "TRACKER" );
+    if( tracker->getElevation() != nullptr )
     {
-        const char* reason = "";
-        switch (currentTrackerState)
-        {
-            case Tracker::IDLE:
-                if( lastTrackerState == Tracker::ADJUSTING )
-                {
-                    reason = "Sensors balanced or timeout reached";
-                }
-                else if( lastTrackerState == Tracker::NIGHT_MODE )
-                {
-                    reason = "Day mode entered";
-                }
-                else if( lastTrackerState == Tracker::DEFAULT_WEST_MOVEMENT )
-                {
-                    reason = "Default movement completed";
-                }
-                break;
-            case Tracker::ADJUSTING:
-                if( lastTrackerState == Tracker::IDLE )
-                {
-                    reason = "Adjustment period started";
-                }
-                else if( lastTrackerState == Tracker::NIGHT_MODE )
-                {
-                    reason = "Day mode entered, starting adjustment";
-                }
-                break;
-            case Tracker::NIGHT_MODE:
-                reason = "Night mode entered";
-                break;
-            case Tracker::DEFAULT_WEST_MOVEMENT:
-                reason = "Low light, using default movement";
-                break;
-        }
-        logTrackerStateChange(lastTrackerState, currentTrackerState, reason);
-        lastTrackerState = currentTrackerState;
+        logTrace( tracker->getElevation(), &lastElevationTraceSequence, "ELEVATION" );
     }
     // Check for motor state changes
     MotorControl::State currentMotorState = motorControl->getState();
@@ -288,7 +270,7 @@ void Terminal::update(Tracker* tracker, MotorControl* motorControl, PhotoSensor*
         }
 
         // Always print when starting adjustment
-        if( currentTrackerState == Tracker::ADJUSTING && lastTrackerState != Tracker::ADJUSTING )
+        if( adjustmentStarted )
         {
             shouldPrint = true;
         }
@@ -335,40 +317,83 @@ void Terminal::setMovingPrintPeriod(unsigned long printPeriodMs)
     movingPrintPeriodMs = printPeriodMs;
 }
 
-void Terminal::logTrackerStateChange(Tracker::State oldState, Tracker::State newState, const char* reason)
+void Terminal::printTrackerStateName( uint8_t state )
 {
-    unsigned long currentTime = millis();
-    unsigned long seconds = currentTime / 1000;
-    unsigned long minutes = seconds / 60;
-    seconds %= 60;
-    Serial.print("[");
-    Serial.print(minutes);
-    Serial.print(":");
-    if( seconds < 10 ) Serial.print("0");
-    Serial.print(seconds);
-    Serial.print("] TRACKER: ");
-    switch (oldState)
+    switch (state)
     {
         case Tracker::IDLE: Serial.print("IDLE       "); break;
         case Tracker::ADJUSTING: Serial.print("ADJUSTING  "); break;
         case Tracker::NIGHT_MODE: Serial.print("NIGHT_MODE "); break;
         case Tracker::DEFAULT_WEST_MOVEMENT: Serial.print("DEF_WEST  "); break;
+        case Tracker::SUN_SEARCH: Serial.print("SUN_SEARCH "); break;
+        case Tracker::HILL_CLIMBING: Serial.print("HILL_CLIMB "); break;
+        case Tracker::BACKTRACKING: Serial.print("BACKTRACK  "); break;
+        case Tracker::PLANNED_MOVE: Serial.print("PLANNED    "); break;
     }
-    Serial.print(" -> ");
-    switch (newState)
+}
+
+// Logs trace entries not yet printed; returns true if an adjustment started
+bool Terminal::logTrace( const TrackerCore* core, uint16_t* lastSequence, const char* axis )
+{
+    bool adjustmentStarted = false;
+    uint16_t traceSequence = core->getTraceSequence();
+    if( (uint16_t)( traceSequence - *lastSequence ) > Tracker::TRACE_SIZE )
     {
-        case Tracker::IDLE: Serial.print("IDLE       "); break;
-        case Tracker::ADJUSTING: Serial.print("ADJUSTING  "); break;
-        case Tracker::NIGHT_MODE: Serial.print("NIGHT_MODE "); break;
-        case Tracker::DEFAULT_WEST_MOVEMENT: Serial.print("DEF_WEST  "); break;
+        *lastSequence = traceSequence - Tracker::TRACE_SIZE;  // Older entries were overwritten
     }
-    if( strlen(reason) > 0 )
+    while( *lastSequence != traceSequence )
     {
-        Serial.print(" (");
-        Serial.print(reason);
-        Serial.print(")");
+        Tracker::TraceEntry entry;
+        if( core->getTraceEntry( *lastSequence, &entry ) )
+        {
+            logTrackerStateChange( entry, axis );
+            if( entry.to == Tracker::ADJUSTING )
+            {
+                adjustmentStarted = true;
+            }
+        }
+        (*lastSequence)++;
     }
-    Serial.println();
+    return adjustmentStarted;
+}
+
+void Terminal::logTrackerStateChange( const Tracker::TraceEntry& entry, const char* axis )
+{
+    unsigned long seconds = entry.time / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] ");
+    Serial.print(axis);
+    Serial.print(": ");
+    printTrackerStateName( entry.from );
+    Serial.print(" -> ");
+    printTrackerStateName( entry.to );
+    Serial.print(" (");
+    Serial.print( (const __FlashStringHelper*)Tracker::getEventName( entry.event ) );
+    Serial.println(")");
+}
+
+void Terminal::logInvalidTrackerEvent( uint8_t state, uint8_t event )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: ERROR - no transition from ");
+    printTrackerStateName( state );
+    Serial.print(" on '");
+    Serial.print( (const __FlashStringHelper*)Tracker::getEventName( event ) );
+    Serial.println("'");
 }
 
 void Terminal::logMotorStateChange(MotorControl::State oldState, MotorControl::State newState)
@@ -630,4 +655,256 @@ void Terminal::logSuccessfulMovement( unsigned long duration, bool movingEast )
     Serial.print(" Duration=");
     Serial.print(duration);
     Serial.println(" ms");
-} 
\ No newline at end of file
+}
+
+void Terminal::logAdjustmentDeferredCloud( float brightnessVariation, float differenceDeviation )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: Adjustment deferred - unstable light. BrightVar=");
+    Serial.print(brightnessVariation);
+    Serial.print("% DiffDev=");
+    Serial.print(differenceDeviation);
+    Serial.println("%");
+}
+
+void Terminal::logAdjustmentSkippedUnprofitable( float expectedGainMwh, float expectedCostMwh )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: Adjustment skipped - not worth the motor energy. Gain=");
+    Serial.print(expectedGainMwh);
+    Serial.print("mWh Cost=");
+    Serial.print(expectedCostMwh);
+    Serial.println("mWh");
+}
+
+void Terminal::logSunSearchStarted( unsigned long spanMs, uint8_t maxProbes )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: Sun search started. Span=");
+    Serial.print(spanMs);
+    Serial.print(" ms MaxProbes=");
+    Serial.println(maxProbes);
+}
+
+void Terminal::logSunSearchProbe( uint8_t probe, unsigned long positionMs, float totalOhms )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: Sun search probe ");
+    Serial.print(probe);
+    Serial.print(" Position=");
+    Serial.print(positionMs);
+    Serial.print(" ms E+W=");
+    printPaddedNumber(totalOhms);
+    Serial.println(" ohms");
+}
+
+void Terminal::logSunSearchCompleted( unsigned long positionMs, float totalOhms, uint8_t probes, bool timedOut )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print(timedOut ? "] TRACKER: Sun search timed out. Position=" :
+                            "] TRACKER: Sun search completed. Position=");
+    Serial.print(positionMs);
+    Serial.print(" ms Best E+W=");
+    printPaddedNumber(totalOhms);
+    Serial.print(" ohms Probes=");
+    Serial.println(probes);
+}
+
+void Terminal::logHillClimbCompleted( uint8_t steps, float startPowerW, float finalPowerW, bool movingWest )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: Hill climb completed. Direction=");
+    Serial.print(movingWest ? "WEST" : "EAST");
+    Serial.print(" Steps=");
+    Serial.print(steps);
+    Serial.print(" Power=");
+    Serial.print(startPowerW);
+    Serial.print("W -> ");
+    Serial.print(finalPowerW);
+    Serial.println("W");
+}
+
+void Terminal::logAdjustmentDeferredStartLimit( uint16_t refillPerHour )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: Adjustment deferred - motor start limit reached. Refill=");
+    Serial.print(refillPerHour);
+    Serial.println("/h");
+}
+
+void Terminal::logAdjustmentEndedStartLimit()
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.println("] TRACKER: Adjustment ended - motor start limit reached");
+}
+
+void Terminal::logAutoTuneChange( const char* name, float oldValue, float newValue )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: Auto-tune ");
+    Serial.print(name);
+    Serial.print(" ");
+    Serial.print(oldValue);
+    Serial.print(" -> ");
+    Serial.println(newValue);
+}
+
+void Terminal::logAdjustmentDeferredShading( bool predicted )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.println(predicted ? "] TRACKER: Adjustment deferred - shading predicted by map" :
+                               "] TRACKER: Adjustment deferred - one-sided shading in progress");
+}
+
+void Terminal::logMotorStall( bool endStop, bool movingEast, unsigned long overrunMs )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print(endStop ? "] TRACKER: Motor stalled - end stop reached. Direction=" :
+                           "] TRACKER: Motor stalled - jam. Direction=");
+    Serial.print(movingEast ? "EAST" : "WEST");
+    Serial.print(" Overrun=");
+    Serial.print(overrunMs);
+    Serial.println("ms");
+}
+
+void Terminal::logBacktrackStarted( int32_t tiltMdeg, int32_t targetMdeg )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    Serial.print("] TRACKER: Backtracking to avoid row shading. Tilt=");
+    Serial.print(tiltMdeg / 1000.0f, 1);
+    Serial.print("deg Target=");
+    Serial.print(targetMdeg / 1000.0f, 1);
+    Serial.println("deg");
+}
+
+void Terminal::logMovePlanned( uint8_t delaySteps, bool movingWest, unsigned long durationMs,
+                               float costMwh, float idleCostMwh )
+{
+    unsigned long currentTime = millis();
+    unsigned long seconds = currentTime / 1000;
+    unsigned long minutes = seconds / 60;
+    seconds %= 60;
+    Serial.print("[");
+    Serial.print(minutes);
+    Serial.print(":");
+    if( seconds < 10 ) Serial.print("0");
+    Serial.print(seconds);
+    if( delaySteps == 0 )
+    {
+        Serial.print("] TRACKER: Plan - move ");
+        Serial.print(movingWest ? "WEST " : "EAST ");
+        Serial.print(durationMs);
+        Serial.print("ms now");
+    }
+    else if( delaySteps < MotionPlanner::HORIZON_STEPS )
+    {
+        Serial.print("] TRACKER: Plan - wait ");
+        Serial.print(delaySteps);
+        Serial.print(" adjustment(s)");
+    }
+    else
+    {
+        Serial.print("] TRACKER: Plan - no move");
+    }
+    Serial.print(" Cost=");
+    Serial.print(costMwh, 2);
+    Serial.print("mWh Idle=");
+    Serial.print(idleCostMwh, 2);
+    Serial.println("mWh");
+}
@@ -14,11 +14,14 @@
 #define CMD_SET "set"
 #define CMD_HELP "help"
 #define CMD_FACTORY_RESET "factory_reset"
+#define CMD_TRACE "trace"
+#define CMD_ROW "row"
+#define CMD_MOVES "moves"
 
 // Forward declaration to avoid circular dependency
 class Settings;
 
-class Terminal {
+class Terminal : public TrackerListener {
 public:
   Terminal();
   void begin();
@@ -43,7 +46,9 @@ public:
   unsigned long getMovingPrintPeriod() const { return movingPrintPeriodMs; }
 
   // Logging
-  void logTrackerStateChange( Tracker::State oldState, Tracker::State newState, const char* reason );
+  void logTrackerStateChange( const Tracker::TraceEntry& entry, const char* axis = "TRACKER" );
+  void logInvalidTrackerEvent( uint8_t state, uint8_t event );
+  void printTrackerStateName( uint8_t state );
   void logMotorStateChange( MotorControl::State oldState, MotorControl::State newState );
   void logSensorData( PhotoSensor* eastSensor, PhotoSensor* westSensor, Tracker* tracker, bool isBalanced );
   void logAdjustmentSkippedLowBrightness( int32_t avgBrightness, int32_t threshold );
@@ -57,6 +62,20 @@ public:
   void logDefaultWestMovementStarted( int32_t avgBrightness, int32_t threshold, unsigned long duration );
   void logDefaultWestMovementCompleted();
   void logSuccessfulMovement( unsigned long duration, bool movingEast );
+  void logAdjustmentDeferredCloud( float brightnessVariation, float differenceDeviation );
+  void logAdjustmentSkippedUnprofitable( float expectedGainMwh, float expectedCostMwh );
+  void logSunSearchStarted( unsigned long spanMs, uint8_t maxProbes );
+  void logSunSearchProbe( uint8_t probe, unsigned long positionMs, float totalOhms );
+  void logSunSearchCompleted( unsigned long positionMs, float totalOhms, uint8_t probes, bool timedOut );
+  void logHillClimbCompleted( uint8_t steps, float startPowerW, float finalPowerW, bool movingWest );
+  void logAdjustmentDeferredStartLimit( uint16_t refillPerHour );
+  void logAdjustmentEndedStartLimit();
+  void logAutoTuneChange( const char* name, float oldValue, float newValue );
+  void logAdjustmentDeferredShading( bool predicted );
+  void logMotorStall( bool endStop, bool movingEast, unsigned long overrunMs );
+  void logBacktrackStarted( int32_t tiltMdeg, int32_t targetMdeg );
+  void logMovePlanned( uint8_t delaySteps, bool movingWest, unsigned long durationMs,
+                       float costMwh, float idleCostMwh );
 
 private:
   unsigned long printPeriodMs;
@@ -66,12 +85,14 @@ private:
   bool logOnlyWhileMoving;
 
   // State tracking for change detection
-  Tracker::State lastTrackerState;
+  uint16_t lastTraceSequence;       // Next tracker trace entry to log
+  uint16_t lastElevationTraceSequence; // Next elevation trace entry to log
   MotorControl::State lastMotorState;
   bool lastBalanced;
   
   // Command processing
   Settings* settings;
+  bool logTrace( const TrackerCore* core, uint16_t* lastSequence, const char* axis );
   static const int COMMAND_BUFFER_SIZE = 24;  // Reduced from 64 to 24 bytes
   char commandBuffer[COMMAND_BUFFER_SIZE];
   int commandBufferIndex;
@@ -1,657 +1,549 @@
 #include "Tracker.h"
 #include "Terminal.h"
-#include <math.h>
-
-Tracker::Tracker(PhotoSensor* eastSensor, PhotoSensor* westSensor, MotorControl* motorControl)
-  : state(IDLE),
-    eastSensor(eastSensor),
+#include "Eeprom.h"
+
+//***********************************************************
+//     Constructor: Tracker
+//
+//     Inputs:
+//     - eastSensor : East photosensor
+//     - westSensor : West photosensor
+//     - motorControl : Panel motor
+//
+//     Description:
+//     - Creates the hardware adapter around the tracker core.
+//
+//***********************************************************
+Tracker::Tracker( PhotoSensor* eastSensor, PhotoSensor* westSensor, MotorControl* motorControl )
+  : eastSensor(eastSensor),
     westSensor(westSensor),
     motorControl(motorControl),
-    tolerancePercent(TRACKER_TOLERANCE_PERCENT),
-    maxMovementTimeMs(TRACKER_MAX_MOVEMENT_TIME_SECONDS * 1000UL),
-    adjustmentPeriodMs(TRACKER_ADJUSTMENT_PERIOD_SECONDS * 1000UL),
-    samplingRateMs(TRACKER_SAMPLING_RATE_MS),
-    brightnessThresholdOhms(TRACKER_BRIGHTNESS_THRESHOLD_OHMS),
-    brightnessFilterTimeConstantS(TRACKER_BRIGHTNESS_FILTER_TIME_CONSTANT_S),
-    filteredBrightness(0.0f),  // Will be initialized with first sample in update()
-    nightThresholdOhms(TRACKER_NIGHT_THRESHOLD_OHMS),
-    nightHysteresisPercent(TRACKER_NIGHT_HYSTERESIS_PERCENT),
-    nightDetectionTimeMs(TRACKER_NIGHT_DETECTION_TIME_SECONDS * 1000UL),
-    nightModeStartTime(0),
-    dayModeStartTime(0),
-    nightConditionMet(false),
-    dayConditionMet(false),
-    lastDayNightTransitionTime(0),
-    reversalDeadTimeMs(1000),
-    reversalTimeLimitMs(TRACKER_REVERSAL_TIME_LIMIT_MS),
-    maxReversalTries(3),
-    reversalTries(0),
-    reversalWaitStartTime(0),
-    reversalStartTime(0),
-    waitingForReversal(false),
-    reversalDirection(false),
-    defaultWestMovementEnabled(TRACKER_ENABLE_DEFAULT_WEST_MOVEMENT),
-    defaultWestMovementMs(TRACKER_DEFAULT_WEST_MOVEMENT_MS),
-    defaultWestMovementStartTime(0),
-    useAverageMovementTime(TRACKER_USE_AVERAGE_MOVEMENT_TIME),
-    movementHistorySize(TRACKER_MOVEMENT_HISTORY_SIZE),
-    movementHistory(nullptr),
-    movementHistoryIndex(0),
-    movementHistoryCount(0),
-    monitorModeEnabled(TRACKER_MONITOR_MODE_ENABLED),
-    startMoveThresholdPercent(TRACKER_START_MOVE_THRESHOLD_PERCENT),
-    minWaitTimeMs(TRACKER_MIN_WAIT_TIME_SECONDS * 1000UL),
-    monitorFilterTimeConstantS(TRACKER_MONITOR_FILTER_TIME_CONSTANT_S),
-    lastAdjustmentTime(0),
-    lastSamplingTime(0),
-    movementStartTime(0),
-    lastBrightnessSampleTime(0),
-    lastStateChangeTime(0),
-    lastMovementDuration(0),
-    initialEastValue(0.0f),
-    initialWestValue(0.0f),
-    initialDiff(0.0f),
-    movementDirectionSet(false),
-    movingEast(false),
-    monitorFilteredEast(0.0f),  // Initialize monitor mode filter values
-    monitorFilteredWest(0.0f),
-    lastMonitorSampleTime(0)
-{
-  initializeMovementHistory();
-}
-
+    powerSensor(nullptr),
+    pendingSampleMask(0),
+    elevation(nullptr),
+    upSensor(nullptr),
+    downSensor(nullptr),
+    elevationMotor(nullptr),
+    elevationTolerancePercent(TRACKER_ELEVATION_TOLERANCE_PERCENT),
+    elevationPeriodSeconds(TRACKER_ELEVATION_ADJUSTMENT_PERIOD_SECONDS),
+    elevationMaxMoveSeconds(TRACKER_ELEVATION_MAX_MOVEMENT_TIME_SECONDS),
+    maxMotorsRunning(TRACKER_MAX_MOTORS_RUNNING),
+    rows(nullptr),
+    savedPositionStarts(0),
+    stepTimeCount(0),
+    stepTimeSumUs(0),
+    stepTimeAverageUs(0),
+    stepTimeMaxUs(0),
+    azimuthPlan(),
+    elevationPlan()
+{
+}
+
+//***********************************************************
+//     Function Name: begin
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Routes core log events to the terminal, restores the
+//       shading map and panel position, starts the core (and the elevation core and
+//       extra rows, if fitted) from the current sensor values and
+//       subscribes to new sensor samples.
+//
+//***********************************************************
 void Tracker::begin()
 {
-  unsigned long currentTime = millis();
-  lastAdjustmentTime = currentTime;
-  lastSamplingTime = currentTime;
-  lastStateChangeTime = currentTime;
-  lastDayNightTransitionTime = currentTime;
-  lastMonitorSampleTime = currentTime;
-  lastMovementDuration = 0;
-  state = IDLE;
-  reversalTries = 0;
-  waitingForReversal = false;
-  reversalWaitStartTime = 0;
-  reversalDirection = false;
-  nightConditionMet = false;
-  dayConditionMet = false;
-  nightModeStartTime = 0;
-  dayModeStartTime = 0;
-  movementHistoryIndex = 0;
-  movementHistoryCount = 0;
-  monitorFilteredEast = eastSensor->getValue();  // Initialize monitor filters
-  monitorFilteredWest = westSensor->getValue();
-}
+  extern Terminal terminal;
+  setListener( &terminal );
 
-void Tracker::initializeMovementHistory()
-{
-  cleanupMovementHistory();
-  if( movementHistorySize > 0 )
+  if( !eeprom.loadShadingMap( getShadingMap()->getScores(), SHADING_SLOTS ))
   {
-    movementHistory = new unsigned long[movementHistorySize];
-    for( uint8_t i = 0; i < movementHistorySize; i++ )
-    {
-      movementHistory[i] = defaultWestMovementMs;  // Initialize with default time
-    }
+    getShadingMap()->clear();
   }
-}
-
-void Tracker::cleanupMovementHistory()
-{
-  if( movementHistory != nullptr )
+  uint8_t record[PanelPosition::RECORD_SIZE];
+  if( eeprom.loadPanelPosition( record, PanelPosition::RECORD_SIZE ))
   {
-    delete[] movementHistory;
-    movementHistory = nullptr;
+    motorControl->getPosition()->fromRecord( record );
   }
-}
+  savedPositionStarts = motorControl->getStartCount();
 
-void Tracker::recordSuccessfulMovement( unsigned long duration )
-{
-  if( movementHistory != nullptr && movementHistorySize > 0 )
-  {
-    movementHistory[movementHistoryIndex] = duration;
-    movementHistoryIndex = ( movementHistoryIndex + 1 ) % movementHistorySize;
-    if( movementHistoryCount < movementHistorySize )
-    {
-      movementHistoryCount++;
-    }
-  }
-}
+  Inputs inputs;
+  readInputs( &inputs, eastSensor, westSensor, motorControl, elevation, elevationMotor );
+  TrackerCore::begin( inputs );
+  pendingSampleMask = 0;
 
-unsigned long Tracker::getAverageMovementTime() const
-{
-  if( movementHistory == nullptr || movementHistoryCount == 0 )
-  {
-    return defaultWestMovementMs;
-  }
+  // Evaluate stop conditions as soon as each new sample pair is filtered
+  eastSensor->setSampleReadyCallback( onSampleReady, this );
+  westSensor->setSampleReadyCallback( onSampleReady, this );
+  motorControl->setCommandDoneCallback( onCommandDone, this );
 
-  unsigned long sum = 0;
-  for( uint8_t i = 0; i < movementHistoryCount; i++ )
+  if( elevation != nullptr )
   {
-    sum += movementHistory[i];
+    configureElevation();
+    readInputs( &inputs, upSensor, downSensor, elevationMotor, this, motorControl );
+    elevation->begin( inputs );
+    upSensor->setSampleReadyCallback( onSampleReady, this );
+    downSensor->setSampleReadyCallback( onSampleReady, this );
+    elevationMotor->setCommandDoneCallback( onCommandDone, this );
   }
-  return sum / movementHistoryCount;
-}
-
-void Tracker::setUseAverageMovementTime( bool enabled )
-{
-  useAverageMovementTime = enabled;
-}
 
-void Tracker::setMovementHistorySize( uint8_t size )
-{
-  if( size != movementHistorySize )
+  if( rows != nullptr )
   {
-    movementHistorySize = size;
-    initializeMovementHistory();
+    rows->setMaxMotorsRunning( maxMotorsRunning );
+    rows->begin( motorControl, elevationMotor );
   }
 }
 
+//***********************************************************
+//     Function Name: update
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Runs one timed core step from the current hardware state,
+//       then the elevation step and the extra rows in the same pass.
+//       Stores the panel position once each move has finished.
+//
+//***********************************************************
 void Tracker::update()
 {
-  unsigned long currentTime = millis();
-  
-  // Update filtered brightness (EMA) - runs in all states
-  float eastValue = eastSensor->getFilteredValue();
-  float westValue = westSensor->getFilteredValue();
-  float avgBrightness = ( eastValue + westValue ) / 2.0f;
-
-  // Initialize or update EMA filter
-  if( lastBrightnessSampleTime == 0 )
+  Inputs inputs;
+  readInputs( &inputs, eastSensor, westSensor, motorControl, elevation, elevationMotor );
+  runStep( this, motorControl, inputs );
+  if( elevation != nullptr )
   {
-    // Initialize with first sample
-    filteredBrightness = avgBrightness;
-    lastBrightnessSampleTime = currentTime;
+    stepElevation( false, 0 );
   }
-  else if( currentTime != lastBrightnessSampleTime )
+  if( rows != nullptr )
   {
-    float dt = ( currentTime - lastBrightnessSampleTime ) / 1000.0f;
-    lastBrightnessSampleTime = currentTime;
-    float alpha = brightnessFilterTimeConstantS > 0 ? dt / brightnessFilterTimeConstantS : 1.0f;
-    if( alpha > 1.0f ) alpha = 1.0f;
-    filteredBrightness += ( alpha * ( avgBrightness - filteredBrightness ));
-    if( filteredBrightness < 0.0f ) filteredBrightness = 0.0f;
+    rows->update( millis(), *this );
   }
 
-  // Update monitor mode filters - always run to maintain filter state
-  if( lastMonitorSampleTime == 0 )
-  {
-    // Initialize monitor filters with first sample
-    monitorFilteredEast = eastValue;
-    monitorFilteredWest = westValue;
-    lastMonitorSampleTime = currentTime;
-  }
-  else if( currentTime != lastMonitorSampleTime )
+  if( motorControl->getState() == MotorControl::STOPPED &&
+      motorControl->getStartCount() != savedPositionStarts )
   {
-    float dt = ( currentTime - lastMonitorSampleTime ) / 1000.0f;
-    lastMonitorSampleTime = currentTime;
-    float alpha = monitorFilterTimeConstantS > 0 ? dt / monitorFilterTimeConstantS : 1.0f;
-    if( alpha > 1.0f ) alpha = 1.0f;
-
-    // Update east sensor monitor filter
-    monitorFilteredEast += ( alpha * ( eastValue - monitorFilteredEast ));
-    if( monitorFilteredEast < 0.0f ) monitorFilteredEast = 0.0f;
-
-    // Update west sensor monitor filter
-    monitorFilteredWest += ( alpha * ( westValue - monitorFilteredWest ));
-    if( monitorFilteredWest < 0.0f ) monitorFilteredWest = 0.0f;
-  }
-
-  switch( state )
-  {
-    case IDLE:
-      // Check for night condition
-      if( filteredBrightness >= nightThresholdOhms )
-      {
-        if( !nightConditionMet )
-        {
-          nightConditionMet = true;
-          nightModeStartTime = currentTime;
-        }
-        else if( currentTime - nightModeStartTime >= nightDetectionTimeMs )
-        {
-          extern Terminal terminal;
-          terminal.logNightModeEntered( (int32_t)filteredBrightness, nightThresholdOhms );
-          lastDayNightTransitionTime = currentTime;
-          changeState( NIGHT_MODE );
-          motorControl->stop();
-          motorControl->moveEast();  // Move to full east position
-          dayConditionMet = false;
-          dayModeStartTime = 0;
-          break;
-        }
-      }
-      else
-      {
-        nightConditionMet = false;
-        nightModeStartTime = 0;
-      }
-
-      // Check conditions for entering ADJUSTING state
-      bool shouldAdjust = false;
-      bool isMonitorTriggered = false;
-
-      // Monitor mode check (if enabled and not in night mode)
-      if( monitorModeEnabled && filteredBrightness < brightnessThresholdOhms )
-      {
-        // Calculate monitor mode difference percentage
-        float lowerValue = (( monitorFilteredEast < monitorFilteredWest ) ? 
-                            monitorFilteredEast : monitorFilteredWest );
-        float diffPercent = ( abs( monitorFilteredEast - monitorFilteredWest ) / lowerValue ) * 100.0f;
-        
-        // Check if difference exceeds threshold and minimum wait time has elapsed
-        if( diffPercent > startMoveThresholdPercent && 
-            currentTime - lastAdjustmentTime >= minWaitTimeMs )
-        {
-          shouldAdjust = true;
-          isMonitorTriggered = true;
-        }
-      }
-      
-      // Regular adjustment period check (if not in monitor mode or monitor didn't trigger)
-      if( !shouldAdjust && currentTime - lastAdjustmentTime >= adjustmentPeriodMs )
-      {
-        if( filteredBrightness >= brightnessThresholdOhms )
-        {
-          extern Terminal terminal;
-          if( defaultWestMovementEnabled )
-          {
-            // Calculate movement duration
-            unsigned long movementDuration = useAverageMovementTime ? 
-                                           getAverageMovementTime() : 
-                                           defaultWestMovementMs;
-            // Start default west movement
-            terminal.logDefaultWestMovementStarted( (int32_t)filteredBrightness,
-                                                  brightnessThresholdOhms,
-                                                  movementDuration );
-            motorControl->moveWest();
-            defaultWestMovementStartTime = currentTime;
-            lastAdjustmentTime = currentTime;  // Start timing from when movement begins
-            changeState( DEFAULT_WEST_MOVEMENT );
-          }
-          else
-          {
-            terminal.logAdjustmentSkippedLowBrightness( (int32_t)filteredBrightness,
-                                                       brightnessThresholdOhms );
-            lastAdjustmentTime = currentTime;  // Start timing from when adjustment was skipped
-          }
-        }
-        else
-        {
-          shouldAdjust = true;
-        }
-      }
-
-      // Enter ADJUSTING state if needed
-      if( shouldAdjust )
-      {
-        changeState( ADJUSTING );
-        lastSamplingTime = currentTime;
-        movementStartTime = currentTime;
-        lastAdjustmentTime = currentTime;  // Start timing from when adjustment begins
-        
-        // Store initial sensor values for overshoot detection
-        // Use monitor filtered values if monitor mode triggered the adjustment
-        if( isMonitorTriggered )
-        {
-          initialEastValue = monitorFilteredEast;
-          initialWestValue = monitorFilteredWest;
-        }
-        else
-        {
-          initialEastValue = eastSensor->getFilteredValue();
-          initialWestValue = westSensor->getFilteredValue();
-        }
-        initialDiff = initialEastValue - initialWestValue;
-        movementDirectionSet = false;
-      }
-      break;
-
-    case DEFAULT_WEST_MOVEMENT:
-      {
-        unsigned long movementDuration = useAverageMovementTime ? 
-                                       getAverageMovementTime() : 
-                                       defaultWestMovementMs;
-        if( currentTime - defaultWestMovementStartTime >= movementDuration )
-        {
-          motorControl->stop();
-          defaultWestMovementStartTime = 0;
-          extern Terminal terminal;
-          terminal.logDefaultWestMovementCompleted();
-          changeState( IDLE );
-        }
-      }
-      break;
-
-    case NIGHT_MODE:
-    {
-      float dayThreshold = nightThresholdOhms * ( 1.0f - nightHysteresisPercent / 100.0f );
-      if( filteredBrightness <= dayThreshold )
-      {
-        if( !dayConditionMet )
-        {
-          dayConditionMet = true;
-          dayModeStartTime = currentTime;
-        }
-        else if( currentTime - dayModeStartTime >= nightDetectionTimeMs )
-        {
-          extern Terminal terminal;
-          terminal.logDayModeEntered( (int32_t)filteredBrightness, (int32_t)dayThreshold );
-          lastDayNightTransitionTime = currentTime;
-          changeState( IDLE );
-          motorControl->stop();
-          // Reset adjustment timer to start fresh when entering day mode
-          lastAdjustmentTime = currentTime;
-          nightConditionMet = false;
-          nightModeStartTime = 0;
-          break;
-        }
-      }
-      else
-      {
-        dayConditionMet = false;
-        dayModeStartTime = 0;
-      }
-      // Remain in NIGHT_MODE, do not perform tracking or movement except move to east on entry
-      break;
-    }
-
-    case ADJUSTING:
-      // Check if maximum movement time exceeded
-      if( currentTime - movementStartTime >= maxMovementTimeMs )
-      {
-        motorControl->stop();
-        state = IDLE;
-        reversalTries = 0;
-        waitingForReversal = false;
-      }
-      // Handle reversal dead time
-      else if( waitingForReversal )
-      {
-        if( currentTime - reversalWaitStartTime >= reversalDeadTimeMs )
-        {
-          // Reverse direction and try again
-          movingEast = !movingEast;
-          reversalDirection = movingEast;
-          movementDirectionSet = true;
-          waitingForReversal = false;
-          reversalStartTime = currentTime;
-          // Update initialDiff for new direction
-          float eastValue = eastSensor->getFilteredValue();
-          float westValue = westSensor->getFilteredValue();
-          initialDiff = ( eastValue - westValue );
-        }
-      }
-      // Check if reversal movement time limit exceeded
-      else if( reversalTries > 0 && currentTime - reversalStartTime >= reversalTimeLimitMs )
-      {
-        motorControl->stop();
-        float eastValue = eastSensor->getFilteredValue();
-        float westValue = westSensor->getFilteredValue();
-        float currentDiff = ( eastValue - westValue );
-        float lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
-        float tolerance = ( lowerValue * tolerancePercent / 100.0f );
-
-        // Check if we've achieved balance or made meaningful progress
-        bool isBalanced = ( abs( currentDiff ) <= tolerance );
-        bool hasOvershot = (( currentDiff * initialDiff ) < 0 ) && ( fabs( currentDiff ) > tolerance );
-
-        // If not balanced and no overshoot, stop trying reversals
-        if( !isBalanced && !hasOvershot )
-        {
-          extern Terminal terminal;
-          terminal.logReversalAbortedNoProgress( movingEast, eastValue, westValue, tolerance, initialDiff );
-          state = IDLE;
-          reversalTries = 0;
-          waitingForReversal = false;
-        }
-        // Otherwise continue with normal reversal logic
-        else if( reversalTries + 1 < maxReversalTries )
-        {
-          reversalTries++;
-          waitingForReversal = true;
-          reversalWaitStartTime = currentTime;
-        }
-        else
-        {
-          state = IDLE;
-          reversalTries = 0;
-          waitingForReversal = false;
-        }
-      }
-      // Check if it's time to sample sensors
-      else if( currentTime - lastSamplingTime >= samplingRateMs )
-      {
-        lastSamplingTime = currentTime;
-        float eastValue = eastSensor->getFilteredValue();
-        float westValue = westSensor->getFilteredValue();
-        float lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
-        float tolerance = ( lowerValue * tolerancePercent / 100.0f );
-        float currentDiff = ( eastValue - westValue );
-
-        // Stop movement if filtered brightness falls below threshold
-        if( filteredBrightness >= brightnessThresholdOhms )
-        {
-          extern Terminal terminal;
-          terminal.logAdjustmentAbortedLowBrightness( (int32_t)filteredBrightness, brightnessThresholdOhms );
-          motorControl->stop();
-          changeState( IDLE );
-          reversalTries = 0;
-          waitingForReversal = false;
-        }
-        // Check if sensors are balanced within tolerance
-        else if( abs( eastValue - westValue ) <= tolerance )
-        {
-          motorControl->stop();
-          // Record successful movement duration
-          unsigned long movementDuration = currentTime - movementStartTime;
-          lastMovementDuration = movementDuration;
-          recordSuccessfulMovement( movementDuration );
-          extern Terminal terminal;
-          terminal.logSuccessfulMovement( movementDuration, movingEast );
-          changeState( IDLE );
-          reversalTries = 0;
-          waitingForReversal = false;
-        }
-        else
-        {
-          // Determine movement direction if not set yet
-          if( !movementDirectionSet )
-          {
-            movingEast = ( eastValue < westValue );
-            reversalDirection = movingEast;
-            movementDirectionSet = true;
-          }
-
-          // Check for overshoot
-          bool overshootDetected = false;
-          if((( currentDiff * initialDiff ) < 0 ) && ( fabs( currentDiff ) > tolerance ))
-          {
-            overshootDetected = true;
-          }
-
-          if( overshootDetected )
-          {
-            extern Terminal terminal;
-            terminal.logOvershootDetected( movingEast, eastValue, westValue, tolerance );
-            motorControl->stop();
-            if( reversalTries + 1 < maxReversalTries )
-            {
-              reversalTries++;
-              waitingForReversal = true;
-              reversalWaitStartTime = currentTime;
-            }
-            else
-            {
-              changeState( IDLE );
-              reversalTries = 0;
-              waitingForReversal = false;
-            }
-          }
-          else
-          {
-            // Continue movement in current direction
-            if( movingEast )
-            {
-              motorControl->moveEast();
-            }
-            else
-            {
-              motorControl->moveWest();
-            }
-          }
-        }
-      }
-      break;
+    savedPositionStarts = motorControl->getStartCount();
+    uint8_t record[PanelPosition::RECORD_SIZE];
+    motorControl->getPosition()->toRecord( record );
+    eeprom.savePanelPosition( record, PanelPosition::RECORD_SIZE );
   }
 }
 
-void Tracker::setTolerance( float tolerancePercent )
+void Tracker::setPowerSensor( PowerSensor* powerSensor )
 {
-  if( tolerancePercent >= 0.0f && tolerancePercent <= 100.0f )
-  {
-    this->tolerancePercent = tolerancePercent;
-  }
+  this->powerSensor = powerSensor;
 }
 
-void Tracker::setMaxMovementTime( unsigned long maxMovementTimeSeconds )
+void Tracker::clearShadingMap()
 {
-  maxMovementTimeMs = maxMovementTimeSeconds * 1000UL;
+  getShadingMap()->clear();
+  eeprom.saveShadingMap( getShadingMap()->getScores(), SHADING_SLOTS );
 }
 
-void Tracker::setAdjustmentPeriod( unsigned long adjustmentPeriodSeconds )
+void Tracker::setStallDetectEnabled( bool enabled )
 {
-  adjustmentPeriodMs = adjustmentPeriodSeconds * 1000UL;
+  getStallDetector()->setEnabled( enabled );
+  configureElevation();
 }
 
-void Tracker::setSamplingRate( unsigned long samplingRateMs )
+void Tracker::setElevationAxis( TrackerCore* core, PhotoSensor* upSensor, PhotoSensor* downSensor,
+                                MotorControl* motorControl )
 {
-  this->samplingRateMs = samplingRateMs;
+  elevation = core;
+  this->upSensor = upSensor;
+  this->downSensor = downSensor;
+  elevationMotor = motorControl;
 }
 
-void Tracker::setNightThreshold(int32_t thresholdOhms)
+void Tracker::setElevationTolerance( float tolerancePercent )
 {
-  if( thresholdOhms > brightnessThresholdOhms )
+  if( tolerancePercent >= 0.0f && tolerancePercent <= 100.0f )
   {
-    nightThresholdOhms = thresholdOhms;
+    elevationTolerancePercent = tolerancePercent;
+    configureElevation();
   }
 }
 
-void Tracker::setNightHysteresis(float hysteresisPercent)
+void Tracker::setElevationAdjustmentPeriod( unsigned long periodSeconds )
 {
-  if( hysteresisPercent >= 0.0f && hysteresisPercent <= 100.0f )
-  {
-    nightHysteresisPercent = hysteresisPercent;
-  }
+  elevationPeriodSeconds = periodSeconds;
+  configureElevation();
 }
 
-void Tracker::setNightDetectionTime(unsigned long detectionTimeSeconds)
+void Tracker::setElevationMaxMovementTime( unsigned long maxMovementTimeSeconds )
 {
-  nightDetectionTimeMs = detectionTimeSeconds * 1000UL;
+  elevationMaxMoveSeconds = maxMovementTimeSeconds;
+  configureElevation();
 }
 
-void Tracker::setBrightnessThreshold(int32_t thresholdOhms)
+void Tracker::setMaxMotorsRunning( uint8_t motors )
 {
-  if( thresholdOhms < nightThresholdOhms )
+  maxMotorsRunning = ( motors < 1 ) ? 1 : motors;
+  if( rows != nullptr )
   {
-    brightnessThresholdOhms = thresholdOhms;
+    rows->setMaxMotorsRunning( maxMotorsRunning );
   }
 }
 
-void Tracker::setBrightnessFilterTimeConstant( float tauS )
-{
-  brightnessFilterTimeConstantS = tauS;
-}
-
-void Tracker::setReversalDeadTime(unsigned long ms)
-{
-  reversalDeadTimeMs = ms;
-}
-
-void Tracker::setMaxReversalTries(int tries)
-{
-  maxReversalTries = tries;
-}
-
-void Tracker::setReversalTimeLimit(unsigned long ms)
-{
-  reversalTimeLimitMs = ms;
-}
-
-void Tracker::setDefaultWestMovementEnabled(bool enabled)
-{
-  defaultWestMovementEnabled = enabled;
-}
-
-void Tracker::setDefaultWestMovementTime(unsigned long ms)
-{
-  defaultWestMovementMs = ms;
-}
-
-void Tracker::setMonitorModeEnabled( bool enabled )
-{
-  monitorModeEnabled = enabled;
-}
-
-void Tracker::setStartMoveThreshold( float thresholdPercent )
-{
-  startMoveThresholdPercent = thresholdPercent;
-}
-
-void Tracker::setMinWaitTime( unsigned long waitTimeSeconds )
-{
-  minWaitTimeMs = waitTimeSeconds * 1000UL;
-}
-
-void Tracker::setMonitorFilterTimeConstant( float tauS )
-{
-  monitorFilterTimeConstantS = tauS;
-}
-
-Tracker::State Tracker::getState() const
-{
-  return state;
-}
-
-bool Tracker::isAdjusting() const
-{
-  return state == ADJUSTING;
-}
+//***********************************************************
+//     Function Name: configureElevation
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Applies the per-axis parameters to the elevation core.
+//       The elevation axis only balances its sensors: day/night
+//       comes from the azimuth core, and blind moves, searches,
+//       estimators, learning and soft end limits stay with the
+//       azimuth axis.
+//
+//***********************************************************
+void Tracker::configureElevation()
+{
+  if( elevation == nullptr )
+  {
+    return;
+  }
+  elevation->setTolerance( elevationTolerancePercent );
+  elevation->setAdjustmentPeriod( elevationPeriodSeconds );
+  elevation->setMaxMovementTime( elevationMaxMoveSeconds );
+
+  // Above the sensor range, so the elevation core never detects night itself
+  elevation->setNightThreshold( SENSOR_MAX_RESISTANCE_OHMS + 1 );
+  elevation->setDefaultWestMovementEnabled( false );
+  elevation->setSunSearchEnabled( false );
+  elevation->setTrackingStrategy( TRACKER_STRATEGY_SENSOR_BALANCE );
+  elevation->setKalmanEnabled( false );
+  elevation->setEnergyAwareEnabled( false );
+  elevation->setAutoTuneEnabled( false );
+  elevation->setShadingMapEnabled( false );
+  elevation->getBacktracker()->setEnabled( false );
+  elevation->getStallDetector()->setEnabled( getStallDetector()->getEnabled() );
+
+  // The position estimate, its limits and the PWM ramps are set up for the azimuth drive
+  elevationMotor->setSoftLimitsEnabled( false );
+  elevationMotor->setPwmEnabled( false );
+}
+
+//***********************************************************
+//     Function Name: stepElevation
+//
+//     Inputs:
+//     - samplePair : Both elevation sensors have a new sample
+//     - sampleMicros : When the pair completed
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Runs one elevation core step. The elevation axis rests
+//       while the azimuth core is in night mode.
+//
+//***********************************************************
+void Tracker::stepElevation( bool samplePair, unsigned long sampleMicros )
+{
+  if( isNightMode() )
+  {
+    if( elevationMotor->getState() != MotorControl::STOPPED )
+    {
+      elevationMotor->stop();
+    }
+    return;
+  }
 
-unsigned long Tracker::getTimeUntilNextAdjustment() const
-{
-  unsigned long currentTime = millis();
-  unsigned long timeSinceLastAdjustment = currentTime - lastAdjustmentTime;
-  if( timeSinceLastAdjustment >= adjustmentPeriodMs )
+  Inputs inputs;
+  readInputs( &inputs, upSensor, downSensor, elevationMotor, this, motorControl );
+  inputs.samplePair = samplePair;
+  inputs.sampleMicros = sampleMicros;
+  runStep( elevation, elevationMotor, inputs );
+}
+
+void Tracker::onSampleReady( PhotoSensor* sensor, void* context )
+{
+  static_cast<Tracker*>( context )->handleSampleReady( sensor );
+}
+
+//***********************************************************
+//     Function Name: onCommandDone
+//
+//     Inputs:
+//     - motor : Motor that finished a queued command
+//     - commandId : Id returned when the command was queued
+//     - result : MotorControl::CommandResult
+//     - context : The tracker
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Marks the matching command of the axis plan as finished,
+//       and as refused if the motor would not start it. A
+//       cancelled command is finished too; the core only cancels
+//       by replacing the plan.
+//
+//***********************************************************
+void Tracker::onCommandDone( MotorControl* motor, uint8_t commandId, uint8_t result, void* context )
+{
+  PlanStatus* plan = static_cast<Tracker*>( context )->getPlanStatus( motor );
+  uint8_t index = 0;
+  while( index < MOTOR_PLAN_STEPS && ( plan->ids[index] == 0 || plan->ids[index] != commandId ))
   {
-    return 0;
+    index++;
+  }
+  if( index == MOTOR_PLAN_STEPS )
+  {
+    // A command can finish while it is being queued, before its id is known
+    if( plan->queueing == 0 )
+    {
+      return;
+    }
+    index = plan->queueing - 1;
+  }
+  plan->ids[index] = 0;
+  plan->doneMask |= ( 1 << index );
+  if( result == MotorControl::COMMAND_REFUSED )
+  {
+    plan->refusedMask |= ( 1 << index );
   }
-  return ( adjustmentPeriodMs - timeSinceLastAdjustment );
 }
 
-unsigned long Tracker::getTimeSinceLastStateChange() const
-{
-  unsigned long currentTime = millis();
-  return currentTime - lastStateChangeTime;
+Tracker::PlanStatus* Tracker::getPlanStatus( const MotorControl* motor )
+{
+  return ( motor == elevationMotor ) ? &elevationPlan : &azimuthPlan;
+}
+
+//***********************************************************
+//     Function Name: applyMotorPlan
+//
+//     Inputs:
+//     - motor : Motor of the axis
+//     - outputs : Step outputs holding the plan
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Queues the core's plan on the motor, after the stop the
+//       core sends with it. A command the queue cannot take is
+//       reported to the core as refused.
+//
+//***********************************************************
+void Tracker::applyMotorPlan( MotorControl* motor, const Outputs& outputs )
+{
+  PlanStatus* plan = getPlanStatus( motor );
+  memset( plan, 0, sizeof( PlanStatus ));
+  for( uint8_t i = 0; i < outputs.motorPlanLength; i++ )
+  {
+    const MotorStep& step = outputs.motorPlan[i];
+    uint8_t id;
+    plan->queueing = i + 1;
+    if( step.move == MOTOR_NONE )
+    {
+      id = motor->queueStop( step.durationMs );
+    }
+    else
+    {
+      MotorControl::Direction direction = ( step.move == MOTOR_EAST ) ?
+                                          MotorControl::DIRECTION_EAST : MotorControl::DIRECTION_WEST;
+      id = motor->queueMove( direction, step.durationMs, outputs.motorPriority );
+    }
+    plan->queueing = 0;
+    if( id == 0 )
+    {
+      plan->doneMask |= ( 1 << i );
+      plan->refusedMask |= ( 1 << i );
+    }
+    else if(( plan->doneMask & ( 1 << i )) == 0 )
+    {
+      plan->ids[i] = id;
+    }
+  }
 }
 
-unsigned long Tracker::getLastMovementDuration() const
-{
-  return lastMovementDuration;
+//***********************************************************
+//     Function Name: handleSampleReady
+//
+//     Inputs:
+//     - sensor : Sensor that produced a new filtered sample
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Runs a core step with the sample pair as soon as both
+//       sensors of an axis have fresh data, so stop decisions are
+//       not delayed until the next update().
+//
+//***********************************************************
+void Tracker::handleSampleReady( PhotoSensor* sensor )
+{
+  uint8_t bit = ( sensor == eastSensor ) ? 0x01 :
+                ( sensor == westSensor ) ? 0x02 :
+                ( sensor == upSensor ) ? 0x04 : 0x08;
+  pendingSampleMask |= bit;
+
+  // Wait until both sides have fresh data so the pair is consistent
+  if( bit <= 0x02 && ( pendingSampleMask & 0x03 ) == 0x03 )
+  {
+    pendingSampleMask &= ~0x03;
+    Inputs inputs;
+    readInputs( &inputs, eastSensor, westSensor, motorControl, elevation, elevationMotor );
+    inputs.samplePair = true;
+    inputs.sampleMicros = sensor->getLastSampleMicros();
+    runStep( this, motorControl, inputs );
+  }
+  else if( bit >= 0x04 && ( pendingSampleMask & 0x0C ) == 0x0C )
+  {
+    pendingSampleMask &= ~0x0C;
+    stepElevation( true, sensor->getLastSampleMicros() );
+  }
 }
 
-unsigned long Tracker::getTimeSinceLastDayNightTransition() const
-{
-  unsigned long currentTime = millis();
-  return currentTime - lastDayNightTransitionTime;
-}
+//***********************************************************
+//     Function Name: readInputs
+//
+//     Inputs:
+//     - inputs : Filled with the hardware state of one axis
+//     - east, west : Sensor pair of the axis (up/down for elevation)
+//     - motor : Motor of the axis
+//     - otherCore, otherMotor : The other axis (nullptr if none)
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Reads one axis into core inputs. With one motor allowed
+//       at a time, the supply is free only while the other axis
+//       is idle with its motor stopped. With extra rows fitted it
+//       is also busy while another motor is starting, and running
+//       row motors count against the budget.
+//
+//***********************************************************
+void Tracker::readInputs( Inputs* inputs, PhotoSensor* east, PhotoSensor* west, MotorControl* motor,
+                          const TrackerCore* otherCore, const MotorControl* otherMotor )
+{
+  inputs->timeMs = millis();
+  inputs->timeUs = micros();
+  // The core works in whole ohms; float stays on this side of the boundary
+  inputs->eastValue = (int32_t)( east->getFilteredValue() + 0.5f );
+  inputs->westValue = (int32_t)( west->getFilteredValue() + 0.5f );
+  inputs->samplePair = false;
+  inputs->sampleMicros = 0;
+  inputs->motorState = motor->getState();
+  inputs->motorCanStart = motor->canStart();
+  inputs->motorTakeUpMs = motor->getTakeUpTime();
+  inputs->motorReversalMove = motor->isReversalMove();
+  inputs->motorMoveStartTime = motor->getMoveStartTime();
+  // Plan completions go to the core once
+  PlanStatus* plan = getPlanStatus( motor );
+  inputs->motorPlanDone = plan->doneMask;
+  inputs->motorPlanRefused = plan->refusedMask;
+  plan->doneMask = 0;
+  plan->refusedMask = 0;
+  inputs->motorRunTimeMs = motor->getTotalRunTime();
+  inputs->motorStartRate = motor->getStartRefillRate();
+  inputs->motorEastLimit = motor->isSoftLimitReached( false );
+  inputs->motorWestLimit = motor->isSoftLimitReached( true );
+  // Only the azimuth position estimate knows where its end stops are
+  inputs->motorNearEndStop = ( motor == motorControl ) && motor->isNearEndStop();
+  // Flat is the middle of the travel
+  inputs->panelTiltKnown = ( motor == motorControl ) && motor->getPosition()->isKnown();
+  inputs->panelTiltMdeg = motor->getPositionEstimate() - motor->getTravel() * 500L;
+  inputs->supplyAvailable = ( otherCore == nullptr || maxMotorsRunning >= 2 ||
+                              ( otherCore->getState() == IDLE &&
+                                otherMotor->getState() == MotorControl::STOPPED )) &&
+                            ( rows == nullptr || rows->isStartAllowed( inputs->timeMs, motor ));
+  inputs->powerValid = ( powerSensor != nullptr );
+  inputs->powerW = inputs->powerValid ? powerSensor->getPower() : 0.0f;
+  inputs->energyWh = inputs->powerValid ? powerSensor->getEnergyWh() : 0.0f;
+}
+
+//***********************************************************
+//     Function Name: runStep
+//
+//     Inputs:
+//     - inputs : Hardware state for this step
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Steps a core, times the step and applies its outputs
+//       to the axis motor and EEPROM.
+//
+//***********************************************************
+void Tracker::runStep( TrackerCore* core, MotorControl* motor, const Inputs& inputs )
+{
+  Outputs outputs;
+  unsigned long startUs = micros();
+  core->step( inputs, outputs );
+  unsigned long elapsedUs = micros() - startUs;
+
+  if( elapsedUs > stepTimeMaxUs )
+  {
+    stepTimeMaxUs = elapsedUs;
+  }
+  stepTimeSumUs += elapsedUs;
+  if( ++stepTimeCount >= STEP_TIME_WINDOW )
+  {
+    stepTimeAverageUs = stepTimeSumUs / STEP_TIME_WINDOW;
+    stepTimeSumUs = 0;
+    stepTimeCount = 0;
+  }
 
-void Tracker::changeState( State newState )
-{
-  if( state != newState )
+  if( outputs.motorStall == STALL_END_STOP )
+  {
+    // Re-zeroes the position at the stop the panel just ran into
+    motor->stopAtEndStop( outputs.stallOverrunMs );
+  }
+  if( outputs.motorStop )
+  {
+    // Whatever the stop cancels belongs to a plan the core has dropped
+    memset( getPlanStatus( motor ), 0, sizeof( PlanStatus ));
+    motor->stop();
+  }
+  if( outputs.motorMove == MOTOR_EAST )
+  {
+    // The only safety move is the night return, timed from the position estimate
+    if( outputs.motorPriority == MotorControl::PRIORITY_SAFETY )
+    {
+      motor->returnEast();
+    }
+    else
+    {
+      motor->moveEast( outputs.motorPriority );
+    }
+  }
+  else if( outputs.motorMove == MOTOR_WEST )
+  {
+    motor->moveWest( outputs.motorPriority );
+  }
+  if( outputs.motorPlanLength > 0 )
+  {
+    applyMotorPlan( motor, outputs );
+  }
+  if( outputs.motorApproach )
+  {
+    motor->setApproach();
+  }
+  if( outputs.responseValid )
+  {
+    motor->recordResponseLatency( outputs.responseLatencyMs, outputs.responseReversal );
+  }
+  if( outputs.shadingMapChanged )
   {
-    state = newState;
-    lastStateChangeTime = millis();
+    eeprom.saveShadingMap( core->getShadingMap()->getScores(), SHADING_SLOTS );
   }
-}
\ No newline at end of file
+}
@@ -3,168 +3,102 @@
 
 #include <Arduino.h>
 #include "param_config.h"
+#include "TrackerCore.h"
 #include "Photosensor.h"
 #include "MotorControl.h"
+#include "PowerSensor.h"
+#include "TrackerRows.h"
 
-class Tracker {
+// Connects TrackerCore to the clock, sensors, motor, terminal and EEPROM
+class Tracker : public TrackerCore {
 public:
-  enum State 
-  {
-    IDLE,
-    ADJUSTING,
-    NIGHT_MODE,
-    DEFAULT_WEST_MOVEMENT
-  };
-
   Tracker( PhotoSensor* eastSensor, PhotoSensor* westSensor, MotorControl* motorControl );
   void begin();
   void update();
 
-  // Configuration
-  void setTolerance( float tolerancePercent );
-  void setMaxMovementTime( unsigned long maxMovementTimeSeconds );
-  void setAdjustmentPeriod( unsigned long adjustmentPeriodSeconds );
-  void setSamplingRate( unsigned long samplingRateMs );
-  void setBrightnessThreshold( int32_t thresholdOhms );
-  void setBrightnessFilterTimeConstant( float tauS );
-  void setReversalDeadTime( unsigned long ms );
-  void setMaxReversalTries( int tries );
-  void setReversalTimeLimit( unsigned long ms );
-  void setNightThreshold( int32_t thresholdOhms );
-  void setNightHysteresis( float hysteresisPercent );
-  void setNightDetectionTime( unsigned long detectionTimeSeconds );
-  void setDefaultWestMovementEnabled( bool enabled );
-  void setDefaultWestMovementTime( unsigned long ms );
-  void setUseAverageMovementTime( bool enabled );
-  void setMovementHistorySize( uint8_t size );
-  
-  // Monitor mode configuration
-  void setMonitorModeEnabled( bool enabled );
-  void setStartMoveThreshold( float thresholdPercent );
-  void setMinWaitTime( unsigned long waitTimeSeconds );
-  void setMonitorFilterTimeConstant( float tauS );
+  // Panel power source (optional)
+  void setPowerSensor( PowerSensor* powerSensor );
+  PowerSensor* getPowerSensor() const { return powerSensor; }
 
-  // Getters for configuration
-  float getTolerance() const { return tolerancePercent; }
-  unsigned long getMaxMovementTime() const { return maxMovementTimeMs / 1000UL; }
-  unsigned long getAdjustmentPeriod() const { return adjustmentPeriodMs / 1000UL; }
-  unsigned long getSamplingRate() const { return samplingRateMs; }
-  int32_t getBrightnessThreshold() const { return brightnessThresholdOhms; }
-  float getBrightnessFilterTimeConstant() const { return brightnessFilterTimeConstantS; }
-  unsigned long getReversalDeadTime() const { return reversalDeadTimeMs; }
-  int getMaxReversalTries() const { return maxReversalTries; }
-  unsigned long getReversalTimeLimit() const { return reversalTimeLimitMs; }
-  int32_t getNightThreshold() const { return nightThresholdOhms; }
-  float getNightHysteresis() const { return nightHysteresisPercent; }
-  unsigned long getNightDetectionTime() const { return nightDetectionTimeMs / 1000UL; }
-  bool getDefaultWestMovementEnabled() const { return defaultWestMovementEnabled; }
-  unsigned long getDefaultWestMovementTime() const { return defaultWestMovementMs; }
-  bool getUseAverageMovementTime() const { return useAverageMovementTime; }
-  uint8_t getMovementHistorySize() const { return movementHistorySize; }
-  
-  // Monitor mode getters
-  bool getMonitorModeEnabled() const { return monitorModeEnabled; }
-  float getStartMoveThreshold() const { return startMoveThresholdPercent; }
-  unsigned long getMinWaitTime() const { return minWaitTimeMs / 1000UL; }
-  float getMonitorFilterTimeConstant() const { return monitorFilterTimeConstantS; }
-  float getMonitorFilteredEast() const { return monitorFilteredEast; }
-  float getMonitorFilteredWest() const { return monitorFilteredWest; }
+  // Forget all learned shading, including the stored map
+  void clearShadingMap();
 
-  // Status
-  State getState() const;
-  bool isAdjusting() const;
-  bool isNightMode() const 
-  {
-    return state == NIGHT_MODE;
-  }
-  bool isDefaultWestMovement() const
-  {
-    return state == DEFAULT_WEST_MOVEMENT;
-  }
-  unsigned long getTimeUntilNextAdjustment() const;
-  float getFilteredBrightness() const 
-  {
-    return filteredBrightness;
-  }
-  unsigned long getAverageMovementTime() const;
-  unsigned long getTimeSinceLastStateChange() const;
-  unsigned long getLastMovementDuration() const;
-  unsigned long getTimeSinceLastDayNightTransition() const;
+  // Stall detection on every axis
+  void setStallDetectEnabled( bool enabled );
+
+  // Elevation axis (optional): a second core balancing the up/down sensors
+  // on its own motor; call before begin()
+  void setElevationAxis( TrackerCore* core, PhotoSensor* upSensor, PhotoSensor* downSensor,
+                         MotorControl* motorControl );
+  TrackerCore* getElevation() const { return elevation; }
+  MotorControl* getElevationMotor() const { return elevationMotor; }
+  void setElevationTolerance( float tolerancePercent );
+  void setElevationAdjustmentPeriod( unsigned long periodSeconds );
+  void setElevationMaxMovementTime( unsigned long maxMovementTimeSeconds );
+  void setMaxMotorsRunning( uint8_t motors );
+  float getElevationTolerance() const { return elevationTolerancePercent; }
+  unsigned long getElevationAdjustmentPeriod() const { return elevationPeriodSeconds; }
+  unsigned long getElevationMaxMovementTime() const { return elevationMaxMoveSeconds; }
+  uint8_t getMaxMotorsRunning() const { return maxMotorsRunning; }
+
+  // Extra tracker rows (optional): stepped in the same pass, sharing day/night
+  // and staggering every motor start; call before begin()
+  void setRows( TrackerRows* rows ) { this->rows = rows; }
+  TrackerRows* getRows() const { return rows; }
+
+  // Core step execution time (average over the last STEP_TIME_WINDOW steps)
+  static const uint16_t STEP_TIME_WINDOW = 1024;
+  unsigned long getStepTimeAverageUs() const { return stepTimeAverageUs; }
+  unsigned long getStepTimeMaxUs() const { return stepTimeMaxUs; }
 
 private:
-  State state;
   PhotoSensor* eastSensor;
   PhotoSensor* westSensor;
   MotorControl* motorControl;
+  PowerSensor* powerSensor;         // Panel power source (nullptr = not fitted)
+  uint8_t pendingSampleMask;        // Sensors that reported a sample since the last pair
 
-  // Configuration
-  float tolerancePercent;
-  unsigned long maxMovementTimeMs;
-  unsigned long adjustmentPeriodMs;
-  unsigned long samplingRateMs;
-  int32_t brightnessThresholdOhms;
-  float brightnessFilterTimeConstantS;
-  float filteredBrightness;
-
-  // Night mode configuration
-  int32_t nightThresholdOhms;
-  float nightHysteresisPercent;
-  unsigned long nightDetectionTimeMs;
-  unsigned long nightModeStartTime;
-  unsigned long dayModeStartTime;
-  bool nightConditionMet;
-  bool dayConditionMet;
-  unsigned long lastDayNightTransitionTime;
+  // Elevation axis (nullptr = single-axis)
+  TrackerCore* elevation;
+  PhotoSensor* upSensor;
+  PhotoSensor* downSensor;
+  MotorControl* elevationMotor;
+  float elevationTolerancePercent;
+  unsigned long elevationPeriodSeconds;
+  unsigned long elevationMaxMoveSeconds;
+  uint8_t maxMotorsRunning;         // Motors the supply can run at once
 
-  // Overshoot correction
-  unsigned long reversalDeadTimeMs; // ms to wait before reversing after overshoot
-  unsigned long reversalTimeLimitMs; // ms to limit each reversal movement
-  int maxReversalTries;             // max number of reversal attempts
-  int reversalTries;                // current reversal attempt count
-  unsigned long reversalWaitStartTime; // when dead time started
-  unsigned long reversalStartTime;     // when reversal movement started
-  bool waitingForReversal;          // are we in dead time before reversal?
-  bool reversalDirection;           // direction to move after reversal (true=east, false=west)
+  TrackerRows* rows;                // Extra rows (nullptr = single row)
+  unsigned long savedPositionStarts; // Motor start count when the position was last stored
 
-  // Default west movement configuration
-  bool defaultWestMovementEnabled;  // Whether to move west when brightness is low
-  unsigned long defaultWestMovementMs;  // How long to move west for
-  unsigned long defaultWestMovementStartTime;  // When the default west movement started
-  bool useAverageMovementTime;      // Whether to use average movement time for default west movement
-  uint8_t movementHistorySize;      // Number of past movements to track
-  unsigned long* movementHistory;    // Circular buffer of past movement durations
-  uint8_t movementHistoryIndex;     // Current index in circular buffer
-  uint8_t movementHistoryCount;     // Number of movements recorded
-  
-  // Monitor mode configuration
-  bool monitorModeEnabled;          // Whether monitor mode is enabled
-  float startMoveThresholdPercent;  // Percentage difference threshold to trigger movement
-  unsigned long minWaitTimeMs;      // Minimum time between monitor mode movements
-  float monitorFilterTimeConstantS; // Time constant for monitor mode filter
-  float monitorFilteredEast;        // Monitor mode filtered east sensor value
-  float monitorFilteredWest;        // Monitor mode filtered west sensor value
-  unsigned long lastMonitorSampleTime; // Last time monitor filters were updated
+  // Step timing
+  uint16_t stepTimeCount;           // Steps timed in the current window
+  unsigned long stepTimeSumUs;
+  unsigned long stepTimeAverageUs;  // Average of the last completed window
+  unsigned long stepTimeMaxUs;
 
-  // Timing
-  unsigned long lastAdjustmentTime;
-  unsigned long lastSamplingTime;
-  unsigned long movementStartTime;
-  unsigned long lastBrightnessSampleTime;
-  unsigned long lastStateChangeTime;
-  unsigned long lastMovementDuration;
-
-  // Overshoot detection
-  float initialEastValue;
-  float initialWestValue;
-  float initialDiff;
-  bool movementDirectionSet;
-  bool movingEast;
+  // Motor plan of each axis: command ids of the plan on the motor queue and
+  // the completions reported since the core last read them
+  struct PlanStatus
+  {
+    uint8_t ids[MOTOR_PLAN_STEPS];  // 0 = no command
+    uint8_t queueing;               // Command being queued, index + 1; 0 = none
+    uint8_t doneMask;
+    uint8_t refusedMask;
+  };
+  PlanStatus azimuthPlan;
+  PlanStatus elevationPlan;
 
-  // Helper methods
-  void initializeMovementHistory();
-  void cleanupMovementHistory();
-  void recordSuccessfulMovement( unsigned long duration );
-  void changeState( State newState );
+  static void onSampleReady( PhotoSensor* sensor, void* context );
+  void handleSampleReady( PhotoSensor* sensor );
+  static void onCommandDone( MotorControl* motor, uint8_t commandId, uint8_t result, void* context );
+  PlanStatus* getPlanStatus( const MotorControl* motor );
+  void applyMotorPlan( MotorControl* motor, const Outputs& outputs );
+  void readInputs( Inputs* inputs, PhotoSensor* east, PhotoSensor* west, MotorControl* motor,
+                   const TrackerCore* otherCore, const MotorControl* otherMotor );
+  void runStep( TrackerCore* core, MotorControl* motor, const Inputs& inputs );
+  void stepElevation( bool samplePair, unsigned long sampleMicros );
+  void configureElevation();
 };
 
-#endif // TRACKER_H
\ No newline at end of file
+#endif // TRACKER_H
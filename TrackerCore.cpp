@@ -0,0 +1,2208 @@
+#include "TrackerCore.h"
+#include <math.h>
+#include <string.h>
+
+// Every state change the tracker can make; anything else is a logic error
+const TrackerCore::Transition TrackerCore::TRANSITIONS[TrackerCore::TRANSITION_COUNT] PROGMEM =
+{
+  { IDLE, EVENT_NIGHT_DETECTED, NIGHT_MODE },
+  { IDLE, EVENT_ADJUSTMENT_DUE, ADJUSTING },
+  { IDLE, EVENT_CLIMB_DUE, HILL_CLIMBING },
+  { IDLE, EVENT_LOW_LIGHT_MOVE_DUE, DEFAULT_WEST_MOVEMENT },
+  { IDLE, EVENT_SEARCH_DUE, SUN_SEARCH },
+  { NIGHT_MODE, EVENT_DAY_DETECTED, IDLE },
+  { DEFAULT_WEST_MOVEMENT, EVENT_MOVE_COMPLETE, IDLE },
+  { ADJUSTING, EVENT_BALANCED, IDLE },
+  { ADJUSTING, EVENT_LOW_BRIGHTNESS, IDLE },
+  { ADJUSTING, EVENT_MAX_MOVE_TIME, IDLE },
+  { ADJUSTING, EVENT_NO_PROGRESS, IDLE },
+  { ADJUSTING, EVENT_REVERSALS_EXHAUSTED, IDLE },
+  { ADJUSTING, EVENT_START_DENIED, IDLE },
+  { SUN_SEARCH, EVENT_SEARCH_DONE, IDLE },
+  { SUN_SEARCH, EVENT_SEARCH_TIMEOUT, IDLE },
+  { SUN_SEARCH, EVENT_START_DENIED, IDLE },
+  { HILL_CLIMBING, EVENT_PEAK_REACHED, IDLE },
+  { HILL_CLIMBING, EVENT_LOW_BRIGHTNESS, IDLE },
+  { HILL_CLIMBING, EVENT_START_DENIED, IDLE },
+  { ADJUSTING, EVENT_STALL, IDLE },
+  { DEFAULT_WEST_MOVEMENT, EVENT_STALL, IDLE },
+  { SUN_SEARCH, EVENT_STALL, IDLE },
+  { HILL_CLIMBING, EVENT_STALL, IDLE },
+  { IDLE, EVENT_BACKTRACK_DUE, BACKTRACKING },
+  { BACKTRACKING, EVENT_TILT_REACHED, IDLE },
+  { BACKTRACKING, EVENT_MAX_MOVE_TIME, IDLE },
+  { BACKTRACKING, EVENT_STALL, IDLE },
+  { IDLE, EVENT_PLAN_DUE, PLANNED_MOVE },
+  { PLANNED_MOVE, EVENT_PLAN_DONE, IDLE },
+  { PLANNED_MOVE, EVENT_LOW_BRIGHTNESS, IDLE },
+  { PLANNED_MOVE, EVENT_START_DENIED, IDLE },
+  { PLANNED_MOVE, EVENT_STALL, IDLE }
+};
+
+// Event names stored in program memory, indexed by Event
+static const char EVENT_NAME_NIGHT_DETECTED[] PROGMEM = "Night detected";
+static const char EVENT_NAME_DAY_DETECTED[] PROGMEM = "Day detected";
+static const char EVENT_NAME_ADJUSTMENT_DUE[] PROGMEM = "Adjustment due";
+static const char EVENT_NAME_CLIMB_DUE[] PROGMEM = "Adjustment due, climbing power";
+static const char EVENT_NAME_LOW_LIGHT_MOVE_DUE[] PROGMEM = "Low light, using default movement";
+static const char EVENT_NAME_SEARCH_DUE[] PROGMEM = "Day mode entered, searching for sun";
+static const char EVENT_NAME_MOVE_COMPLETE[] PROGMEM = "Default movement completed";
+static const char EVENT_NAME_BALANCED[] PROGMEM = "Sensors balanced";
+static const char EVENT_NAME_LOW_BRIGHTNESS[] PROGMEM = "Brightness below threshold";
+static const char EVENT_NAME_MAX_MOVE_TIME[] PROGMEM = "Maximum movement time reached";
+static const char EVENT_NAME_NO_PROGRESS[] PROGMEM = "Reversal made no progress";
+static const char EVENT_NAME_REVERSALS_EXHAUSTED[] PROGMEM = "Reversal tries exhausted";
+static const char EVENT_NAME_START_DENIED[] PROGMEM = "Motor start limit reached";
+static const char EVENT_NAME_SEARCH_DONE[] PROGMEM = "Sun search completed";
+static const char EVENT_NAME_SEARCH_TIMEOUT[] PROGMEM = "Sun search timed out";
+static const char EVENT_NAME_PEAK_REACHED[] PROGMEM = "Power peak reached";
+static const char EVENT_NAME_STALL[] PROGMEM = "Motor stalled";
+static const char EVENT_NAME_BACKTRACK_DUE[] PROGMEM = "Adjustment due, backtracking";
+static const char EVENT_NAME_TILT_REACHED[] PROGMEM = "Backtracking tilt reached";
+static const char EVENT_NAME_PLAN_DUE[] PROGMEM = "Adjustment due, following plan";
+static const char EVENT_NAME_PLAN_DONE[] PROGMEM = "Planned move completed";
+
+static const char* const EVENT_NAMES[TrackerCore::EVENT_COUNT] PROGMEM =
+{
+  EVENT_NAME_NIGHT_DETECTED,
+  EVENT_NAME_DAY_DETECTED,
+  EVENT_NAME_ADJUSTMENT_DUE,
+  EVENT_NAME_CLIMB_DUE,
+  EVENT_NAME_LOW_LIGHT_MOVE_DUE,
+  EVENT_NAME_SEARCH_DUE,
+  EVENT_NAME_MOVE_COMPLETE,
+  EVENT_NAME_BALANCED,
+  EVENT_NAME_LOW_BRIGHTNESS,
+  EVENT_NAME_MAX_MOVE_TIME,
+  EVENT_NAME_NO_PROGRESS,
+  EVENT_NAME_REVERSALS_EXHAUSTED,
+  EVENT_NAME_START_DENIED,
+  EVENT_NAME_SEARCH_DONE,
+  EVENT_NAME_SEARCH_TIMEOUT,
+  EVENT_NAME_PEAK_REACHED,
+  EVENT_NAME_STALL,
+  EVENT_NAME_BACKTRACK_DUE,
+  EVENT_NAME_TILT_REACHED,
+  EVENT_NAME_PLAN_DUE,
+  EVENT_NAME_PLAN_DONE
+};
+
+// Used until a listener is set; ignores all log events
+static TrackerListener silentListener;
+
+TrackerCore::TrackerCore()
+  : state(IDLE),
+    listener(&silentListener),
+    tolerancePercent(TRACKER_TOLERANCE_PERCENT),
+    maxMovementTimeMs(TRACKER_MAX_MOVEMENT_TIME_SECONDS * 1000UL),
+    adjustmentPeriodMs(TRACKER_ADJUSTMENT_PERIOD_SECONDS * 1000UL),
+    samplingRateMs(TRACKER_SAMPLING_RATE_MS),
+    brightnessThresholdOhms(TRACKER_BRIGHTNESS_THRESHOLD_OHMS),
+    brightnessFilterTimeConstantS(TRACKER_BRIGHTNESS_FILTER_TIME_CONSTANT_S),
+    nightThresholdOhms(TRACKER_NIGHT_THRESHOLD_OHMS),
+    nightHysteresisPercent(TRACKER_NIGHT_HYSTERESIS_PERCENT),
+    nightDetectionTimeMs(TRACKER_NIGHT_DETECTION_TIME_SECONDS * 1000UL),
+    nightModeStartTime(0),
+    dayModeStartTime(0),
+    nightConditionMet(false),
+    dayConditionMet(false),
+    lastDayNightTransitionTime(0),
+    reversalDeadTimeMs(1000),
+    reversalTimeLimitMs(TRACKER_REVERSAL_TIME_LIMIT_MS),
+    maxReversalTries(3),
+    reversalTries(0),
+    reversalStartTime(0),
+    reversalDirection(false),
+    defaultWestMovementEnabled(TRACKER_ENABLE_DEFAULT_WEST_MOVEMENT),
+    defaultWestMovementMs(TRACKER_DEFAULT_WEST_MOVEMENT_MS),
+    defaultWestMovementStartTime(0),
+    useAverageMovementTime(TRACKER_USE_AVERAGE_MOVEMENT_TIME),
+    monitorModeEnabled(TRACKER_MONITOR_MODE_ENABLED),
+    startMoveThresholdPercent(TRACKER_START_MOVE_THRESHOLD_PERCENT),
+    minWaitTimeMs(TRACKER_MIN_WAIT_TIME_SECONDS * 1000UL),
+    monitorFilterTimeConstantS(TRACKER_MONITOR_FILTER_TIME_CONSTANT_S),
+    lastMonitorSampleTime(0),
+    adaptiveScheduleEnabled(TRACKER_ADAPTIVE_SCHEDULE_ENABLED),
+    adjustmentPeriodMinMs(TRACKER_ADJUSTMENT_PERIOD_MIN_SECONDS * 1000UL),
+    adjustmentPeriodMaxMs(TRACKER_ADJUSTMENT_PERIOD_MAX_SECONDS * 1000UL),
+    driftEstimateValid(false),
+    motorGainValid(false),
+    driftRateMsPerMin(0.0f),
+    motorMsPerPercent(0.0f),
+    lastSuccessfulMovementTime(0),
+    scheduledAdjustmentPeriodMs(TRACKER_ADJUSTMENT_PERIOD_SECONDS * 1000UL),
+    lastAdjustmentTime(0),
+    lastSamplingTime(0),
+    movementStartTime(0),
+    lastBrightnessSampleTime(0),
+    lastStateChangeTime(0),
+    invalidEventCount(0),
+    traceSequence(0),
+    lastMovementDuration(0),
+    initialEastValue(0),
+    initialWestValue(0),
+    initialDiff(0),
+    movementDirectionSet(false),
+    movingEast(false),
+    adjustmentDeferred(false),
+    suppressedAdjustmentCount(0),
+    deferredAdjustmentCount(0),
+    energyAwareEnabled(TRACKER_ENERGY_AWARE_ENABLED),
+    panelPowerW(TRACKER_PANEL_POWER_W),
+    motorPowerW(TRACKER_MOTOR_POWER_W),
+    degreesPerPercent(TRACKER_DEGREES_PER_PERCENT),
+    energyGainedMwh(0.0f),
+    pendingGainMwh(0.0f),
+    lastExpectedGainMwh(0.0f),
+    lastExpectedCostMwh(0.0f),
+    unprofitableSkipCount(0),
+    kalmanEnabled(TRACKER_KALMAN_ENABLED),
+    lastEstimatorTime(0),
+    motorPlanPending(false),
+    motorPlanSteps(0),
+    motorPlanDoneMask(0),
+    motorPlanRefused(false),
+    timedMoveWest(true),
+    timedMoveDurationMs(0),
+    sunSearchEnabled(TRACKER_SUN_SEARCH_ENABLED),
+    sunSearchSteps(TRACKER_SUN_SEARCH_STEPS),
+    sunSearchTimeoutMs(TRACKER_SUN_SEARCH_TIMEOUT_SECONDS * 1000UL),
+    sunSearchSpanMs(TRACKER_SUN_SEARCH_SPAN_SECONDS * 1000UL),
+    sunSearchFinalMove(false),
+    sunSearchProbes(0),
+    sunSearchStartTime(0),
+    sunSearchPositionMs(0),
+    sunSearchTargetMs(0),
+    sunSearchLowMs(0.0f),
+    sunSearchHighMs(0.0f),
+    sunSearchProbeIndex(0),
+    sunSearchBestMs(0),
+    sunSearchBestOhms(-1.0f),
+    lastSunSearchProbes(0),
+    lastSunSearchPositionMs(0),
+    trackingStrategy(TRACKER_STRATEGY),
+    hillClimbStepMs(TRACKER_HILL_CLIMB_STEP_MS),
+    hillClimbMaxSteps(TRACKER_HILL_CLIMB_MAX_STEPS),
+    hillClimbDeadbandPercent(TRACKER_HILL_CLIMB_DEADBAND_PERCENT),
+    hillClimbWest(true),
+    hillClimbImproved(false),
+    hillClimbReversed(false),
+    hillClimbReturning(false),
+    hillClimbSteps(0),
+    hillClimbStartPowerW(0.0f),
+    hillClimbBestPowerW(0.0f),
+    lastHillClimbSteps(0),
+    lastHillClimbGainW(0.0f),
+    plannedErrorBefore(0.0f),
+    plannedReversal(false),
+    plannedTakeUpMs(0),
+    plannedMoveCount(0),
+    plannerDeferCount(0),
+    dayStartEnergyWh(0.0f),
+    lastDayEnergyWh(0.0f),
+    startLimitDeferred(false),
+    startLimitedAdjustmentCount(0),
+    autoTuneEnabled(AUTOTUNE_ENABLED),
+    lowLightTolerancePercent(0.0f),
+    responseWatchActive(false),
+    responseWatchMoveStart(0),
+    responseBaselinePercent(0.0f),
+    shadingEnabled(SHADING_MAP_ENABLED),
+    shadingDeferred(false),
+    shadingDeferredCount(0),
+    supplyDeferred(false),
+    supplyDeferredCount(0),
+    stallJamCount(0),
+    stallEndStopCount(0),
+    backtrackTargetMdeg(0),
+    backtrackWest(false),
+    backtrackMoveCount(0),
+    stopLatencyCount(0),
+    stopLatencySumUs(0),
+    stopLatencyMaxUs(0)
+{
+  for( uint8_t i = 0; i < STOP_LATENCY_BUCKETS; i++ )
+  {
+    stopLatencyHistogram[i] = 0;
+  }
+  memset( transitionCounts, 0, sizeof( transitionCounts ));
+  memset( stateTimeMs, 0, sizeof( stateTimeMs ));
+  memset( trace, 0, sizeof( trace ));
+  memset( &in, 0, sizeof( in ));
+  memset( &out, 0, sizeof( out ));
+  memset( &lastPlan, 0, sizeof( lastPlan ));
+
+  // Fixed-point copies of the configuration used on every step
+  tolerancePpm = percentToPpm( tolerancePercent );
+  lowLightTolerancePpm = 0;
+  startMoveThresholdPpm = percentToPpm( startMoveThresholdPercent );
+  updateDayThreshold();
+  setBrightnessFilterTimeConstant( brightnessFilterTimeConstantS );
+  setMonitorFilterTimeConstant( monitorFilterTimeConstantS );
+  resetFilter( &filteredBrightness, 0 );  // Initialized with first sample in update()
+  resetFilter( &monitorFilteredEast, 0 );
+  resetFilter( &monitorFilteredWest, 0 );
+}
+
+void TrackerCore::begin( const Inputs& inputs )
+{
+  in = inputs;
+  unsigned long currentTime = in.timeMs;
+  lastAdjustmentTime = currentTime;
+  lastSamplingTime = currentTime;
+  lastStateChangeTime = currentTime;
+  lastDayNightTransitionTime = currentTime;
+  lastMonitorSampleTime = currentTime;
+  lastMovementDuration = 0;
+  state = IDLE;
+  reversalTries = 0;
+  reversalDirection = false;
+  motorPlanPending = false;
+  nightConditionMet = false;
+  dayConditionMet = false;
+  nightModeStartTime = 0;
+  dayModeStartTime = 0;
+  movementStats.reset();
+  lastSuccessfulMovementTime = 0;
+  resetFilter( &monitorFilteredEast, in.eastValue );  // Initialize monitor filters
+  resetFilter( &monitorFilteredWest, in.westValue );
+  adjustmentDeferred = false;
+  cloudDetector.reset();
+  sunEstimator.reset();
+}
+
+void TrackerCore::setListener( TrackerListener* listener )
+{
+  this->listener = ( listener != nullptr ) ? listener : &silentListener;
+}
+
+void TrackerCore::step( const Inputs& inputs, Outputs& outputs )
+{
+  in = inputs;
+  memset( &out, 0, sizeof( out ));
+  uint16_t firstSequence = traceSequence;
+
+  // Completions of the queued motor plan reported since the last step
+  if( motorPlanPending )
+  {
+    motorPlanDoneMask |= in.motorPlanDone;
+    if( in.motorPlanRefused != 0 )
+    {
+      motorPlanRefused = true;
+    }
+  }
+
+  // Stop decisions are made per sample pair, before the timed state machine
+  if( in.samplePair )
+  {
+    handleSamplePair();
+  }
+  updateStateMachine();
+
+  out.transitions = (uint8_t)( traceSequence - firstSequence );
+  outputs = out;
+}
+
+void TrackerCore::stopMotor()
+{
+  out.motorStop = true;
+  out.motorMove = MOTOR_NONE;
+  out.motorPlanLength = 0;
+  in.motorState = MotorControl::STOPPED;
+  motorPlanPending = false;
+}
+
+bool TrackerCore::moveMotor( bool east, MotorControl::StartPriority priority )
+{
+  // Mirrors MotorControl: running the other way goes through dead time,
+  // running this way is free, and a start from rest needs a token
+  MotorControl::State moving = east ? MotorControl::MOVING_EAST : MotorControl::MOVING_WEST;
+  if( in.motorState == moving )
+  {
+    return true;
+  }
+  // The supply budget is not MotorControl's to enforce, so a refused start is never sent;
+  // nor is a tracking start into a soft end limit, which MotorControl would refuse
+  if( in.motorState == MotorControl::STOPPED && priority == MotorControl::PRIORITY_TRIM &&
+      ( !in.supplyAvailable || ( east ? in.motorEastLimit : in.motorWestLimit )))
+  {
+    return false;
+  }
+  out.motorMove = east ? MOTOR_EAST : MOTOR_WEST;
+  out.motorPriority = priority;
+  if( in.motorState == MotorControl::STOPPED )
+  {
+    if( priority == MotorControl::PRIORITY_TRIM && !in.motorCanStart )
+    {
+      return false;
+    }
+    in.motorState = moving;
+  }
+  else
+  {
+    in.motorState = MotorControl::DEAD_TIME;
+  }
+  return true;
+}
+
+//***********************************************************
+//     Function Name: startMotorPlan
+//
+//     Inputs:
+//     - None
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Starts a motor plan from rest: the stop sent with it
+//       also drops whatever the motor still had queued. Commands
+//       are added with addMotorStep() and run by MotorControl's
+//       queue; the step reports each one as it finishes.
+//
+//***********************************************************
+void TrackerCore::startMotorPlan()
+{
+  stopMotor();
+  out.motorPriority = MotorControl::PRIORITY_TRIM;
+  motorPlanPending = true;
+  motorPlanSteps = 0;
+  motorPlanDoneMask = 0;
+  motorPlanRefused = false;
+}
+
+// A move the motor would refuse is never sent, as in moveMotor(); the plan
+// then ends at once as refused
+bool TrackerCore::addMotorStep( uint8_t move, unsigned long durationMs )
+{
+  if( !motorPlanPending || out.motorPlanLength >= MOTOR_PLAN_STEPS )
+  {
+    return false;
+  }
+  // The plan already starts with a plain stop
+  if( move == MOTOR_NONE && durationMs == 0 )
+  {
+    return true;
+  }
+  if( move != MOTOR_NONE &&
+      ( !in.supplyAvailable || !in.motorCanStart ||
+        ( move == MOTOR_EAST ? in.motorEastLimit : in.motorWestLimit )))
+  {
+    out.motorPlanLength = 0;
+    motorPlanPending = false;
+    motorPlanRefused = true;
+    return false;
+  }
+  out.motorPlan[out.motorPlanLength].move = move;
+  out.motorPlan[out.motorPlanLength].durationMs = durationMs;
+  out.motorPlanLength++;
+  motorPlanSteps = out.motorPlanLength;
+  return true;
+}
+
+bool TrackerCore::isMotorPlanDone() const
+{
+  return !motorPlanPending || motorPlanDoneMask == (uint8_t)(( 1 << motorPlanSteps ) - 1 );
+}
+
+// Overshoot: rest for the reversal dead time, then run the other way
+void TrackerCore::startReversal()
+{
+  reversalTries++;
+  movingEast = !movingEast;
+  reversalDirection = movingEast;
+  startMotorPlan();
+  if( addMotorStep( MOTOR_NONE, reversalDeadTimeMs ))
+  {
+    addMotorStep( movingEast ? MOTOR_EAST : MOTOR_WEST, 0 );
+  }
+}
+
+void TrackerCore::recordSuccessfulMovement( unsigned long duration )
+{
+  movementStats.record( duration, movingEast, (uint8_t)reversalTries );
+}
+
+void TrackerCore::updateDriftEstimate( unsigned long currentTime, unsigned long duration, float finalImbalancePercent )
+{
+  // Motor time per percent of imbalance removed by this movement
+  float initialLower = (( initialEastValue < initialWestValue ) ? initialEastValue : initialWestValue );
+  if( initialLower > 0.0f )
+  {
+    float initialImbalancePercent = ( fabs( initialDiff ) / initialLower ) * 100.0f;
+    float progressPercent = initialImbalancePercent - finalImbalancePercent;
+    if( progressPercent >= TRACKER_DRIFT_MIN_PROGRESS_PERCENT )
+    {
+      float gainSample = duration / progressPercent;
+      motorMsPerPercent = motorGainValid ?
+                          motorMsPerPercent + TRACKER_DRIFT_ESTIMATE_WEIGHT * ( gainSample - motorMsPerPercent ) :
+                          gainSample;
+      motorGainValid = true;
+    }
+  }
+
+  // Motor time needed per minute of elapsed time since the previous balance
+  if( lastSuccessfulMovementTime != 0 && currentTime > lastSuccessfulMovementTime )
+  {
+    float intervalMin = ( currentTime - lastSuccessfulMovementTime ) / 60000.0f;
+    float rateSample = ( movingEast ? -1.0f : 1.0f ) * ( duration / intervalMin );
+    driftRateMsPerMin = driftEstimateValid ?
+                        driftRateMsPerMin + TRACKER_DRIFT_ESTIMATE_WEIGHT * ( rateSample - driftRateMsPerMin ) :
+                        rateSample;
+    driftEstimateValid = motorGainValid;
+  }
+  lastSuccessfulMovementTime = currentTime;
+
+  if( !driftEstimateValid )
+  {
+    return;
+  }
+
+  // Predict when the accumulated imbalance will cross the balance tolerance
+  float errorRatePercentPerMin = driftRateMsPerMin / motorMsPerPercent;
+  float periodMs = ( errorRatePercentPerMin > 0.0f ) ?
+                   ( tolerancePercent / errorRatePercentPerMin ) * 60000.0f :
+                   (float)adjustmentPeriodMaxMs;
+  if( periodMs < (float)adjustmentPeriodMinMs ) periodMs = (float)adjustmentPeriodMinMs;
+  if( periodMs > (float)adjustmentPeriodMaxMs ) periodMs = (float)adjustmentPeriodMaxMs;
+  scheduledAdjustmentPeriodMs = (unsigned long)periodMs;
+}
+
+unsigned long TrackerCore::getEffectiveAdjustmentPeriod() const
+{
+  if( adaptiveScheduleEnabled && driftEstimateValid )
+  {
+    return scheduledAdjustmentPeriodMs;
+  }
+  return adjustmentPeriodMs;
+}
+
+unsigned long TrackerCore::getAverageMovementTime() const
+{
+  return movementStats.getAverage( defaultWestMovementMs );
+}
+
+void TrackerCore::setUseAverageMovementTime( bool enabled )
+{
+  useAverageMovementTime = enabled;
+}
+
+void TrackerCore::setMovementHistorySize( uint8_t size )
+{
+  if( size != movementStats.getWindowSize() )
+  {
+    movementStats.setWindowSize( size );
+  }
+}
+
+void TrackerCore::setMovementAverageMode( uint8_t mode )
+{
+  movementStats.setAverageMode( mode );
+}
+
+void TrackerCore::updateStateMachine()
+{
+  unsigned long currentTime = in.timeMs;
+  
+  // Update filtered brightness (EMA) - runs in all states
+  int32_t eastValue = in.eastValue;
+  int32_t westValue = in.westValue;
+  int32_t avgBrightness = ( eastValue + westValue ) / 2;
+
+  // Initialize or update EMA filter
+  if( lastBrightnessSampleTime == 0 )
+  {
+    // Initialize with first sample
+    resetFilter( &filteredBrightness, avgBrightness );
+    lastBrightnessSampleTime = currentTime;
+  }
+  else if( currentTime != lastBrightnessSampleTime )
+  {
+    unsigned long dtMs = currentTime - lastBrightnessSampleTime;
+    lastBrightnessSampleTime = currentTime;
+    updateFilter( &filteredBrightness, avgBrightness, dtMs,
+                  brightnessFilterTauMs, brightnessFilterAlphaQ32 );
+  }
+
+  // Update monitor mode filters - always run to maintain filter state
+  if( lastMonitorSampleTime == 0 )
+  {
+    // Initialize monitor filters with first sample
+    resetFilter( &monitorFilteredEast, eastValue );
+    resetFilter( &monitorFilteredWest, westValue );
+    lastMonitorSampleTime = currentTime;
+  }
+  else if( currentTime != lastMonitorSampleTime )
+  {
+    unsigned long dtMs = currentTime - lastMonitorSampleTime;
+    lastMonitorSampleTime = currentTime;
+    updateFilter( &monitorFilteredEast, eastValue, dtMs, monitorFilterTauMs, monitorFilterAlphaQ32 );
+    updateFilter( &monitorFilteredWest, westValue, dtMs, monitorFilterTauMs, monitorFilterAlphaQ32 );
+  }
+
+  int32_t brightnessOhms = filteredBrightness.part.ohms;
+  switch( state )
+  {
+    case IDLE:
+    {
+      // Check for night condition
+      if( brightnessOhms >= nightThresholdOhms )
+      {
+        if( !nightConditionMet )
+        {
+          nightConditionMet = true;
+          nightModeStartTime = currentTime;
+        }
+        else if( currentTime - nightModeStartTime >= nightDetectionTimeMs )
+        {
+          listener->logNightModeEntered( brightnessOhms, nightThresholdOhms );
+          lastDayNightTransitionTime = currentTime;
+          lastSuccessfulMovementTime = 0;  // Drift intervals must not span the night
+          if( autoTuneEnabled )
+          {
+            applyAutoTune();
+          }
+          autoTuner.reset();  // Each day is tuned from its own data
+          if( shadingMap.endDay() )
+          {
+            out.shadingMapChanged = true;
+          }
+          backtracker.endDay( currentTime );
+          if( in.powerValid )
+          {
+            lastDayEnergyWh = in.energyWh - dayStartEnergyWh;
+          }
+          handleEvent( EVENT_NIGHT_DETECTED );
+          stopMotor();
+          moveMotor( true, MotorControl::PRIORITY_SAFETY );  // Move to full east position
+          dayConditionMet = false;
+          dayModeStartTime = 0;
+          break;
+        }
+      }
+      else
+      {
+        nightConditionMet = false;
+        nightModeStartTime = 0;
+      }
+
+      // Ask each trigger in turn whether an adjustment is due
+      bool shouldAdjust = false;
+      bool isMonitorTriggered = false;
+      for( uint8_t i = 0; i < TRIGGER_COUNT && !shouldAdjust; i++ )
+      {
+        if(( this->*TRIGGERS[i].check )( currentTime ))
+        {
+          shouldAdjust = true;
+          isMonitorTriggered = TRIGGERS[i].monitorValues;
+        }
+      }
+
+      // Near sunrise and sunset the shade-free tilt replaces sensor balancing,
+      // so the sensor-based hold-offs below do not apply
+      if( shouldAdjust && in.panelTiltKnown && backtracker.isActive( currentTime ))
+      {
+        if( in.supplyAvailable && !deferForStartLimit() )
+        {
+          startBacktrack( currentTime );
+        }
+        break;
+      }
+
+      // Hold off while cloud transients make the sensor difference unreliable
+      if( shouldAdjust && !cloudDetector.isStable( currentTime ))
+      {
+        if( !adjustmentDeferred )
+        {
+          adjustmentDeferred = true;
+          listener->logAdjustmentDeferredCloud( cloudDetector.getBrightnessVariationPercent(),
+                                               cloudDetector.getDifferenceDeviationPercent() );
+        }
+        shouldAdjust = false;
+      }
+      else if( adjustmentDeferred )
+      {
+        adjustmentDeferred = false;
+        if( shouldAdjust )
+        {
+          if( deferredAdjustmentCount < UINT16_MAX ) deferredAdjustmentCount++;
+        }
+        else
+        {
+          if( suppressedAdjustmentCount < UINT16_MAX ) suppressedAdjustmentCount++;
+        }
+      }
+
+      // Hold off while a known obstruction shades one sensor
+      if( shouldAdjust && shadingEnabled &&
+          ( shadingMap.isAnomalyActive() || shadingMap.isShadingPredicted( currentTime )))
+      {
+        if( !shadingDeferred )
+        {
+          shadingDeferred = true;
+          if( shadingDeferredCount < UINT16_MAX ) shadingDeferredCount++;
+          listener->logAdjustmentDeferredShading( shadingMap.isShadingPredicted( currentTime ));
+        }
+        shouldAdjust = false;
+      }
+      else if( shouldAdjust )
+      {
+        shadingDeferred = false;
+      }
+
+      // Estimate yield gain versus motor energy; skip unprofitable corrections if enabled
+      if( shouldAdjust )
+      {
+        int32_t triggerEast = isMonitorTriggered ? monitorFilteredEast.part.ohms : eastValue;
+        int32_t triggerWest = isMonitorTriggered ? monitorFilteredWest.part.ohms : westValue;
+        if( !isAdjustmentWorthwhile( triggerEast, triggerWest ) && energyAwareEnabled )
+        {
+          listener->logAdjustmentSkippedUnprofitable( lastExpectedGainMwh, lastExpectedCostMwh );
+          if( unprofitableSkipCount < UINT16_MAX ) unprofitableSkipCount++;
+          lastAdjustmentTime = currentTime;  // Re-evaluate after another period
+          shouldAdjust = false;
+        }
+      }
+
+      // Wait while another axis is using the motor supply current
+      if( shouldAdjust && !in.supplyAvailable )
+      {
+        if( !supplyDeferred )
+        {
+          supplyDeferred = true;
+          if( supplyDeferredCount < UINT16_MAX ) supplyDeferredCount++;
+        }
+        shouldAdjust = false;
+      }
+      else if( shouldAdjust )
+      {
+        supplyDeferred = false;
+      }
+
+      // Trim moves wait for the motor start budget to refill
+      if( shouldAdjust && deferForStartLimit() )
+      {
+        shouldAdjust = false;
+      }
+
+      // Hand the adjustment to the selected strategy
+      if( shouldAdjust )
+      {
+        ( this->*getStrategy()->start )( currentTime, isMonitorTriggered );
+      }
+      break;
+    }
+
+    case DEFAULT_WEST_MOVEMENT:
+      {
+        unsigned long movementDuration = useAverageMovementTime ? 
+                                       getAverageMovementTime() : 
+                                       defaultWestMovementMs;
+        if( currentTime - defaultWestMovementStartTime >= movementDuration )
+        {
+          stopMotor();
+          defaultWestMovementStartTime = 0;
+          listener->logDefaultWestMovementCompleted();
+          handleEvent( EVENT_MOVE_COMPLETE );
+        }
+      }
+      break;
+
+    case NIGHT_MODE:
+    {
+      if( brightnessOhms <= dayThresholdOhms )
+      {
+        if( !dayConditionMet )
+        {
+          dayConditionMet = true;
+          dayModeStartTime = currentTime;
+        }
+        else if( currentTime - dayModeStartTime >= nightDetectionTimeMs )
+        {
+          listener->logDayModeEntered( brightnessOhms, dayThresholdOhms );
+          lastDayNightTransitionTime = currentTime;
+          handleEvent( EVENT_DAY_DETECTED );
+          stopMotor();
+          // Reset adjustment timer to start fresh when entering day mode
+          lastAdjustmentTime = currentTime;
+          nightConditionMet = false;
+          nightModeStartTime = 0;
+          if( in.powerValid )
+          {
+            dayStartEnergyWh = in.energyWh;
+          }
+          shadingMap.startDay( currentTime );
+          backtracker.startDay( currentTime );
+          // Panel is at full east; locate the brightest orientation before balancing
+          // unless backtracking holds it back from the sun
+          if( sunSearchEnabled && brightnessOhms < brightnessThresholdOhms &&
+              !backtracker.isActive( currentTime ))
+          {
+            startSunSearch( currentTime );
+          }
+          break;
+        }
+      }
+      else
+      {
+        dayConditionMet = false;
+        dayModeStartTime = 0;
+      }
+      // Remain in NIGHT_MODE, do not perform tracking or movement except move to east on entry
+      break;
+    }
+
+    case SUN_SEARCH:
+      updateSunSearch( currentTime );
+      break;
+
+    case HILL_CLIMBING:
+      updateHillClimb( currentTime );
+      break;
+
+    case BACKTRACKING:
+      updateBacktrack( currentTime );
+      break;
+
+    case PLANNED_MOVE:
+      updatePlannedMove( currentTime );
+      break;
+
+    case ADJUSTING:
+      // Check if maximum movement time exceeded
+      if( currentTime - movementStartTime >= maxMovementTimeMs )
+      {
+        stopMotor();
+        autoTuner.recordAbort();
+        handleEvent( EVENT_MAX_MOVE_TIME );
+      }
+      // Reversal queued on the motor: dead time, then the move the other way
+      else if( motorPlanPending )
+      {
+        if( isMotorPlanDone() )
+        {
+          motorPlanPending = false;
+          if( motorPlanRefused )
+          {
+            listener->logAdjustmentEndedStartLimit();
+            autoTuner.recordAbort();
+            handleEvent( EVENT_START_DENIED );
+          }
+          else
+          {
+            reversalStartTime = currentTime;
+            // Update initialDiff for new direction
+            initialDiff = getImbalanceDiff( eastValue, westValue );
+          }
+        }
+      }
+      // Check if reversal movement time limit exceeded
+      // Reversal moves get extra time to take up gear backlash before the panel moves
+      else if( reversalTries > 0 &&
+               currentTime - reversalStartTime >= reversalTimeLimitMs + in.motorTakeUpMs )
+      {
+        stopMotor();
+        int32_t currentDiff = getImbalanceDiff( eastValue, westValue );
+        int32_t lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+        int32_t tolerancePpm = getActiveTolerancePpm();
+
+        // Check if we've achieved balance or made meaningful progress
+        bool isBalanced = !exceedsPpm( currentDiff, lowerValue, tolerancePpm );
+        bool hasOvershot = haveOppositeSigns( currentDiff, initialDiff ) && !isBalanced;
+
+        // If not balanced and no overshoot, stop trying reversals
+        if( !isBalanced && !hasOvershot )
+        {
+          listener->logReversalAbortedNoProgress( movingEast, eastValue, westValue,
+                                                  lowerValue * getActiveTolerance() / 100.0f, initialDiff );
+          autoTuner.recordAbort();
+          handleEvent( EVENT_NO_PROGRESS );
+        }
+        // Otherwise continue with normal reversal logic
+        else if( reversalTries + 1 < maxReversalTries )
+        {
+          startReversal();
+        }
+        else
+        {
+          handleEvent( EVENT_REVERSALS_EXHAUSTED );
+        }
+      }
+      // Sampling rate only paces direction selection and motor commands;
+      // balance, overshoot and brightness checks run per sample in handleSamplePair()
+      else if( currentTime - lastSamplingTime >= samplingRateMs )
+      {
+        lastSamplingTime = currentTime;
+
+        // Determine movement direction if not set yet
+        if( !movementDirectionSet )
+        {
+          movingEast = ( getImbalanceDiff( eastValue, westValue ) < 0 );
+          reversalDirection = movingEast;
+          movementDirectionSet = true;
+        }
+
+        // Continue movement in current direction
+        bool started = movingEast ? moveMotor( true ) : moveMotor( false );
+        if( !started )
+        {
+          // Start budget spent (e.g. before a reversal); finish without moving
+          listener->logAdjustmentEndedStartLimit();
+          autoTuner.recordAbort();
+          handleEvent( EVENT_START_DENIED );
+        }
+      }
+      break;
+  }
+}
+
+// Adjustment triggers, checked in order until one fires
+const TrackerCore::AdjustmentTrigger TrackerCore::TRIGGERS[TrackerCore::TRIGGER_COUNT] =
+{
+  { &TrackerCore::checkMonitorTrigger, true },
+  { &TrackerCore::checkEstimateTrigger, false },
+  { &TrackerCore::checkPeriodicTrigger, false }
+};
+
+// Tracking strategies, indexed by TRACKER_STRATEGY_*
+const TrackerCore::TrackingStrategy TrackerCore::STRATEGIES[TrackerCore::STRATEGY_COUNT] =
+{
+  { "SENSOR_BALANCE", &TrackerCore::startBalanceAdjustment },
+  { "HILL_CLIMB", &TrackerCore::startPowerAdjustment },
+  { "PLANNED", &TrackerCore::startPlannedAdjustment }
+};
+
+const TrackerCore::TrackingStrategy* TrackerCore::getStrategy() const
+{
+#ifdef TRACKER_FIXED_STRATEGY
+  // Constant index lets the compiler resolve the call directly
+  return &STRATEGIES[TRACKER_FIXED_STRATEGY];
+#else
+  return &STRATEGIES[trackingStrategy < STRATEGY_COUNT ? trackingStrategy : TRACKER_STRATEGY_SENSOR_BALANCE];
+#endif
+}
+
+const char* TrackerCore::getTrackingStrategyName() const
+{
+  return getStrategy()->name;
+}
+
+bool TrackerCore::checkMonitorTrigger( unsigned long currentTime )
+{
+  if( !monitorModeEnabled || filteredBrightness.part.ohms >= brightnessThresholdOhms )
+  {
+    return false;
+  }
+
+  // Compare the monitor mode difference with the threshold share of the lower value
+  int32_t east = monitorFilteredEast.part.ohms;
+  int32_t west = monitorFilteredWest.part.ohms;
+  int32_t lowerValue = ( east < west ) ? east : west;
+  
+  // Check if difference exceeds threshold and minimum wait time has elapsed
+  return ( exceedsPpm( east - west, lowerValue, startMoveThresholdPpm ) && 
+           currentTime - lastAdjustmentTime >= minWaitTimeMs );
+}
+
+bool TrackerCore::checkEstimateTrigger( unsigned long currentTime )
+{
+  // Adjust once the estimated error exceeds tolerance with confidence
+  if( !useSunEstimate() || filteredBrightness.part.ohms >= brightnessThresholdOhms ||
+      currentTime - lastAdjustmentTime < minWaitTimeMs )
+  {
+    return false;
+  }
+  float margin = fabs( sunEstimator.getAngle() ) -
+                 ( TRACKER_KALMAN_CONFIDENCE_SIGMAS * sunEstimator.getUncertainty() );
+  return ( margin > getActiveTolerance() );
+}
+
+bool TrackerCore::checkPeriodicTrigger( unsigned long currentTime )
+{
+  if( currentTime - lastAdjustmentTime < getEffectiveAdjustmentPeriod() )
+  {
+    return false;
+  }
+  if( filteredBrightness.part.ohms < brightnessThresholdOhms )
+  {
+    return true;
+  }
+
+  // Too dark to balance: move west blind or skip this period
+  if( defaultWestMovementEnabled && in.supplyAvailable && !deferForStartLimit() )
+  {
+    // Calculate movement duration
+    unsigned long movementDuration = useAverageMovementTime ? 
+                                     getAverageMovementTime() : 
+                                     defaultWestMovementMs;
+    // Start default west movement
+    listener->logDefaultWestMovementStarted( filteredBrightness.part.ohms,
+                                            brightnessThresholdOhms,
+                                            movementDuration );
+    moveMotor( false );
+    defaultWestMovementStartTime = currentTime;
+    lastAdjustmentTime = currentTime;  // Start timing from when movement begins
+    handleEvent( EVENT_LOW_LIGHT_MOVE_DUE );
+  }
+  else if( !defaultWestMovementEnabled )
+  {
+    listener->logAdjustmentSkippedLowBrightness( filteredBrightness.part.ohms,
+                                                brightnessThresholdOhms );
+    lastAdjustmentTime = currentTime;  // Start timing from when adjustment was skipped
+  }
+  return false;
+}
+
+void TrackerCore::startBalanceAdjustment( unsigned long currentTime, bool isMonitorTriggered )
+{
+  handleEvent( EVENT_ADJUSTMENT_DUE );
+  autoTuner.recordAdjustmentStart( currentTime );
+  lastSamplingTime = currentTime;
+  movementStartTime = currentTime;
+  lastAdjustmentTime = currentTime;  // Start timing from when adjustment begins
+  
+  // Store initial sensor values for overshoot detection
+  // Use monitor filtered values if monitor mode triggered the adjustment
+  if( isMonitorTriggered )
+  {
+    initialEastValue = monitorFilteredEast.part.ohms;
+    initialWestValue = monitorFilteredWest.part.ohms;
+  }
+  else
+  {
+    initialEastValue = in.eastValue;
+    initialWestValue = in.westValue;
+  }
+  initialDiff = getImbalanceDiff( initialEastValue, initialWestValue );
+  movementDirectionSet = false;
+}
+
+void TrackerCore::startPowerAdjustment( unsigned long currentTime, bool isMonitorTriggered )
+{
+  if( !in.powerValid )
+  {
+    // Nothing to climb on; balance the sensors instead
+    startBalanceAdjustment( currentTime, isMonitorTriggered );
+    return;
+  }
+
+  // Perturb and observe panel power instead of balancing the sensors
+  lastAdjustmentTime = currentTime;
+  startHillClimb();
+}
+
+//***********************************************************
+//     Function Name: startPlannedAdjustment
+//
+//     Inputs:
+//     - currentTime : Current time in milliseconds
+//     - isMonitorTriggered : Use the monitor filtered values
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Scores the candidate plans with the current imbalance and
+//       the energy model and starts a timed move if the cheapest
+//       plan moves now; otherwise waits for the next opportunity.
+//       Sensor balancing runs instead until a motor gain is known
+//       (it also seeds the planner) and in low light.
+//
+//***********************************************************
+void TrackerCore::startPlannedAdjustment( unsigned long currentTime, bool isMonitorTriggered )
+{
+  int32_t eastValue = isMonitorTriggered ? monitorFilteredEast.part.ohms : in.eastValue;
+  int32_t westValue = isMonitorTriggered ? monitorFilteredWest.part.ohms : in.westValue;
+  int32_t lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  if( motorGainValid )
+  {
+    planner.seedGain( motorMsPerPercent );
+    if( driftEstimateValid )
+    {
+      planner.seedDrift( driftRateMsPerMin / motorMsPerPercent );
+    }
+  }
+  if( !planner.isGainValid() || lowerValue <= 0 ||
+      filteredBrightness.part.ohms >= brightnessThresholdOhms )
+  {
+    startBalanceAdjustment( currentTime, isMonitorTriggered );
+    return;
+  }
+
+  lastAdjustmentTime = currentTime;
+  float errorPercent = ( eastValue - westValue ) * 100.0f / lowerValue;
+  planner.observe( errorPercent, in.motorRunTimeMs, currentTime );
+
+  // Yield lost to misalignment as in isAdjustmentWorthwhile, with
+  // 1 - cos(x) taken as x^2 / 2 for the small errors between adjustments
+  float lightFraction = TRACKER_FULL_SUN_OHMS / (float)(( eastValue + westValue ) / 2 );
+  if( lightFraction > 1.0f ) lightFraction = 1.0f;
+  float radiansPerPercent = degreesPerPercent * ( PI / 180.0f );
+  MotionPlanner::Model model;
+  model.errorPercent = errorPercent;
+  model.stepMinutes = getEffectiveAdjustmentPeriod() / 60000.0f;
+  model.lossMwhPerPercentSqMin = panelPowerW * lightFraction * 0.5f * radiansPerPercent * radiansPerPercent *
+                                 ( 1000.0f / 60.0f );
+  model.motorMwhPerMs = motorPowerW / 3600.0f;
+  model.startCostMwh = TRACKER_PLANNER_START_COST_MWH;
+  model.maxMoveMs = maxMovementTimeMs;
+  lastPlan = planner.plan( model );
+  listener->logMovePlanned( lastPlan.delaySteps, lastPlan.west, lastPlan.durationMs,
+                            lastPlan.costMwh, lastPlan.idleCostMwh );
+
+  if( lastPlan.delaySteps > 0 || lastPlan.durationMs == 0 )
+  {
+    if( plannerDeferCount < UINT16_MAX ) plannerDeferCount++;
+    return;
+  }
+  handleEvent( EVENT_PLAN_DUE );
+  plannedErrorBefore = errorPercent;
+  plannedReversal = false;
+  plannedTakeUpMs = 0;
+  startTimedMove( lastPlan.west, lastPlan.durationMs, TRACKER_PLANNER_SETTLE_MS );
+}
+
+void TrackerCore::updatePlannedMove( unsigned long currentTime )
+{
+  if( filteredBrightness.part.ohms >= brightnessThresholdOhms )
+  {
+    abortTimedMove( currentTime );
+    handleEvent( EVENT_LOW_BRIGHTNESS );
+    return;
+  }
+
+  // Take-up is only reported while the move runs
+  if( motorPlanPending && ( motorPlanDoneMask & 0x01 ) == 0 &&
+      ( in.motorState == MotorControl::MOVING_EAST || in.motorState == MotorControl::MOVING_WEST ))
+  {
+    plannedTakeUpMs = in.motorTakeUpMs;
+    plannedReversal = in.motorReversalMove;
+  }
+  if( !isMotorPlanDone() )
+  {
+    return;
+  }
+  if( motorPlanRefused )
+  {
+    handleEvent( EVENT_START_DENIED );
+    return;
+  }
+
+  // The settled imbalance teaches the planner its gain and restarts the drift interval
+  int32_t lowerValue = (( in.eastValue < in.westValue ) ? in.eastValue : in.westValue );
+  if( lowerValue > 0 )
+  {
+    float errorAfter = ( in.eastValue - in.westValue ) * 100.0f / lowerValue;
+    planner.recordMove( plannedErrorBefore, errorAfter, timedMoveDurationMs, timedMoveWest,
+                        plannedTakeUpMs, plannedReversal, in.motorRunTimeMs, currentTime );
+  }
+  if( plannedMoveCount < UINT16_MAX ) plannedMoveCount++;
+  handleEvent( EVENT_PLAN_DONE );
+}
+
+void TrackerCore::handleSamplePair()
+{
+  cloudDetector.addSample( in.eastValue, in.westValue, in.timeMs );
+  autoTuner.addSample( in.eastValue, in.westValue,
+                       state == IDLE && in.motorState == MotorControl::STOPPED );
+  updateResponseWatch( in.eastValue, in.westValue, in.timeMs );
+  updateStallDetector( in.eastValue, in.westValue, in.timeMs );
+  shadingMap.addSample( in.eastValue, in.westValue,
+                        in.motorState == MotorControl::STOPPED, in.timeMs );
+  if( kalmanEnabled )
+  {
+    updateSunEstimator( in.eastValue, in.westValue, in.timeMs );
+  }
+
+  if( state == ADJUSTING && !motorPlanPending )
+  {
+    evaluateStopConditions( in.timeMs, in.sampleMicros );
+  }
+}
+
+bool TrackerCore::evaluateStopConditions( unsigned long currentTime, unsigned long sampleMicros )
+{
+  int32_t eastValue = in.eastValue;
+  int32_t westValue = in.westValue;
+  int32_t lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  int32_t tolerancePpm = getActiveTolerancePpm();
+  int32_t currentDiff = getImbalanceDiff( eastValue, westValue );
+  bool isBalanced = !exceedsPpm( currentDiff, lowerValue, tolerancePpm );
+
+  // Stop movement if filtered brightness falls below threshold
+  if( filteredBrightness.part.ohms >= brightnessThresholdOhms )
+  {
+    stopMotor();
+    recordStopLatency( sampleMicros );
+    listener->logAdjustmentAbortedLowBrightness( filteredBrightness.part.ohms, brightnessThresholdOhms );
+    autoTuner.recordAbort();
+    handleEvent( EVENT_LOW_BRIGHTNESS );
+    return true;
+  }
+
+  // Check if sensors are balanced within tolerance
+  if( isBalanced )
+  {
+    stopMotor();
+    recordStopLatency( sampleMicros );
+    // Record successful movement duration
+    unsigned long movementDuration = currentTime - movementStartTime;
+    lastMovementDuration = movementDuration;
+    recordSuccessfulMovement( movementDuration );
+    if( reversalTries == 0 )
+    {
+      // Only single-direction moves give a clean drift and gain sample
+      updateDriftEstimate( currentTime, movementDuration, ( abs( currentDiff ) / (float)lowerValue ) * 100.0f );
+    }
+    listener->logSuccessfulMovement( movementDuration, movingEast );
+    autoTuner.recordBalanced( currentTime );
+    energyGainedMwh += pendingGainMwh;
+    pendingGainMwh = 0.0f;
+    handleEvent( EVENT_BALANCED );
+    return true;
+  }
+
+  // Overshoot is only possible once the motor has been commanded
+  if( movementDirectionSet && haveOppositeSigns( currentDiff, initialDiff ))
+  {
+    stopMotor();
+    recordStopLatency( sampleMicros );
+    listener->logOvershootDetected( movingEast, eastValue, westValue,
+                                    lowerValue * getActiveTolerance() / 100.0f );
+    autoTuner.recordReversal();
+    if( reversalTries + 1 < maxReversalTries )
+    {
+      startReversal();
+    }
+    else
+    {
+      handleEvent( EVENT_REVERSALS_EXHAUSTED );
+    }
+    return true;
+  }
+
+  // Close to balance the motor may slow down so it does not coast past
+  if( movementDirectionSet &&
+      !exceedsPpm( currentDiff, lowerValue, tolerancePpm * TRACKER_APPROACH_TOLERANCE_MULTIPLE ))
+  {
+    out.motorApproach = true;
+  }
+
+  return false;
+}
+
+void TrackerCore::updateSunEstimator( float eastValue, float westValue, unsigned long currentTime )
+{
+  float lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  if( lowerValue <= 0.0f )
+  {
+    return;
+  }
+
+  if( sunEstimator.isInitialized() )
+  {
+    // Known motor motion over the interval; moving west reduces a positive (sun west) error
+    float dtMs = (float)( currentTime - lastEstimatorTime );
+    float msPerPercent = motorGainValid ? motorMsPerPercent : TRACKER_KALMAN_DEFAULT_MS_PER_PERCENT;
+    float motorPercent = 0.0f;
+    MotorControl::State motorState = in.motorState;
+    if( motorState == MotorControl::MOVING_WEST )
+    {
+      motorPercent = -dtMs / msPerPercent;
+    }
+    else if( motorState == MotorControl::MOVING_EAST )
+    {
+      motorPercent = dtMs / msPerPercent;
+    }
+    sunEstimator.predict( dtMs / 1000.0f, motorPercent );
+  }
+  lastEstimatorTime = currentTime;
+
+  sunEstimator.correct((( eastValue - westValue ) / lowerValue ) * 100.0f );
+}
+
+bool TrackerCore::useSunEstimate() const
+{
+  // Fall back to raw sensor values until the estimate is tighter than the tolerance
+  return kalmanEnabled && sunEstimator.isInitialized() &&
+         ( sunEstimator.getUncertainty() < getActiveTolerance() );
+}
+
+int32_t TrackerCore::getImbalanceDiff( int32_t eastValue, int32_t westValue ) const
+{
+  if( !useSunEstimate() )
+  {
+    return ( eastValue - westValue );
+  }
+  // Express the estimated imbalance in ohms so it compares with the ohm tolerance
+  int32_t lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  return (int32_t)( sunEstimator.getAngle() * lowerValue / 100.0f );
+}
+
+float TrackerCore::getFilterValue( const FixedFilter& filter )
+{
+  return (float)filter.q32 * ( 1.0f / 4294967296.0f );
+}
+
+void TrackerCore::resetFilter( FixedFilter* filter, int32_t ohms )
+{
+  filter->part.fraction = 0;
+  filter->part.ohms = ohms;
+}
+
+void TrackerCore::updateFilter( FixedFilter* filter, int32_t sampleOhms, unsigned long dtMs,
+                                unsigned long tauMs, uint32_t alphaPerMsQ32 )
+{
+  if( dtMs >= tauMs )
+  {
+    // Weight would reach 1.0; take the sample directly
+    resetFilter( filter, sampleOhms );
+    return;
+  }
+
+  // dtMs < tauMs keeps the weight below 1.0, so it fits in Q0.32
+  uint32_t alphaQ32 = dtMs * alphaPerMsQ32;
+  int32_t delta = sampleOhms - filter->part.ohms;
+  if( delta >= 0 )
+  {
+    filter->q32 += (int64_t)((uint64_t)(uint32_t)delta * alphaQ32 );
+  }
+  else
+  {
+    filter->q32 -= (int64_t)((uint64_t)(uint32_t)( -delta ) * alphaQ32 );
+  }
+}
+
+unsigned long TrackerCore::getFilterTauMs( float tauS )
+{
+  return ( tauS > 0.0f ) ? (unsigned long)( tauS * 1000.0f + 0.5f ) : 0;
+}
+
+uint32_t TrackerCore::getFilterAlphaPerMs( unsigned long tauMs )
+{
+  // 1/tau per millisecond in Q0.32; a 1 ms time constant always takes the sample
+  return ( tauMs > 1 ) ? (uint32_t)( 0xFFFFFFFFUL / tauMs ) : 0;
+}
+
+int32_t TrackerCore::percentToPpm( float percent )
+{
+  return (int32_t)( percent * 10000.0f + 0.5f );
+}
+
+bool TrackerCore::exceedsPpm( int32_t diffOhms, int32_t referenceOhms, int32_t ppm )
+{
+  // |diff| / reference > ppm / 1e6, without the division
+  int32_t magnitude = ( diffOhms < 0 ) ? -diffOhms : diffOhms;
+  return (int64_t)magnitude * 1000000L > (int64_t)referenceOhms * ppm;
+}
+
+bool TrackerCore::haveOppositeSigns( int32_t a, int32_t b )
+{
+  return ( a < 0 && b > 0 ) || ( a > 0 && b < 0 );
+}
+
+bool TrackerCore::isAdjustmentWorthwhile( float eastValue, float westValue )
+{
+  float lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  float avgBrightness = ( eastValue + westValue ) / 2.0f;
+  if( lowerValue <= 0.0f || avgBrightness <= 0.0f )
+  {
+    return false;
+  }
+  float imbalancePercent = ( fabs( eastValue - westValue ) / lowerValue ) * 100.0f;
+
+  // Yield lost to misalignment scales with (1 - cos(angle error)) and available light
+  float angleErrorRad = imbalancePercent * degreesPerPercent * ( PI / 180.0f );
+  float lightFraction = TRACKER_FULL_SUN_OHMS / avgBrightness;
+  if( lightFraction > 1.0f ) lightFraction = 1.0f;
+  float gainW = panelPowerW * lightFraction * ( 1.0f - cos( angleErrorRad ));
+  float horizonH = getEffectiveAdjustmentPeriod() / 3600000.0f;
+  lastExpectedGainMwh = gainW * horizonH * 1000.0f;
+
+  // Motor time learned from past movements: drift gain if known, else average duration
+  float expectedMotorMs = motorGainValid ?
+                          imbalancePercent * motorMsPerPercent :
+                          (float)getAverageMovementTime();
+  lastExpectedCostMwh = motorPowerW * ( expectedMotorMs / 3600000.0f ) * 1000.0f;
+
+  pendingGainMwh = lastExpectedGainMwh;
+  return lastExpectedGainMwh >= lastExpectedCostMwh;
+}
+
+float TrackerCore::getEnergySpentMoving() const
+{
+  return motorPowerW * ( in.motorRunTimeMs / 3600000.0f ) * 1000.0f;
+}
+
+void TrackerCore::recordStopLatency( unsigned long sampleMicros )
+{
+  unsigned long latencyUs = in.timeUs - sampleMicros;
+
+  uint8_t bucket = 0;
+  while( bucket < STOP_LATENCY_BUCKETS - 1 && latencyUs > getStopLatencyBucketLimitUs( bucket ) )
+  {
+    bucket++;
+  }
+  if( stopLatencyHistogram[bucket] < UINT16_MAX )
+  {
+    stopLatencyHistogram[bucket]++;
+  }
+
+  if( stopLatencyCount < UINT16_MAX )
+  {
+    stopLatencyCount++;
+    stopLatencySumUs += latencyUs;
+  }
+  if( latencyUs > stopLatencyMaxUs )
+  {
+    stopLatencyMaxUs = latencyUs;
+  }
+}
+
+unsigned long TrackerCore::getStopLatencyBucketLimitUs( uint8_t bucket )
+{
+  // Upper bound of each histogram bucket; the last bucket is open-ended
+  static const unsigned long limitsUs[STOP_LATENCY_BUCKETS] = {
+    500UL, 1000UL, 2000UL, 5000UL, 10000UL, 20000UL, 50000UL, 100000UL, 0xFFFFFFFFUL
+  };
+  return ( bucket < STOP_LATENCY_BUCKETS ) ? limitsUs[bucket] : limitsUs[STOP_LATENCY_BUCKETS - 1];
+}
+
+uint16_t TrackerCore::getStopLatencyBucketCount( uint8_t bucket ) const
+{
+  return ( bucket < STOP_LATENCY_BUCKETS ) ? stopLatencyHistogram[bucket] : 0;
+}
+
+unsigned long TrackerCore::getStopLatencyAverageUs() const
+{
+  return ( stopLatencyCount > 0 ) ? ( stopLatencySumUs / stopLatencyCount ) : 0;
+}
+
+void TrackerCore::setTolerance( float tolerancePercent )
+{
+  if( tolerancePercent >= 0.0f && tolerancePercent <= 100.0f )
+  {
+    this->tolerancePercent = tolerancePercent;
+    tolerancePpm = percentToPpm( tolerancePercent );
+  }
+}
+
+void TrackerCore::setMaxMovementTime( unsigned long maxMovementTimeSeconds )
+{
+  maxMovementTimeMs = maxMovementTimeSeconds * 1000UL;
+}
+
+void TrackerCore::setAdjustmentPeriod( unsigned long adjustmentPeriodSeconds )
+{
+  adjustmentPeriodMs = adjustmentPeriodSeconds * 1000UL;
+}
+
+void TrackerCore::setSamplingRate( unsigned long samplingRateMs )
+{
+  this->samplingRateMs = samplingRateMs;
+}
+
+void TrackerCore::setNightThreshold(int32_t thresholdOhms)
+{
+  if( thresholdOhms > brightnessThresholdOhms )
+  {
+    nightThresholdOhms = thresholdOhms;
+    updateDayThreshold();
+  }
+}
+
+void TrackerCore::setNightHysteresis(float hysteresisPercent)
+{
+  if( hysteresisPercent >= 0.0f && hysteresisPercent <= 100.0f )
+  {
+    nightHysteresisPercent = hysteresisPercent;
+    updateDayThreshold();
+  }
+}
+
+void TrackerCore::updateDayThreshold()
+{
+  dayThresholdOhms = (int32_t)( nightThresholdOhms * ( 1.0f - nightHysteresisPercent / 100.0f ));
+}
+
+void TrackerCore::setNightDetectionTime(unsigned long detectionTimeSeconds)
+{
+  nightDetectionTimeMs = detectionTimeSeconds * 1000UL;
+}
+
+void TrackerCore::setBrightnessThreshold(int32_t thresholdOhms)
+{
+  if( thresholdOhms < nightThresholdOhms )
+  {
+    brightnessThresholdOhms = thresholdOhms;
+  }
+}
+
+void TrackerCore::setBrightnessFilterTimeConstant( float tauS )
+{
+  brightnessFilterTimeConstantS = tauS;
+  brightnessFilterTauMs = getFilterTauMs( tauS );
+  brightnessFilterAlphaQ32 = getFilterAlphaPerMs( brightnessFilterTauMs );
+}
+
+void TrackerCore::setReversalDeadTime(unsigned long ms)
+{
+  reversalDeadTimeMs = ms;
+}
+
+void TrackerCore::setMaxReversalTries(int tries)
+{
+  maxReversalTries = tries;
+}
+
+void TrackerCore::setReversalTimeLimit(unsigned long ms)
+{
+  reversalTimeLimitMs = ms;
+}
+
+void TrackerCore::setDefaultWestMovementEnabled(bool enabled)
+{
+  defaultWestMovementEnabled = enabled;
+}
+
+void TrackerCore::setDefaultWestMovementTime(unsigned long ms)
+{
+  defaultWestMovementMs = ms;
+}
+
+void TrackerCore::setMonitorModeEnabled( bool enabled )
+{
+  monitorModeEnabled = enabled;
+}
+
+void TrackerCore::setStartMoveThreshold( float thresholdPercent )
+{
+  startMoveThresholdPercent = thresholdPercent;
+  startMoveThresholdPpm = percentToPpm( thresholdPercent );
+}
+
+void TrackerCore::setMinWaitTime( unsigned long waitTimeSeconds )
+{
+  minWaitTimeMs = waitTimeSeconds * 1000UL;
+}
+
+void TrackerCore::setMonitorFilterTimeConstant( float tauS )
+{
+  monitorFilterTimeConstantS = tauS;
+  monitorFilterTauMs = getFilterTauMs( tauS );
+  monitorFilterAlphaQ32 = getFilterAlphaPerMs( monitorFilterTauMs );
+}
+
+void TrackerCore::setAdaptiveScheduleEnabled( bool enabled )
+{
+  adaptiveScheduleEnabled = enabled;
+}
+
+void TrackerCore::setAdjustmentPeriodMin( unsigned long periodSeconds )
+{
+  adjustmentPeriodMinMs = periodSeconds * 1000UL;
+}
+
+void TrackerCore::setAdjustmentPeriodMax( unsigned long periodSeconds )
+{
+  adjustmentPeriodMaxMs = periodSeconds * 1000UL;
+}
+
+void TrackerCore::setEnergyAwareEnabled( bool enabled )
+{
+  energyAwareEnabled = enabled;
+}
+
+void TrackerCore::setPanelPower( float watts )
+{
+  if( watts > 0.0f )
+  {
+    panelPowerW = watts;
+  }
+}
+
+void TrackerCore::setMotorPower( float watts )
+{
+  if( watts > 0.0f )
+  {
+    motorPowerW = watts;
+  }
+}
+
+void TrackerCore::setDegreesPerPercent( float degrees )
+{
+  if( degrees > 0.0f )
+  {
+    degreesPerPercent = degrees;
+  }
+}
+
+// Queues the move and the settle hold after it; the motor ends the move on time
+void TrackerCore::startTimedMove( bool west, unsigned long durationMs, unsigned long settleMs )
+{
+  timedMoveWest = west;
+  timedMoveDurationMs = durationMs;
+  startMotorPlan();
+  if( durationMs > 0 && !addMotorStep( west ? MOTOR_WEST : MOTOR_EAST, durationMs ))
+  {
+    return;
+  }
+  // Let the sensor filters follow the new orientation before sampling
+  addMotorStep( MOTOR_NONE, settleMs );
+}
+
+// Stops the plan; returns the run time of the timed move made so far
+unsigned long TrackerCore::abortTimedMove( unsigned long currentTime )
+{
+  unsigned long travelled = motorPlanRefused ? 0 : timedMoveDurationMs;
+  if( motorPlanPending && ( motorPlanDoneMask & 0x01 ) == 0 )
+  {
+    // Not finished: the panel only turns once the take-up is done
+    travelled = 0;
+    unsigned long takeUp = in.motorTakeUpMs;
+    bool running = ( in.motorState == MotorControl::MOVING_EAST ||
+                     in.motorState == MotorControl::MOVING_WEST );
+    if( running && currentTime - in.motorMoveStartTime > takeUp )
+    {
+      travelled = currentTime - in.motorMoveStartTime - takeUp;
+      if( travelled > timedMoveDurationMs ) travelled = timedMoveDurationMs;
+    }
+  }
+  stopMotor();
+  return travelled;
+}
+
+void TrackerCore::startSunSearch( unsigned long currentTime )
+{
+  handleEvent( EVENT_SEARCH_DUE );
+  sunSearchStartTime = currentTime;
+  sunSearchProbes = 0;
+  sunSearchPositionMs = 0;
+  sunSearchFinalMove = false;
+  sunSearchBestMs = 0;
+  sunSearchBestOhms = -1.0f;
+
+  // Initial bracket is the whole span with both golden-section points unmeasured
+  sunSearchLowMs = 0.0f;
+  sunSearchHighMs = (float)sunSearchSpanMs;
+  float step = TRACKER_GOLDEN_RATIO_CONJUGATE * ( sunSearchHighMs - sunSearchLowMs );
+  sunSearchProbeMs[0] = sunSearchHighMs - step;
+  sunSearchProbeMs[1] = sunSearchLowMs + step;
+  sunSearchProbeValid[0] = false;
+  sunSearchProbeValid[1] = false;
+
+  listener->logSunSearchStarted( sunSearchSpanMs, sunSearchSteps );
+
+  selectNextSunSearchProbe( currentTime );
+}
+
+void TrackerCore::updateSunSearch( unsigned long currentTime )
+{
+  // Give up at the current position when the search runs too long
+  if( !sunSearchFinalMove && currentTime - sunSearchStartTime >= sunSearchTimeoutMs )
+  {
+    unsigned long travelled = abortTimedMove( currentTime );
+    if( sunSearchTargetMs > sunSearchPositionMs )
+    {
+      sunSearchPositionMs += travelled;
+    }
+    else
+    {
+      sunSearchPositionMs -= travelled;
+    }
+    finishSunSearch( currentTime, true );
+    return;
+  }
+
+  if( !isMotorPlanDone() )
+  {
+    return;
+  }
+  if( motorPlanRefused )
+  {
+    listener->logAdjustmentEndedStartLimit();
+    finishSunSearch( currentTime, true );
+    return;
+  }
+  sunSearchPositionMs = sunSearchTargetMs;
+
+  if( sunSearchFinalMove )
+  {
+    // Hand over to normal balancing on the next update
+    handleEvent( EVENT_SEARCH_DONE );
+    lastAdjustmentTime = currentTime - getEffectiveAdjustmentPeriod();
+    return;
+  }
+
+  // Lower resistance is brighter; east + west tracks total light on the panel
+  float totalOhms = in.eastValue + in.westValue;
+  sunSearchProbeOhms[sunSearchProbeIndex] = totalOhms;
+  sunSearchProbeValid[sunSearchProbeIndex] = true;
+  sunSearchProbes++;
+  if( sunSearchBestOhms < 0.0f || totalOhms < sunSearchBestOhms )
+  {
+    sunSearchBestOhms = totalOhms;
+    sunSearchBestMs = sunSearchPositionMs;
+  }
+
+  listener->logSunSearchProbe( sunSearchProbes, sunSearchPositionMs, totalOhms );
+
+  selectNextSunSearchProbe( currentTime );
+}
+
+void TrackerCore::selectNextSunSearchProbe( unsigned long currentTime )
+{
+  if( sunSearchProbes >= sunSearchSteps ||
+      sunSearchHighMs - sunSearchLowMs < TRACKER_SUN_SEARCH_MIN_INTERVAL_MS )
+  {
+    finishSunSearch( currentTime, false );
+    return;
+  }
+
+  // Drop the dimmer side of the bracket and reuse the surviving inner point
+  if( sunSearchProbeValid[0] && sunSearchProbeValid[1] )
+  {
+    if( sunSearchProbeOhms[0] <= sunSearchProbeOhms[1] )
+    {
+      sunSearchHighMs = sunSearchProbeMs[1];
+      sunSearchProbeMs[1] = sunSearchProbeMs[0];
+      sunSearchProbeOhms[1] = sunSearchProbeOhms[0];
+      sunSearchProbeMs[0] = sunSearchHighMs -
+                            ( TRACKER_GOLDEN_RATIO_CONJUGATE * ( sunSearchHighMs - sunSearchLowMs ));
+      sunSearchProbeValid[0] = false;
+    }
+    else
+    {
+      sunSearchLowMs = sunSearchProbeMs[0];
+      sunSearchProbeMs[0] = sunSearchProbeMs[1];
+      sunSearchProbeOhms[0] = sunSearchProbeOhms[1];
+      sunSearchProbeMs[1] = sunSearchLowMs +
+                            ( TRACKER_GOLDEN_RATIO_CONJUGATE * ( sunSearchHighMs - sunSearchLowMs ));
+      sunSearchProbeValid[1] = false;
+    }
+  }
+
+  sunSearchProbeIndex = sunSearchProbeValid[0] ? 1 : 0;
+  startSunSearchMove( (unsigned long)( sunSearchProbeMs[sunSearchProbeIndex] + 0.5f ));
+}
+
+void TrackerCore::startSunSearchMove( unsigned long targetMs )
+{
+  sunSearchTargetMs = targetMs;
+  if( targetMs >= sunSearchPositionMs )
+  {
+    startTimedMove( true, targetMs - sunSearchPositionMs, TRACKER_SUN_SEARCH_SETTLE_MS );
+  }
+  else
+  {
+    startTimedMove( false, sunSearchPositionMs - targetMs, TRACKER_SUN_SEARCH_SETTLE_MS );
+  }
+}
+
+void TrackerCore::finishSunSearch( unsigned long currentTime, bool timedOut )
+{
+  lastSunSearchProbes = sunSearchProbes;
+  lastSunSearchPositionMs = ( timedOut || sunSearchBestOhms < 0.0f ) ?
+                            sunSearchPositionMs : sunSearchBestMs;
+
+  listener->logSunSearchCompleted( lastSunSearchPositionMs, sunSearchBestOhms, sunSearchProbes, timedOut );
+
+  if( timedOut || sunSearchBestOhms < 0.0f )
+  {
+    handleEvent( motorPlanRefused ? EVENT_START_DENIED : ( timedOut ? EVENT_SEARCH_TIMEOUT : EVENT_SEARCH_DONE ));
+    lastAdjustmentTime = currentTime - getEffectiveAdjustmentPeriod();
+    return;
+  }
+
+  // Return to the brightest probe, then hand over after it settles
+  sunSearchFinalMove = true;
+  startSunSearchMove( sunSearchBestMs );
+}
+
+void TrackerCore::startHillClimb()
+{
+  handleEvent( EVENT_CLIMB_DUE );
+  hillClimbSteps = 0;
+  hillClimbImproved = false;
+  hillClimbReversed = false;
+  hillClimbReturning = false;
+  hillClimbStartPowerW = in.powerW;
+  hillClimbBestPowerW = hillClimbStartPowerW;
+
+  startTimedMove( hillClimbWest, hillClimbStepMs, TRACKER_HILL_CLIMB_SETTLE_MS );
+}
+
+void TrackerCore::updateHillClimb( unsigned long currentTime )
+{
+  // Abandon the climb if light drops below the tracking threshold
+  if( filteredBrightness.part.ohms >= brightnessThresholdOhms )
+  {
+    abortTimedMove( currentTime );
+    finishHillClimb( EVENT_LOW_BRIGHTNESS );
+    return;
+  }
+
+  if( !isMotorPlanDone() )
+  {
+    return;
+  }
+
+  if( hillClimbReturning || motorPlanRefused )
+  {
+    finishHillClimb( motorPlanRefused ? EVENT_START_DENIED : EVENT_PEAK_REACHED );
+    return;
+  }
+
+  float power = in.powerW;
+  hillClimbSteps++;
+  if( power > hillClimbBestPowerW * ( 1.0f + hillClimbDeadbandPercent / 100.0f ))
+  {
+    // Keep going while each perturbation raises power
+    hillClimbBestPowerW = power;
+    hillClimbImproved = true;
+    if( hillClimbSteps < hillClimbMaxSteps )
+    {
+      startTimedMove( hillClimbWest, hillClimbStepMs, TRACKER_HILL_CLIMB_SETTLE_MS );
+    }
+    else
+    {
+      finishHillClimb( EVENT_PEAK_REACHED );
+    }
+  }
+  else if( !hillClimbImproved && !hillClimbReversed )
+  {
+    // First step lost power: probe one step past the start in the other direction
+    hillClimbReversed = true;
+    hillClimbWest = !hillClimbWest;
+    startTimedMove( hillClimbWest, 2UL * hillClimbStepMs, TRACKER_HILL_CLIMB_SETTLE_MS );
+  }
+  else
+  {
+    // Passed the peak: step back to the best position
+    hillClimbReturning = true;
+    startTimedMove( !hillClimbWest, hillClimbStepMs, TRACKER_HILL_CLIMB_SETTLE_MS );
+  }
+}
+
+void TrackerCore::finishHillClimb( Event reason )
+{
+  if( !hillClimbImproved && hillClimbReversed )
+  {
+    hillClimbWest = !hillClimbWest;  // Neither side helped; keep the original direction
+  }
+  listener->logHillClimbCompleted( hillClimbSteps, hillClimbStartPowerW, hillClimbBestPowerW, hillClimbWest );
+  lastHillClimbSteps = hillClimbSteps;
+  lastHillClimbGainW = hillClimbBestPowerW - hillClimbStartPowerW;
+  handleEvent( reason );
+}
+
+//***********************************************************
+//     Function Name: startBacktrack
+//
+//     Inputs:
+//     - currentTime : Current time in milliseconds
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Drives the panel towards the shade-free tilt when it is
+//       outside the deadband; the move ends on the position
+//       estimate rather than on the sensors.
+//
+//***********************************************************
+void TrackerCore::startBacktrack( unsigned long currentTime )
+{
+  lastAdjustmentTime = currentTime;
+  int32_t target = backtracker.getTargetTilt( currentTime );
+  int32_t error = target - in.panelTiltMdeg;
+  if( abs( error ) < TRACKER_BACKTRACK_DEADBAND_DEGREES * 1000L )
+  {
+    return;
+  }
+
+  bool west = ( error > 0 );
+  if( !moveMotor( !west ))
+  {
+    return;   // Soft end limit ahead
+  }
+  backtrackTargetMdeg = target;
+  backtrackWest = west;
+  movementStartTime = currentTime;
+  if( backtrackMoveCount < UINT16_MAX ) backtrackMoveCount++;
+  listener->logBacktrackStarted( in.panelTiltMdeg, target );
+  handleEvent( EVENT_BACKTRACK_DUE );
+}
+
+void TrackerCore::updateBacktrack( unsigned long currentTime )
+{
+  // A soft end limit may stop the motor before the target is reached
+  bool reached = backtrackWest ? ( in.panelTiltMdeg >= backtrackTargetMdeg ) :
+                                 ( in.panelTiltMdeg <= backtrackTargetMdeg );
+  if( reached || in.motorState == MotorControl::STOPPED )
+  {
+    stopMotor();
+    handleEvent( EVENT_TILT_REACHED );
+  }
+  else if( currentTime - movementStartTime >= maxMovementTimeMs )
+  {
+    stopMotor();
+    handleEvent( EVENT_MAX_MOVE_TIME );
+  }
+}
+
+void TrackerCore::updateResponseWatch( float eastValue, float westValue, unsigned long currentTime )
+{
+  MotorControl::State motorState = in.motorState;
+  float lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  if(( motorState != MotorControl::MOVING_EAST && motorState != MotorControl::MOVING_WEST ) ||
+     lowerValue <= 0.0f )
+  {
+    responseWatchActive = false;
+    return;
+  }
+
+  // Time from motor start until the sensor imbalance visibly changes
+  float imbalancePercent = (( eastValue - westValue ) / lowerValue ) * 100.0f;
+  unsigned long moveStartTime = in.motorMoveStartTime;
+  if( moveStartTime != responseWatchMoveStart )
+  {
+    responseWatchMoveStart = moveStartTime;
+    responseBaselinePercent = imbalancePercent;
+    responseWatchActive = true;
+    return;
+  }
+
+  if( responseWatchActive &&
+      fabs( imbalancePercent - responseBaselinePercent ) >= MOTOR_BACKLASH_RESPONSE_PERCENT )
+  {
+    out.responseValid = true;
+    out.responseLatencyMs = currentTime - moveStartTime;
+    out.responseReversal = in.motorReversalMove;
+    responseWatchActive = false;
+  }
+}
+
+//***********************************************************
+//     Function Name: updateStallDetector
+//
+//     Inputs:
+//     - eastValue, westValue : Sensor values of this sample pair
+//     - currentTime : Time of the sample pair
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Stops the motor when the sensors stop following it. A stall
+//       close to the end stop ahead is an arrival there; anywhere
+//       else it is a jam. Only watched in daylight, since the
+//       imbalance does not move with the panel in the dark.
+//
+//***********************************************************
+void TrackerCore::updateStallDetector( float eastValue, float westValue, unsigned long currentTime )
+{
+  MotorControl::State motorState = in.motorState;
+  float lowerValue = (( eastValue < westValue ) ? eastValue : westValue );
+  if(( motorState != MotorControl::MOVING_EAST && motorState != MotorControl::MOVING_WEST ) ||
+     lowerValue <= 0.0f || state == NIGHT_MODE ||
+     filteredBrightness.part.ohms >= brightnessThresholdOhms )
+  {
+    stallDetector.stopWatching();
+    return;
+  }
+
+  float imbalancePercent = (( eastValue - westValue ) / lowerValue ) * 100.0f;
+  if( !stallDetector.addSample( imbalancePercent, in.motorMoveStartTime, in.motorTakeUpMs, currentTime ))
+  {
+    return;
+  }
+
+  bool stallEast = ( motorState == MotorControl::MOVING_EAST );
+  bool endStop = in.motorNearEndStop;
+  stopMotor();
+  stallDetector.stopWatching();
+  out.motorStall = endStop ? STALL_END_STOP : STALL_JAM;
+  out.stallOverrunMs = stallDetector.getOverrunMs( currentTime );
+  if( endStop )
+  {
+    if( stallEndStopCount < UINT16_MAX ) stallEndStopCount++;
+  }
+  else
+  {
+    if( stallJamCount < UINT16_MAX ) stallJamCount++;
+  }
+  listener->logMotorStall( endStop, stallEast, out.stallOverrunMs );
+  if( state != IDLE )
+  {
+    handleEvent( EVENT_STALL );
+  }
+}
+
+float TrackerCore::getActiveTolerance() const
+{
+  // Noisier sensors in low light need a wider band to avoid hunting
+  if( autoTuneEnabled && filteredBrightness.part.ohms >= AUTOTUNE_LOW_LIGHT_OHMS &&
+      lowLightTolerancePercent > tolerancePercent )
+  {
+    return lowLightTolerancePercent;
+  }
+  return tolerancePercent;
+}
+
+int32_t TrackerCore::getActiveTolerancePpm() const
+{
+  // Same selection as getActiveTolerance(), on the precomputed ppm values
+  if( autoTuneEnabled && filteredBrightness.part.ohms >= AUTOTUNE_LOW_LIGHT_OHMS &&
+      lowLightTolerancePpm > tolerancePpm )
+  {
+    return lowLightTolerancePpm;
+  }
+  return tolerancePpm;
+}
+
+void TrackerCore::applyAutoTuneValue( const char* name, float* value, float recommended )
+{
+  if( fabs( recommended - *value ) <= ( fabs( *value ) * AUTOTUNE_MIN_CHANGE ))
+  {
+    return;
+  }
+  listener->logAutoTuneChange( name, *value, recommended );
+  *value = recommended;
+}
+
+void TrackerCore::applyAutoTune()
+{
+  float tolerance = tolerancePercent;
+  applyAutoTuneValue( "balance_tol", &tolerance, autoTuner.recommendTolerance( tolerancePercent ));
+  setTolerance( tolerance );
+
+  float lowLightTolerance = ( lowLightTolerancePercent > 0.0f ) ? lowLightTolerancePercent : tolerancePercent;
+  applyAutoTuneValue( "low_light_tol", &lowLightTolerance,
+                      autoTuner.recommendLowLightTolerance( tolerancePercent ));
+  lowLightTolerancePercent = lowLightTolerance;
+  lowLightTolerancePpm = percentToPpm( lowLightTolerance );
+
+  float threshold = startMoveThresholdPercent;
+  applyAutoTuneValue( "start_move_thresh", &threshold,
+                      autoTuner.recommendStartThreshold( tolerancePercent, startMoveThresholdPercent ));
+  setStartMoveThreshold( threshold );
+
+  float brightnessTau = brightnessFilterTimeConstantS;
+  applyAutoTuneValue( "brightness_filter_tau", &brightnessTau,
+                      autoTuner.recommendBrightnessTau( brightnessFilterTimeConstantS ));
+  setBrightnessFilterTimeConstant( brightnessTau );
+
+  float monitorTau = monitorFilterTimeConstantS;
+  applyAutoTuneValue( "monitor_filt_tau", &monitorTau,
+                      autoTuner.recommendMonitorTau( startMoveThresholdPercent, monitorFilterTimeConstantS ));
+  setMonitorFilterTimeConstant( monitorTau );
+}
+
+void TrackerCore::setShadingMapEnabled( bool enabled )
+{
+  shadingEnabled = enabled;
+}
+
+void TrackerCore::setAutoTuneEnabled( bool enabled )
+{
+  autoTuneEnabled = enabled;
+}
+
+bool TrackerCore::deferForStartLimit()
+{
+  if( in.motorCanStart )
+  {
+    startLimitDeferred = false;
+    return false;
+  }
+  if( !startLimitDeferred )
+  {
+    startLimitDeferred = true;
+    if( startLimitedAdjustmentCount < UINT16_MAX ) startLimitedAdjustmentCount++;
+    listener->logAdjustmentDeferredStartLimit( in.motorStartRate );
+  }
+  return true;
+}
+
+float TrackerCore::getEnergyHarvestedToday() const
+{
+  if( !in.powerValid )
+  {
+    return 0.0f;
+  }
+  return in.energyWh - dayStartEnergyWh;
+}
+
+void TrackerCore::setTrackingStrategy( uint8_t strategy )
+{
+  trackingStrategy = strategy;
+}
+
+void TrackerCore::setHillClimbStep( unsigned long stepMs )
+{
+  hillClimbStepMs = stepMs;
+}
+
+void TrackerCore::setHillClimbMaxSteps( uint8_t steps )
+{
+  hillClimbMaxSteps = steps;
+}
+
+void TrackerCore::setHillClimbDeadband( float deadbandPercent )
+{
+  hillClimbDeadbandPercent = deadbandPercent;
+}
+
+void TrackerCore::setSunSearchEnabled( bool enabled )
+{
+  sunSearchEnabled = enabled;
+}
+
+void TrackerCore::setSunSearchSteps( uint8_t steps )
+{
+  sunSearchSteps = steps;
+}
+
+void TrackerCore::setSunSearchTimeout( unsigned long timeoutSeconds )
+{
+  sunSearchTimeoutMs = timeoutSeconds * 1000UL;
+}
+
+void TrackerCore::setSunSearchSpan( unsigned long spanSeconds )
+{
+  sunSearchSpanMs = spanSeconds * 1000UL;
+}
+
+void TrackerCore::setKalmanEnabled( bool enabled )
+{
+  if( enabled && !kalmanEnabled )
+  {
+    sunEstimator.reset();  // Start from fresh measurements
+  }
+  kalmanEnabled = enabled;
+}
+
+TrackerCore::State TrackerCore::getState() const
+{
+  return state;
+}
+
+bool TrackerCore::isAdjusting() const
+{
+  return state == ADJUSTING;
+}
+
+unsigned long TrackerCore::getTimeUntilNextAdjustment() const
+{
+  unsigned long currentTime = in.timeMs;
+  unsigned long timeSinceLastAdjustment = currentTime - lastAdjustmentTime;
+  unsigned long periodMs = getEffectiveAdjustmentPeriod();
+  if( timeSinceLastAdjustment >= periodMs )
+  {
+    return 0;
+  }
+  return ( periodMs - timeSinceLastAdjustment );
+}
+
+unsigned long TrackerCore::getTimeSinceLastStateChange() const
+{
+  unsigned long currentTime = in.timeMs;
+  return currentTime - lastStateChangeTime;
+}
+
+unsigned long TrackerCore::getLastMovementDuration() const
+{
+  return lastMovementDuration;
+}
+
+unsigned long TrackerCore::getTimeSinceLastDayNightTransition() const
+{
+  unsigned long currentTime = in.timeMs;
+  return currentTime - lastDayNightTransitionTime;
+}
+
+bool TrackerCore::handleEvent( Event event )
+{
+  // Single dispatch point: look up the transition for this state and event
+  uint8_t index = 0;
+  for( ; index < TRANSITION_COUNT; index++ )
+  {
+    if( pgm_read_byte( &TRANSITIONS[index].from ) == state &&
+        pgm_read_byte( &TRANSITIONS[index].event ) == event )
+    {
+      break;
+    }
+  }
+  if( index == TRANSITION_COUNT )
+  {
+    if( invalidEventCount < UINT16_MAX ) invalidEventCount++;
+    listener->logInvalidTrackerEvent( state, event );
+    return false;
+  }
+
+  State from = state;
+  State to = (State)pgm_read_byte( &TRANSITIONS[index].to );
+  unsigned long currentTime = in.timeMs;
+
+  // Exit actions
+  if( from == ADJUSTING )
+  {
+    reversalTries = 0;
+  }
+  // A motor plan belongs to the state that queued it
+  if( motorPlanPending && !isMotorPlanDone() )
+  {
+    stopMotor();
+  }
+
+  stateTimeMs[from] += currentTime - lastStateChangeTime;
+  if( transitionCounts[index] < UINT16_MAX ) transitionCounts[index]++;
+  TraceEntry* entry = &trace[traceSequence % TRACE_SIZE];
+  entry->time = currentTime;
+  entry->from = from;
+  entry->event = event;
+  entry->to = to;
+  traceSequence++;
+
+  state = to;
+  lastStateChangeTime = currentTime;
+  return true;
+}
+
+const char* TrackerCore::getEventName( uint8_t event )
+{
+  if( event >= EVENT_COUNT )
+  {
+    return PSTR("");
+  }
+  return (const char*)pgm_read_ptr( &EVENT_NAMES[event] );
+}
+
+void TrackerCore::getTransition( uint8_t index, uint8_t* from, uint8_t* event, uint8_t* to )
+{
+  *from = pgm_read_byte( &TRANSITIONS[index].from );
+  *event = pgm_read_byte( &TRANSITIONS[index].event );
+  *to = pgm_read_byte( &TRANSITIONS[index].to );
+}
+
+unsigned long TrackerCore::getTimeInState( State s ) const
+{
+  unsigned long total = stateTimeMs[s];
+  if( s == state )
+  {
+    total += in.timeMs - lastStateChangeTime;
+  }
+  return total;
+}
+
+bool TrackerCore::getTraceEntry( uint16_t sequence, TraceEntry* entry ) const
+{
+  // Only the last TRACE_SIZE transitions are kept
+  if( (uint16_t)( traceSequence - sequence ) == 0 || (uint16_t)( traceSequence - sequence ) > TRACE_SIZE )
+  {
+    return false;
+  }
+  *entry = trace[sequence % TRACE_SIZE];
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,702 @@
+#ifndef TRACKER_CORE_H
+#define TRACKER_CORE_H
+
+#include <Arduino.h>
+#include "param_config.h"
+#include "MotorControl.h"
+#include "CloudDetector.h"
+#include "SunEstimator.h"
+#include "AutoTuner.h"
+#include "ShadingMap.h"
+#include "StallDetector.h"
+#include "MovementStats.h"
+#include "Backtracker.h"
+#include "MotionPlanner.h"
+
+// Receives the tracker's log events; the default implementation ignores them
+class TrackerListener {
+public:
+  virtual ~TrackerListener() {}
+  virtual void logAdjustmentSkippedLowBrightness( int32_t /*avgBrightness*/, int32_t /*threshold*/ ) {}
+  virtual void logOvershootDetected( bool /*movingEast*/, float /*eastValue*/, float /*westValue*/,
+                                     float /*tolerance*/ ) {}
+  virtual void logAdjustmentAbortedLowBrightness( int32_t /*avgBrightness*/, int32_t /*threshold*/ ) {}
+  virtual void logReversalAbortedNoProgress( bool /*movingEast*/, float /*eastValue*/, float /*westValue*/,
+                                             float /*tolerance*/, float /*initialDiff*/ ) {}
+  virtual void logNightModeEntered( int32_t /*avgBrightness*/, int32_t /*threshold*/ ) {}
+  virtual void logDayModeEntered( int32_t /*avgBrightness*/, int32_t /*threshold*/ ) {}
+  virtual void logDefaultWestMovementStarted( int32_t /*avgBrightness*/, int32_t /*threshold*/, unsigned long /*duration*/ ) {}
+  virtual void logDefaultWestMovementCompleted() {}
+  virtual void logSuccessfulMovement( unsigned long /*duration*/, bool /*movingEast*/ ) {}
+  virtual void logAdjustmentDeferredCloud( float /*brightnessVariation*/, float /*differenceDeviation*/ ) {}
+  virtual void logAdjustmentSkippedUnprofitable( float /*expectedGainMwh*/, float /*expectedCostMwh*/ ) {}
+  virtual void logSunSearchStarted( unsigned long /*spanMs*/, uint8_t /*maxProbes*/ ) {}
+  virtual void logSunSearchProbe( uint8_t /*probe*/, unsigned long /*positionMs*/, float /*totalOhms*/ ) {}
+  virtual void logSunSearchCompleted( unsigned long /*positionMs*/, float /*totalOhms*/, uint8_t /*probes*/, bool /*timedOut*/ ) {}
+  virtual void logHillClimbCompleted( uint8_t /*steps*/, float /*startPowerW*/, float /*finalPowerW*/, bool /*movingWest*/ ) {}
+  virtual void logAdjustmentDeferredStartLimit( uint16_t /*refillPerHour*/ ) {}
+  virtual void logAdjustmentEndedStartLimit() {}
+  virtual void logAutoTuneChange( const char* /*name*/, float /*oldValue*/, float /*newValue*/ ) {}
+  virtual void logAdjustmentDeferredShading( bool /*predicted*/ ) {}
+  virtual void logMotorStall( bool /*endStop*/, bool /*movingEast*/, unsigned long /*overrunMs*/ ) {}
+  virtual void logBacktrackStarted( int32_t /*tiltMdeg*/, int32_t /*targetMdeg*/ ) {}
+  virtual void logMovePlanned( uint8_t /*delaySteps*/, bool /*movingWest*/, unsigned long /*durationMs*/,
+                               float /*costMwh*/, float /*idleCostMwh*/ ) {}
+  virtual void logInvalidTrackerEvent( uint8_t /*state*/, uint8_t /*event*/ ) {}
+};
+
+// Tracking logic as a pure function of its inputs: no clock, pin, sensor,
+// motor or serial access. Tracker adapts it to the hardware.
+class TrackerCore {
+public:
+  enum State 
+  {
+    IDLE,
+    ADJUSTING,
+    NIGHT_MODE,
+    DEFAULT_WEST_MOVEMENT,
+    SUN_SEARCH,
+    HILL_CLIMBING,
+    BACKTRACKING,
+    PLANNED_MOVE
+  };
+  static const uint8_t STATE_COUNT = PLANNED_MOVE + 1;
+
+  // State machine events; also the reason code recorded in the transition trace
+  enum Event
+  {
+    EVENT_NIGHT_DETECTED,
+    EVENT_DAY_DETECTED,
+    EVENT_ADJUSTMENT_DUE,
+    EVENT_CLIMB_DUE,
+    EVENT_LOW_LIGHT_MOVE_DUE,
+    EVENT_SEARCH_DUE,
+    EVENT_MOVE_COMPLETE,
+    EVENT_BALANCED,
+    EVENT_LOW_BRIGHTNESS,
+    EVENT_MAX_MOVE_TIME,
+    EVENT_NO_PROGRESS,
+    EVENT_REVERSALS_EXHAUSTED,
+    EVENT_START_DENIED,
+    EVENT_SEARCH_DONE,
+    EVENT_SEARCH_TIMEOUT,
+    EVENT_PEAK_REACHED,
+    EVENT_STALL,
+    EVENT_BACKTRACK_DUE,
+    EVENT_TILT_REACHED,
+    EVENT_PLAN_DUE,
+    EVENT_PLAN_DONE,
+    EVENT_COUNT
+  };
+
+  // One recorded transition
+  struct TraceEntry
+  {
+    unsigned long time;
+    uint8_t from;
+    uint8_t event;
+    uint8_t to;
+  };
+
+  // Everything the core reads in one step
+  struct Inputs
+  {
+    unsigned long timeMs;             // Time of this step
+    unsigned long timeUs;             // Microsecond time of this step (stop latency)
+    int32_t eastValue;                // Filtered sensor values (whole ohms)
+    int32_t westValue;
+    bool samplePair;                  // Both sensors have a new sample since the last pair
+    unsigned long sampleMicros;       // When the pair completed
+    MotorControl::State motorState;
+    bool motorCanStart;               // A tracking (trim) start would be granted now
+    unsigned long motorTakeUpMs;      // Backlash take-up time of the current move
+    bool motorReversalMove;           // Current move reversed the previous direction
+    unsigned long motorMoveStartTime; // Start time of the current move
+    uint8_t motorPlanDone;            // Bit n: command n of the last motor plan finished since the last step
+    uint8_t motorPlanRefused;         // Bit n: command n of the last motor plan was refused
+    unsigned long motorRunTimeMs;     // Total motor run time
+    uint16_t motorStartRate;          // Start tokens refilled per hour
+    bool supplyAvailable;             // No other axis holds the motor supply current
+    bool motorEastLimit;              // A soft end limit blocks tracking moves east
+    bool motorWestLimit;              // A soft end limit blocks tracking moves west
+    bool motorNearEndStop;            // The running move is close to the end stop ahead
+    bool panelTiltKnown;              // The tilt below comes from a referenced position
+    int32_t panelTiltMdeg;            // Panel tilt, millidegrees west of flat
+    bool powerValid;                  // Power fields come from a power sensor
+    float powerW;
+    float energyWh;
+  };
+
+  // Motor commands and events produced by one step
+  enum MotorMove
+  {
+    MOTOR_NONE,
+    MOTOR_EAST,
+    MOTOR_WEST
+  };
+  enum MotorStall
+  {
+    STALL_NONE,
+    STALL_JAM,                        // Stalled away from the end stops
+    STALL_END_STOP                    // Stalled on arrival at an end stop
+  };
+  // One command of a motor plan: a move for durationMs (0 = until the
+  // next command) or, with MOTOR_NONE, a stop held for durationMs
+  struct MotorStep
+  {
+    uint8_t move;                     // MotorMove
+    unsigned long durationMs;
+  };
+  static const uint8_t MOTOR_PLAN_STEPS = 2;
+  struct Outputs
+  {
+    bool motorStop;                   // Stop before applying motorMove
+    uint8_t motorMove;                // MotorMove
+    MotorStep motorPlan[MOTOR_PLAN_STEPS]; // Queued on the motor after the stop, replacing any plan
+    uint8_t motorPlanLength;
+    bool motorApproach;               // Nearly balanced: slow the motor for the final approach
+    MotorControl::StartPriority motorPriority;
+    bool responseValid;               // A motor response latency was measured
+    unsigned long responseLatencyMs;
+    bool responseReversal;
+    bool shadingMapChanged;           // The shading map should be stored
+    uint8_t motorStall;               // MotorStall; the motor has been stopped
+    unsigned long stallOverrunMs;     // Run time since the panel last moved
+    uint8_t transitions;              // State transitions in this step (see trace)
+  };
+
+  TrackerCore();
+  void begin( const Inputs& inputs );
+  void step( const Inputs& inputs, Outputs& outputs );
+  void setListener( TrackerListener* listener );
+
+  // Configuration
+  void setTolerance( float tolerancePercent );
+  void setMaxMovementTime( unsigned long maxMovementTimeSeconds );
+  void setAdjustmentPeriod( unsigned long adjustmentPeriodSeconds );
+  void setSamplingRate( unsigned long samplingRateMs );
+  void setBrightnessThreshold( int32_t thresholdOhms );
+  void setBrightnessFilterTimeConstant( float tauS );
+  void setReversalDeadTime( unsigned long ms );
+  void setMaxReversalTries( int tries );
+  void setReversalTimeLimit( unsigned long ms );
+  void setNightThreshold( int32_t thresholdOhms );
+  void setNightHysteresis( float hysteresisPercent );
+  void setNightDetectionTime( unsigned long detectionTimeSeconds );
+  void setDefaultWestMovementEnabled( bool enabled );
+  void setDefaultWestMovementTime( unsigned long ms );
+  void setUseAverageMovementTime( bool enabled );
+  void setMovementHistorySize( uint8_t size );
+  void setMovementAverageMode( uint8_t mode );
+  
+  // Monitor mode configuration
+  void setMonitorModeEnabled( bool enabled );
+  void setStartMoveThreshold( float thresholdPercent );
+  void setMinWaitTime( unsigned long waitTimeSeconds );
+  void setMonitorFilterTimeConstant( float tauS );
+
+  // Adaptive scheduling configuration
+  void setAdaptiveScheduleEnabled( bool enabled );
+  void setAdjustmentPeriodMin( unsigned long periodSeconds );
+  void setAdjustmentPeriodMax( unsigned long periodSeconds );
+
+  // Energy-aware tracking configuration
+  void setEnergyAwareEnabled( bool enabled );
+  void setPanelPower( float watts );
+  void setMotorPower( float watts );
+  void setDegreesPerPercent( float degrees );
+
+  // Kalman estimator configuration
+  void setKalmanEnabled( bool enabled );
+
+  // Dawn sun search configuration
+  void setSunSearchEnabled( bool enabled );
+  void setSunSearchSteps( uint8_t steps );
+  void setSunSearchTimeout( unsigned long timeoutSeconds );
+  void setSunSearchSpan( unsigned long spanSeconds );
+
+  // Tracking strategy configuration
+  void setTrackingStrategy( uint8_t strategy );
+  void setHillClimbStep( unsigned long stepMs );
+  void setHillClimbMaxSteps( uint8_t steps );
+  void setHillClimbDeadband( float deadbandPercent );
+
+  // Auto-tuning configuration
+  void setAutoTuneEnabled( bool enabled );
+
+  // Shading map configuration
+  void setShadingMapEnabled( bool enabled );
+
+  // Getters for configuration
+  float getTolerance() const { return tolerancePercent; }
+  unsigned long getMaxMovementTime() const { return maxMovementTimeMs / 1000UL; }
+  unsigned long getAdjustmentPeriod() const { return adjustmentPeriodMs / 1000UL; }
+  unsigned long getSamplingRate() const { return samplingRateMs; }
+  int32_t getBrightnessThreshold() const { return brightnessThresholdOhms; }
+  float getBrightnessFilterTimeConstant() const { return brightnessFilterTimeConstantS; }
+  unsigned long getReversalDeadTime() const { return reversalDeadTimeMs; }
+  int getMaxReversalTries() const { return maxReversalTries; }
+  unsigned long getReversalTimeLimit() const { return reversalTimeLimitMs; }
+  int32_t getNightThreshold() const { return nightThresholdOhms; }
+  float getNightHysteresis() const { return nightHysteresisPercent; }
+  unsigned long getNightDetectionTime() const { return nightDetectionTimeMs / 1000UL; }
+  bool getDefaultWestMovementEnabled() const { return defaultWestMovementEnabled; }
+  unsigned long getDefaultWestMovementTime() const { return defaultWestMovementMs; }
+  bool getUseAverageMovementTime() const { return useAverageMovementTime; }
+  uint8_t getMovementHistorySize() const { return movementStats.getWindowSize(); }
+  uint8_t getMovementAverageMode() const { return movementStats.getAverageMode(); }
+  const MovementStats* getMovementStats() const { return &movementStats; }
+  
+  // Monitor mode getters
+  bool getMonitorModeEnabled() const { return monitorModeEnabled; }
+  float getStartMoveThreshold() const { return startMoveThresholdPercent; }
+  unsigned long getMinWaitTime() const { return minWaitTimeMs / 1000UL; }
+  float getMonitorFilterTimeConstant() const { return monitorFilterTimeConstantS; }
+  float getMonitorFilteredEast() const { return getFilterValue( monitorFilteredEast ); }
+  float getMonitorFilteredWest() const { return getFilterValue( monitorFilteredWest ); }
+
+  // Adaptive scheduling getters
+  bool getAdaptiveScheduleEnabled() const { return adaptiveScheduleEnabled; }
+  unsigned long getAdjustmentPeriodMin() const { return adjustmentPeriodMinMs / 1000UL; }
+  unsigned long getAdjustmentPeriodMax() const { return adjustmentPeriodMaxMs / 1000UL; }
+  bool isDriftEstimateValid() const { return driftEstimateValid; }
+  float getDriftRate() const { return driftRateMsPerMin; }
+  float getMotorGain() const { return motorMsPerPercent; }
+  unsigned long getEffectiveAdjustmentPeriod() const;
+
+  // Cloud transient detection
+  CloudDetector* getCloudDetector() { return &cloudDetector; }
+  const CloudDetector* getCloudDetector() const { return &cloudDetector; }
+  uint16_t getSuppressedAdjustmentCount() const { return suppressedAdjustmentCount; }
+  uint16_t getDeferredAdjustmentCount() const { return deferredAdjustmentCount; }
+
+  // Energy-aware tracking getters
+  bool getEnergyAwareEnabled() const { return energyAwareEnabled; }
+  float getPanelPower() const { return panelPowerW; }
+  float getMotorPower() const { return motorPowerW; }
+  float getDegreesPerPercent() const { return degreesPerPercent; }
+  float getEnergySpentMoving() const;
+  float getEnergyGained() const { return energyGainedMwh; }
+  float getLastExpectedGain() const { return lastExpectedGainMwh; }
+  float getLastExpectedCost() const { return lastExpectedCostMwh; }
+  uint16_t getUnprofitableSkipCount() const { return unprofitableSkipCount; }
+
+  // Kalman estimator getters
+  bool getKalmanEnabled() const { return kalmanEnabled; }
+  const SunEstimator* getSunEstimator() const { return &sunEstimator; }
+
+  // Dawn sun search getters
+  bool getSunSearchEnabled() const { return sunSearchEnabled; }
+  uint8_t getSunSearchSteps() const { return sunSearchSteps; }
+  unsigned long getSunSearchTimeout() const { return sunSearchTimeoutMs / 1000UL; }
+  unsigned long getSunSearchSpan() const { return sunSearchSpanMs / 1000UL; }
+  uint8_t getLastSunSearchProbes() const { return lastSunSearchProbes; }
+  unsigned long getLastSunSearchPosition() const { return lastSunSearchPositionMs; }
+
+  // Tracking strategy getters
+  uint8_t getTrackingStrategy() const { return trackingStrategy; }
+  const char* getTrackingStrategyName() const;
+  unsigned long getHillClimbStep() const { return hillClimbStepMs; }
+  uint8_t getHillClimbMaxSteps() const { return hillClimbMaxSteps; }
+  float getHillClimbDeadband() const { return hillClimbDeadbandPercent; }
+  uint8_t getLastHillClimbSteps() const { return lastHillClimbSteps; }
+  float getLastHillClimbGain() const { return lastHillClimbGainW; }
+  const MotionPlanner* getMotionPlanner() const { return &planner; }
+  const MotionPlanner::Plan& getLastPlan() const { return lastPlan; }
+  uint16_t getPlannedMoveCount() const { return plannedMoveCount; }
+  uint16_t getPlannerDeferCount() const { return plannerDeferCount; }
+  float getEnergyHarvestedToday() const;
+  float getEnergyHarvestedLastDay() const { return lastDayEnergyWh; }
+
+  // Motor start rate limiting
+  uint16_t getStartLimitedAdjustmentCount() const { return startLimitedAdjustmentCount; }
+
+  // Auto-tuning getters
+  bool getAutoTuneEnabled() const { return autoTuneEnabled; }
+  const AutoTuner* getAutoTuner() const { return &autoTuner; }
+  float getLowLightTolerance() const { return lowLightTolerancePercent; }
+  float getActiveTolerance() const;
+
+  // Shading map
+  bool getShadingMapEnabled() const { return shadingEnabled; }
+  ShadingMap* getShadingMap() { return &shadingMap; }
+  const ShadingMap* getShadingMap() const { return &shadingMap; }
+  uint16_t getShadingDeferredCount() const { return shadingDeferredCount; }
+
+  // Shared motor supply (dual-axis)
+  uint16_t getSupplyDeferredCount() const { return supplyDeferredCount; }
+
+  // Motor stall detection
+  StallDetector* getStallDetector() { return &stallDetector; }
+  const StallDetector* getStallDetector() const { return &stallDetector; }
+  uint16_t getStallJamCount() const { return stallJamCount; }
+  uint16_t getStallEndStopCount() const { return stallEndStopCount; }
+
+  // Row-to-row shading backtracking
+  Backtracker* getBacktracker() { return &backtracker; }
+  const Backtracker* getBacktracker() const { return &backtracker; }
+  uint16_t getBacktrackMoveCount() const { return backtrackMoveCount; }
+
+  // Status
+  State getState() const;
+  bool isAdjusting() const;
+  bool isNightMode() const 
+  {
+    return state == NIGHT_MODE;
+  }
+  bool isDefaultWestMovement() const
+  {
+    return state == DEFAULT_WEST_MOVEMENT;
+  }
+  bool isSunSearch() const
+  {
+    return state == SUN_SEARCH;
+  }
+  bool isHillClimbing() const
+  {
+    return state == HILL_CLIMBING;
+  }
+  bool isBacktracking() const
+  {
+    return state == BACKTRACKING;
+  }
+  bool isPlannedMove() const
+  {
+    return state == PLANNED_MOVE;
+  }
+  unsigned long getTimeUntilNextAdjustment() const;
+  float getFilteredBrightness() const 
+  {
+    return getFilterValue( filteredBrightness );
+  }
+  unsigned long getAverageMovementTime() const;
+  unsigned long getTimeSinceLastStateChange() const;
+  unsigned long getLastMovementDuration() const;
+  unsigned long getTimeSinceLastDayNightTransition() const;
+
+  // Stop latency statistics (sensor sample -> motor stop while adjusting)
+  static const uint8_t STOP_LATENCY_BUCKETS = 9;
+  static unsigned long getStopLatencyBucketLimitUs( uint8_t bucket );
+  uint16_t getStopLatencyBucketCount( uint8_t bucket ) const;
+  uint16_t getStopLatencyCount() const { return stopLatencyCount; }
+  unsigned long getStopLatencyAverageUs() const;
+  unsigned long getStopLatencyMaxUs() const { return stopLatencyMaxUs; }
+
+  // State machine statistics and transition trace
+  static const uint8_t TRACE_SIZE = 16;
+  static const uint8_t TRANSITION_COUNT = 32;
+  static const char* getEventName( uint8_t event );  // PROGMEM string
+  static void getTransition( uint8_t index, uint8_t* from, uint8_t* event, uint8_t* to );
+  uint16_t getTransitionCount( uint8_t index ) const { return transitionCounts[index]; }
+  uint16_t getInvalidEventCount() const { return invalidEventCount; }
+  unsigned long getTimeInState( State s ) const;
+  uint16_t getTraceSequence() const { return traceSequence; }
+  bool getTraceEntry( uint16_t sequence, TraceEntry* entry ) const;
+
+  // Fixed-point EMA state: ohms in Q32.32; the whole-ohm word is read
+  // directly so the per-step math needs no 64-bit shifts. The helpers are
+  // the per-step filter and tolerance math, timed alone by the host
+  // FilterBench.
+  union FixedFilter
+  {
+    int64_t q32;
+    struct
+    {
+      uint32_t fraction;
+      int32_t ohms;
+    } part;
+  };
+  static float getFilterValue( const FixedFilter& filter );
+  static void resetFilter( FixedFilter* filter, int32_t ohms );
+  static void updateFilter( FixedFilter* filter, int32_t sampleOhms, unsigned long dtMs,
+                            unsigned long tauMs, uint32_t alphaPerMsQ32 );
+  static unsigned long getFilterTauMs( float tauS );
+  static uint32_t getFilterAlphaPerMs( unsigned long tauMs );
+  static int32_t percentToPpm( float percent );
+  static bool exceedsPpm( int32_t diffOhms, int32_t referenceOhms, int32_t ppm );
+
+private:
+  // Adjustment triggers decide when to adjust; strategies decide how
+  typedef bool (TrackerCore::*TriggerCheck)( unsigned long currentTime );
+  typedef void (TrackerCore::*StrategyStart)( unsigned long currentTime, bool isMonitorTriggered );
+  struct AdjustmentTrigger
+  {
+    TriggerCheck check;
+    bool monitorValues;             // Adjustment starts from the monitor filtered values
+  };
+  struct TrackingStrategy
+  {
+    const char* name;
+    StrategyStart start;            // Leaves IDLE for the strategy's adjusting state
+  };
+  static const uint8_t TRIGGER_COUNT = 3;
+  static const uint8_t STRATEGY_COUNT = 3;
+  static const AdjustmentTrigger TRIGGERS[TRIGGER_COUNT];
+  static const TrackingStrategy STRATEGIES[STRATEGY_COUNT];
+
+  // Transition table: the only way the tracker changes state
+  struct Transition
+  {
+    uint8_t from;
+    uint8_t event;
+    uint8_t to;
+  };
+  static const Transition TRANSITIONS[TRANSITION_COUNT];
+
+  static bool haveOppositeSigns( int32_t a, int32_t b );
+
+  State state;
+  TrackerListener* listener;
+  Inputs in;                        // Inputs of the current/last step
+  Outputs out;                      // Outputs being built by the current step
+
+  // Configuration
+  float tolerancePercent;
+  int32_t tolerancePpm;             // tolerancePercent in parts per million
+  unsigned long maxMovementTimeMs;
+  unsigned long adjustmentPeriodMs;
+  unsigned long samplingRateMs;
+  int32_t brightnessThresholdOhms;
+  float brightnessFilterTimeConstantS;
+  unsigned long brightnessFilterTauMs;
+  uint32_t brightnessFilterAlphaQ32; // Filter weight per ms elapsed (Q0.32)
+  FixedFilter filteredBrightness;
+
+  // Night mode configuration
+  int32_t nightThresholdOhms;
+  float nightHysteresisPercent;
+  int32_t dayThresholdOhms;         // Night threshold less the hysteresis
+  unsigned long nightDetectionTimeMs;
+  unsigned long nightModeStartTime;
+  unsigned long dayModeStartTime;
+  bool nightConditionMet;
+  bool dayConditionMet;
+  unsigned long lastDayNightTransitionTime;
+
+  // Overshoot correction
+  unsigned long reversalDeadTimeMs; // ms to wait before reversing after overshoot
+  unsigned long reversalTimeLimitMs; // ms to limit each reversal movement
+  int maxReversalTries;             // max number of reversal attempts
+  int reversalTries;                // current reversal attempt count
+  unsigned long reversalStartTime;     // when reversal movement started
+  bool reversalDirection;           // direction to move after reversal (true=east, false=west)
+
+  // Default west movement configuration
+  bool defaultWestMovementEnabled;  // Whether to move west when brightness is low
+  unsigned long defaultWestMovementMs;  // How long to move west for
+  unsigned long defaultWestMovementStartTime;  // When the default west movement started
+  bool useAverageMovementTime;      // Whether to use average movement time for default west movement
+  MovementStats movementStats;     // Durations of past successful movements
+  
+  // Monitor mode configuration
+  bool monitorModeEnabled;          // Whether monitor mode is enabled
+  float startMoveThresholdPercent;  // Percentage difference threshold to trigger movement
+  int32_t startMoveThresholdPpm;    // startMoveThresholdPercent in parts per million
+  unsigned long minWaitTimeMs;      // Minimum time between monitor mode movements
+  float monitorFilterTimeConstantS; // Time constant for monitor mode filter
+  unsigned long monitorFilterTauMs;
+  uint32_t monitorFilterAlphaQ32;   // Filter weight per ms elapsed (Q0.32)
+  FixedFilter monitorFilteredEast;  // Monitor mode filtered east sensor value
+  FixedFilter monitorFilteredWest;  // Monitor mode filtered west sensor value
+  unsigned long lastMonitorSampleTime; // Last time monitor filters were updated
+
+  // Adaptive scheduling
+  bool adaptiveScheduleEnabled;     // Derive adjustment period from estimated drift rate
+  unsigned long adjustmentPeriodMinMs; // Lower bound of scheduled period
+  unsigned long adjustmentPeriodMaxMs; // Upper bound of scheduled period
+  bool driftEstimateValid;          // Both drift rate and gain have been sampled
+  bool motorGainValid;              // Gain has been sampled at least once
+  float driftRateMsPerMin;          // Signed motor time needed per minute (+west, -east)
+  float motorMsPerPercent;          // Motor time that removes one percent of imbalance
+  unsigned long lastSuccessfulMovementTime; // End of the previous balanced movement (0 = none)
+  unsigned long scheduledAdjustmentPeriodMs; // Period predicted from the drift estimate
+
+  // Timing
+  unsigned long lastAdjustmentTime;
+  unsigned long lastSamplingTime;
+  unsigned long movementStartTime;
+  unsigned long lastBrightnessSampleTime;
+  unsigned long lastStateChangeTime;
+
+  // Transition statistics and trace ring
+  uint16_t transitionCounts[TRANSITION_COUNT];
+  uint16_t invalidEventCount;       // Events with no transition from the current state
+  unsigned long stateTimeMs[STATE_COUNT];  // Time spent in each state, excluding the current stay
+  TraceEntry trace[TRACE_SIZE];
+  uint16_t traceSequence;           // Transitions recorded since boot; next trace slot
+  unsigned long lastMovementDuration;
+
+  // Overshoot detection
+  int32_t initialEastValue;
+  int32_t initialWestValue;
+  int32_t initialDiff;
+  bool movementDirectionSet;
+  bool movingEast;
+
+  // Cloud transient detection
+  CloudDetector cloudDetector;
+  bool adjustmentDeferred;          // An adjustment is being held off by the cloud detector
+  uint16_t suppressedAdjustmentCount; // Held-off adjustments whose trigger went away
+  uint16_t deferredAdjustmentCount;   // Held-off adjustments that ran once stable
+
+  // Energy-aware tracking
+  bool energyAwareEnabled;          // Skip corrections that cost more than they yield
+  float panelPowerW;                // Panel output at full sun
+  float motorPowerW;                // Motor power draw while running
+  float degreesPerPercent;          // Angle error implied by one percent of imbalance
+  float energyGainedMwh;            // Estimated yield recovered by completed corrections
+  float pendingGainMwh;             // Expected gain of the adjustment in progress
+  float lastExpectedGainMwh;        // Most recent gain estimate
+  float lastExpectedCostMwh;        // Most recent cost estimate
+  uint16_t unprofitableSkipCount;   // Adjustments skipped because cost exceeded gain
+
+  // Kalman sun-angle estimator
+  bool kalmanEnabled;               // Drive adjust/stop decisions from the estimate
+  SunEstimator sunEstimator;
+  unsigned long lastEstimatorTime;  // Time of the previous estimator update
+
+  // Motor plan run from the motor command queue (reversals, and timed
+  // moves followed by a settle hold for sun search, hill climb and planned
+  // moves); completions come back through Inputs
+  bool motorPlanPending;            // The last plan has not finished
+  uint8_t motorPlanSteps;           // Commands in the last plan
+  uint8_t motorPlanDoneMask;        // Commands reported finished
+  bool motorPlanRefused;            // A move of the last plan was refused
+  bool timedMoveWest;               // Direction of the timed move in the plan
+  unsigned long timedMoveDurationMs;
+
+  // Dawn sun search (golden-section search on east + west brightness)
+  bool sunSearchEnabled;            // Search for the brightest orientation after night
+  uint8_t sunSearchSteps;           // Maximum brightness probes per search
+  unsigned long sunSearchTimeoutMs; // Abandon the search after this long
+  unsigned long sunSearchSpanMs;    // Motor travel west of full east covered by the search
+  bool sunSearchFinalMove;          // Returning to the best probe before handing over
+  uint8_t sunSearchProbes;          // Probes taken in the current search
+  unsigned long sunSearchStartTime;
+  unsigned long sunSearchPositionMs; // Estimated position (motor time west of full east)
+  unsigned long sunSearchTargetMs;   // Position of the move in progress
+  float sunSearchLowMs;             // Bracket holding the brightness peak
+  float sunSearchHighMs;
+  float sunSearchProbeMs[2];        // Inner golden-section points
+  float sunSearchProbeOhms[2];      // East + west resistance at each inner point
+  bool sunSearchProbeValid[2];
+  uint8_t sunSearchProbeIndex;      // Inner point being measured
+  unsigned long sunSearchBestMs;    // Brightest probe so far
+  float sunSearchBestOhms;
+  uint8_t lastSunSearchProbes;      // Probes used by the last completed search
+  unsigned long lastSunSearchPositionMs; // Orientation chosen by the last search
+
+  // Power hill climbing (perturb and observe)
+  uint8_t trackingStrategy;         // TRACKER_STRATEGY_SENSOR_BALANCE or _HILL_CLIMB
+  unsigned long hillClimbStepMs;    // Motor time per perturbation
+  uint8_t hillClimbMaxSteps;        // Maximum perturbations per adjustment
+  float hillClimbDeadbandPercent;   // Power gain required to keep a step
+  bool hillClimbWest;               // Direction of the current/next perturbation
+  bool hillClimbImproved;           // A step in this climb raised power
+  bool hillClimbReversed;           // Already tried the other side of the start
+  bool hillClimbReturning;          // Stepping back to the best position
+  uint8_t hillClimbSteps;           // Perturbations measured in this climb
+  float hillClimbStartPowerW;
+  float hillClimbBestPowerW;
+  uint8_t lastHillClimbSteps;
+  float lastHillClimbGainW;         // Power gained by the last climb
+  MotionPlanner planner;
+  MotionPlanner::Plan lastPlan;
+  float plannedErrorBefore;         // Imbalance percent when the planned move started
+  bool plannedReversal;             // The planned move reversed the previous direction
+  unsigned long plannedTakeUpMs;    // Backlash take-up of the planned move
+  uint16_t plannedMoveCount;        // Planned moves made
+  uint16_t plannerDeferCount;       // Opportunities the planner chose to wait
+  float dayStartEnergyWh;           // Power sensor energy at the start of the day
+  float lastDayEnergyWh;            // Energy harvested between the last day and night transitions
+
+  // Motor start rate limiting
+  bool startLimitDeferred;          // A move is waiting for a motor start token
+  uint16_t startLimitedAdjustmentCount; // Moves held off by the start limiter
+
+  // Auto-tuning
+  bool autoTuneEnabled;             // Retune parameters from each day's data at nightfall
+  AutoTuner autoTuner;
+  float lowLightTolerancePercent;   // Tolerance used in low light (0 = not tuned yet)
+  int32_t lowLightTolerancePpm;
+
+  // Motor response latency measurement for backlash estimation
+  bool responseWatchActive;         // Waiting for the sensors to react to the current move
+  unsigned long responseWatchMoveStart; // Motor start time of the watched move
+  float responseBaselinePercent;    // Imbalance when the watched move started
+
+  // Learned shading map
+  bool shadingEnabled;              // Defer adjustments during live or predicted shading
+  ShadingMap shadingMap;
+  bool shadingDeferred;             // An adjustment is being held off by shading
+  uint16_t shadingDeferredCount;    // Shading hold-offs
+
+  // Shared motor supply
+  bool supplyDeferred;              // An adjustment is waiting for the other axis
+  uint16_t supplyDeferredCount;     // Supply hold-offs
+
+  // Motor stall detection
+  StallDetector stallDetector;
+  uint16_t stallJamCount;           // Stalls away from the end stops
+  uint16_t stallEndStopCount;       // Stalls on arrival at an end stop
+
+  // Row-to-row shading backtracking
+  Backtracker backtracker;
+  int32_t backtrackTargetMdeg;      // Tilt the running backtracking move stops at
+  bool backtrackWest;               // Direction of the running backtracking move
+  uint16_t backtrackMoveCount;      // Backtracking moves since boot
+
+  // Event-driven stop evaluation
+  uint16_t stopLatencyHistogram[STOP_LATENCY_BUCKETS];
+  uint16_t stopLatencyCount;        // Number of sensor-driven stops recorded
+  unsigned long stopLatencySumUs;   // Sum of recorded latencies for averaging
+  unsigned long stopLatencyMaxUs;   // Worst recorded latency
+
+  // Helper methods
+  void recordSuccessfulMovement( unsigned long duration );
+  void updateDriftEstimate( unsigned long currentTime, unsigned long duration, float finalImbalancePercent );
+  bool handleEvent( Event event );
+  void handleSamplePair();
+  void updateStateMachine();
+  void stopMotor();
+  bool moveMotor( bool east, MotorControl::StartPriority priority = MotorControl::PRIORITY_TRIM );
+  void startMotorPlan();
+  bool addMotorStep( uint8_t move, unsigned long durationMs );
+  bool isMotorPlanDone() const;
+  void startReversal();
+  bool evaluateStopConditions( unsigned long currentTime, unsigned long sampleMicros );
+  void recordStopLatency( unsigned long sampleMicros );
+  bool isAdjustmentWorthwhile( float eastValue, float westValue );
+  void updateSunEstimator( float eastValue, float westValue, unsigned long currentTime );
+  bool useSunEstimate() const;
+  int32_t getImbalanceDiff( int32_t eastValue, int32_t westValue ) const;
+  int32_t getActiveTolerancePpm() const;
+  void updateDayThreshold();
+  void startSunSearch( unsigned long currentTime );
+  void updateSunSearch( unsigned long currentTime );
+  void startSunSearchMove( unsigned long targetMs );
+  void startTimedMove( bool west, unsigned long durationMs, unsigned long settleMs );
+  unsigned long abortTimedMove( unsigned long currentTime );
+  void startHillClimb();
+  void updateHillClimb( unsigned long currentTime );
+  void finishHillClimb( Event reason );
+  void startBacktrack( unsigned long currentTime );
+  void updateBacktrack( unsigned long currentTime );
+  bool deferForStartLimit();
+  void applyAutoTune();
+  void updateResponseWatch( float eastValue, float westValue, unsigned long currentTime );
+  void updateStallDetector( float eastValue, float westValue, unsigned long currentTime );
+  void applyAutoTuneValue( const char* name, float* value, float recommended );
+  void selectNextSunSearchProbe( unsigned long currentTime );
+  void finishSunSearch( unsigned long currentTime, bool timedOut );
+  const TrackingStrategy* getStrategy() const;
+  bool checkMonitorTrigger( unsigned long currentTime );
+  bool checkEstimateTrigger( unsigned long currentTime );
+  bool checkPeriodicTrigger( unsigned long currentTime );
+  void startBalanceAdjustment( unsigned long currentTime, bool isMonitorTriggered );
+  void startPowerAdjustment( unsigned long currentTime, bool isMonitorTriggered );
+  void startPlannedAdjustment( unsigned long currentTime, bool isMonitorTriggered );
+  void updatePlannedMove( unsigned long currentTime );
+};
+
+#endif // TRACKER_CORE_H
\ No newline at end of file
@@ -0,0 +1,479 @@
+#include "TrackerRows.h"
+#include "TrackerCore.h"
+#include "Eeprom.h"
+
+#if TRACKER_ROW_COUNT > 1
+// Row n uses entry n-1 of each pin table
+static const uint8_t ROW_EAST_SENSOR_PINS_P[] PROGMEM = ROW_EAST_SENSOR_PINS;
+static const uint8_t ROW_WEST_SENSOR_PINS_P[] PROGMEM = ROW_WEST_SENSOR_PINS;
+static const uint8_t ROW_MOTOR_EAST_PINS_P[] PROGMEM = ROW_MOTOR_EAST_PINS;
+static const uint8_t ROW_MOTOR_WEST_PINS_P[] PROGMEM = ROW_MOTOR_WEST_PINS;
+#endif
+
+//***********************************************************
+//     Constructor: TrackerRows
+//
+//     Inputs:
+//     - None
+//
+//     Description:
+//     - Creates the extra rows enabled, idle and at the default
+//       tolerance.
+//
+//***********************************************************
+TrackerRows::TrackerRows()
+  : enabledMask(0),
+    movingEastMask(0),
+    staggerWaitMask(0),
+    maxMotorsRunning(TRACKER_MAX_MOTORS_RUNNING),
+    mainMotor(nullptr),
+    elevationMotor(nullptr),
+    lastStartTime(0),
+    lastSampleTime(0),
+    staggerDeferredCount(0),
+    filterInitialized(false)
+{
+  for( uint8_t i = 0; i < CAPACITY; i++ )
+  {
+    eastFiltered[i] = 0;
+    westFiltered[i] = 0;
+    stateStartTime[i] = 0;
+    lastAdjustmentTime[i] = 0;
+    moveCount[i] = 0;
+    state[i] = ROW_IDLE;
+    tolerancePercent[i] = TRACKER_ROW_TOLERANCE_PERCENT;
+    enabledMask |= ( 1 << i );
+  }
+}
+
+//***********************************************************
+//     Function Name: begin
+//
+//     Inputs:
+//     - mainMotor : Main tracker motor
+//     - elevationMotor : Elevation motor (nullptr if not fitted)
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Sets up the row motor outputs, restores the stored row
+//       configuration and takes the first sensor samples.
+//
+//***********************************************************
+void TrackerRows::begin( MotorControl* mainMotor, MotorControl* elevationMotor )
+{
+  this->mainMotor = mainMotor;
+  this->elevationMotor = elevationMotor;
+
+#if TRACKER_ROW_COUNT > 1
+  for( uint8_t i = 0; i < COUNT; i++ )
+  {
+    pinMode( pgm_read_byte( &ROW_MOTOR_EAST_PINS_P[i] ), OUTPUT );
+    pinMode( pgm_read_byte( &ROW_MOTOR_WEST_PINS_P[i] ), OUTPUT );
+    digitalWrite( pgm_read_byte( &ROW_MOTOR_EAST_PINS_P[i] ), LOW );
+    digitalWrite( pgm_read_byte( &ROW_MOTOR_WEST_PINS_P[i] ), LOW );
+  }
+#endif
+
+  loadConfig();
+  sampleSensors( millis() );
+}
+
+//***********************************************************
+//     Function Name: update
+//
+//     Inputs:
+//     - currentTime : Current time in milliseconds
+//     - main : Main tracker, source of day/night and timing
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Samples the row sensors and steps every row in one pass.
+//       Rows balance their own sensors within their tolerance,
+//       using the main tracker's adjustment period, movement
+//       limit and brightness threshold, and follow its night mode
+//       by returning east and resting. A row start waits while
+//       any other motor started within the stagger time or the
+//       supply already runs as many motors as it can.
+//
+//***********************************************************
+void TrackerRows::update( unsigned long currentTime, const TrackerCore& main )
+{
+  sampleSensors( currentTime );
+
+  bool night = main.isNightMode();
+  unsigned long periodMs = main.getAdjustmentPeriod() * 1000UL;
+  unsigned long maxMoveMs = main.getMaxMovementTime() * 1000UL;
+  uint32_t brightnessThresholdOhms = (uint32_t)main.getBrightnessThreshold();
+
+  for( uint8_t i = 0; i < COUNT; i++ )
+  {
+    bool enabled = ( enabledMask & ( 1 << i ));
+    switch( state[i] )
+    {
+      case ROW_IDLE:
+      {
+        if( !enabled )
+        {
+          break;
+        }
+        if( night )
+        {
+          // Reverse only after the motor has been off for the dead time
+          if( currentTime - stateStartTime[i] >= MOTOR_DEAD_TIME_MS &&
+              startMotor( i, true, currentTime ))
+          {
+            state[i] = ROW_RETURNING;
+          }
+          break;
+        }
+        if( currentTime - lastAdjustmentTime[i] < periodMs ||
+            currentTime - stateStartTime[i] < MOTOR_DEAD_TIME_MS )
+        {
+          break;
+        }
+        uint32_t east = eastFiltered[i] >> TRACKER_ROW_FILTER_SHIFT;
+        uint32_t west = westFiltered[i] >> TRACKER_ROW_FILTER_SHIFT;
+        if( isBalanced( i ) || ( east + west ) / 2 > brightnessThresholdOhms )
+        {
+          lastAdjustmentTime[i] = currentTime;  // Nothing to do this period
+        }
+        else if( startMotor( i, east < west, currentTime ))
+        {
+          // Lower resistance means more light on that side
+          lastAdjustmentTime[i] = currentTime;
+          state[i] = ROW_ADJUSTING;
+        }
+        break;
+      }
+
+      case ROW_ADJUSTING:
+      {
+        bool east = ( movingEastMask & ( 1 << i ));
+        int32_t diff = (int32_t)( eastFiltered[i] >> TRACKER_ROW_FILTER_SHIFT ) -
+                       (int32_t)( westFiltered[i] >> TRACKER_ROW_FILTER_SHIFT );
+        // Crossing over means the balance point was passed
+        bool overshoot = east ? ( diff > 0 ) : ( diff < 0 );
+        if( night || !enabled || isBalanced( i ) || overshoot ||
+            currentTime - stateStartTime[i] >= maxMoveMs )
+        {
+          stopMotor( i, currentTime );
+          state[i] = ROW_IDLE;
+        }
+        break;
+      }
+
+      case ROW_RETURNING:
+        if( !enabled || currentTime - stateStartTime[i] >= MOTOR_MAX_MOVE_TIME_SECONDS * 1000UL )
+        {
+          stopMotor( i, currentTime );
+          state[i] = enabled ? ROW_NIGHT : ROW_IDLE;
+        }
+        break;
+
+      case ROW_NIGHT:
+        if( !night )
+        {
+          // First adjustment one period after dawn, like the main tracker
+          lastAdjustmentTime[i] = currentTime;
+          state[i] = ROW_IDLE;
+        }
+        break;
+    }
+  }
+}
+
+//***********************************************************
+//     Function Name: isStartAllowed
+//
+//     Inputs:
+//     - currentTime : Current time in milliseconds
+//     - starting : Main or elevation motor asking to start,
+//       nullptr for a row motor
+//
+//     Returns:
+//     - bool : True if no motor started within the stagger time
+//       and the supply has a motor to spare
+//
+//     Description:
+//     - Checks the last start of every motor on the board, then
+//       counts the running rows and the other running axis motor
+//       against the running-motor budget. Used by the rows and,
+//       through the supply input, by the main and elevation cores.
+//
+//***********************************************************
+bool TrackerRows::isStartAllowed( unsigned long currentTime, const MotorControl* starting ) const
+{
+  if( currentTime - lastStartTime < TRACKER_ROW_START_STAGGER_MS )
+  {
+    return false;
+  }
+  if( mainMotor != nullptr && mainMotor->getState() != MotorControl::STOPPED &&
+      currentTime - mainMotor->getMoveStartTime() < TRACKER_ROW_START_STAGGER_MS )
+  {
+    return false;
+  }
+  if( elevationMotor != nullptr && elevationMotor->getState() != MotorControl::STOPPED &&
+      currentTime - elevationMotor->getMoveStartTime() < TRACKER_ROW_START_STAGGER_MS )
+  {
+    return false;
+  }
+  // A running motor is never counted against its own start
+  uint8_t running = getRunningCount();
+  if( mainMotor != nullptr && mainMotor != starting && mainMotor->getState() != MotorControl::STOPPED )
+  {
+    running++;
+  }
+  if( elevationMotor != nullptr && elevationMotor != starting &&
+      elevationMotor->getState() != MotorControl::STOPPED )
+  {
+    running++;
+  }
+  return running < maxMotorsRunning;
+}
+
+// Row motors are energized exactly while adjusting or returning
+uint8_t TrackerRows::getRunningCount() const
+{
+  uint8_t running = 0;
+  for( uint8_t i = 0; i < COUNT; i++ )
+  {
+    if( state[i] == ROW_ADJUSTING || state[i] == ROW_RETURNING )
+    {
+      running++;
+    }
+  }
+  return running;
+}
+
+bool TrackerRows::setRowEnabled( uint8_t row, bool enabled )
+{
+  if( row < 1 || row > COUNT )
+  {
+    return false;
+  }
+  if( enabled )
+  {
+    enabledMask |= ( 1 << ( row - 1 ));
+  }
+  else
+  {
+    enabledMask &= ~( 1 << ( row - 1 ));
+  }
+  saveConfig();
+  return true;
+}
+
+bool TrackerRows::setRowTolerance( uint8_t row, uint8_t tolerancePercent )
+{
+  if( row < 1 || row > COUNT || tolerancePercent > 100 )
+  {
+    return false;
+  }
+  this->tolerancePercent[row - 1] = tolerancePercent;
+  saveConfig();
+  return true;
+}
+
+bool TrackerRows::isRowEnabled( uint8_t row ) const
+{
+  return ( row >= 1 && row <= COUNT && ( enabledMask & ( 1 << ( row - 1 ))));
+}
+
+uint8_t TrackerRows::getRowTolerance( uint8_t row ) const
+{
+  return ( row >= 1 && row <= COUNT ) ? tolerancePercent[row - 1] : 0;
+}
+
+TrackerRows::RowState TrackerRows::getRowState( uint8_t row ) const
+{
+  return ( row >= 1 && row <= COUNT ) ? (RowState)state[row - 1] : ROW_IDLE;
+}
+
+MotorControl::State TrackerRows::getRowMotorState( uint8_t row ) const
+{
+  if( row < 1 || row > COUNT ||
+      ( state[row - 1] != ROW_ADJUSTING && state[row - 1] != ROW_RETURNING ))
+  {
+    return MotorControl::STOPPED;
+  }
+  return ( movingEastMask & ( 1 << ( row - 1 ))) ? MotorControl::MOVING_EAST : MotorControl::MOVING_WEST;
+}
+
+uint32_t TrackerRows::getRowEastValue( uint8_t row ) const
+{
+  return ( row >= 1 && row <= COUNT ) ? eastFiltered[row - 1] >> TRACKER_ROW_FILTER_SHIFT : 0;
+}
+
+uint32_t TrackerRows::getRowWestValue( uint8_t row ) const
+{
+  return ( row >= 1 && row <= COUNT ) ? westFiltered[row - 1] >> TRACKER_ROW_FILTER_SHIFT : 0;
+}
+
+uint16_t TrackerRows::getRowMoveCount( uint8_t row ) const
+{
+  return ( row >= 1 && row <= COUNT ) ? moveCount[row - 1] : 0;
+}
+
+const char* TrackerRows::getRowStateName( RowState state )
+{
+  switch( state )
+  {
+    case ROW_IDLE: return "IDLE";
+    case ROW_ADJUSTING: return "ADJUSTING";
+    case ROW_RETURNING: return "RETURNING";
+    case ROW_NIGHT: return "NIGHT";
+    default: return "UNKNOWN";
+  }
+}
+
+//***********************************************************
+//     Function Name: sampleSensors
+//
+//     Inputs:
+//     - currentTime : Current time in milliseconds
+//
+//     Returns:
+//     - None
+//
+//     Description:
+//     - Reads every row sensor at the photosensor sampling rate
+//       and updates its integer EMA. Resistance is computed as in
+//       PhotoSensor with the same series resistor and limit.
+//
+//***********************************************************
+void TrackerRows::sampleSensors( unsigned long currentTime )
+{
+#if TRACKER_ROW_COUNT > 1
+  if( filterInitialized && currentTime - lastSampleTime < PHOTOSENSOR_SAMPLING_RATE_MS )
+  {
+    return;
+  }
+  lastSampleTime = currentTime;
+
+  for( uint8_t i = 0; i < COUNT; i++ )
+  {
+    for( uint8_t side = 0; side < 2; side++ )
+    {
+      uint8_t pin = pgm_read_byte( side ? &ROW_WEST_SENSOR_PINS_P[i] : &ROW_EAST_SENSOR_PINS_P[i] );
+      uint32_t* filtered = side ? &westFiltered[i] : &eastFiltered[i];
+      int reading = analogRead( pin );
+      uint32_t resistance = ( reading >= 1023 ) ? SENSOR_MAX_RESISTANCE_OHMS :
+                            ( TRACKER_ROW_SENSOR_SERIES_OHMS * (uint32_t)reading ) / ( 1023 - reading );
+      if( resistance > SENSOR_MAX_RESISTANCE_OHMS )
+      {
+        resistance = SENSOR_MAX_RESISTANCE_OHMS;
+      }
+      if( !filterInitialized )
+      {
+        *filtered = resistance << TRACKER_ROW_FILTER_SHIFT;
+      }
+      else
+      {
+        // filtered += sample - filtered / 2^shift, kept scaled by 2^shift
+        *filtered += resistance - ( *filtered >> TRACKER_ROW_FILTER_SHIFT );
+      }
+    }
+  }
+  filterInitialized = true;
+#else
+  (void)currentTime;
+#endif
+}
+
+//***********************************************************
+//     Function Name: startMotor
+//
+//     Inputs:
+//     - i : Row array index
+//     - east : Direction
+//     - currentTime : Current time in milliseconds
+//
+//     Returns:
+//     - bool : True if the motor was started
+//
+//     Description:
+//     - Energizes a row motor if the stagger and the supply
+//       allow a start now; otherwise the row tries again on the
+//       next update.
+//
+//***********************************************************
+bool TrackerRows::startMotor( uint8_t i, bool east, unsigned long currentTime )
+{
+  if( !isStartAllowed( currentTime, nullptr ))
+  {
+    // Count each held-back start once, not every retry
+    if( !( staggerWaitMask & ( 1 << i )))
+    {
+      staggerWaitMask |= ( 1 << i );
+      staggerDeferredCount++;
+    }
+    return false;
+  }
+  staggerWaitMask &= ~( 1 << i );
+#if TRACKER_ROW_COUNT > 1
+  digitalWrite( pgm_read_byte( &ROW_MOTOR_EAST_PINS_P[i] ), east ? HIGH : LOW );
+  digitalWrite( pgm_read_byte( &ROW_MOTOR_WEST_PINS_P[i] ), east ? LOW : HIGH );
+#endif
+  if( east )
+  {
+    movingEastMask |= ( 1 << i );
+  }
+  else
+  {
+    movingEastMask &= ~( 1 << i );
+  }
+  stateStartTime[i] = currentTime;
+  lastStartTime = currentTime;
+  moveCount[i]++;
+  return true;
+}
+
+void TrackerRows::stopMotor( uint8_t i, unsigned long currentTime )
+{
+#if TRACKER_ROW_COUNT > 1
+  digitalWrite( pgm_read_byte( &ROW_MOTOR_EAST_PINS_P[i] ), LOW );
+  digitalWrite( pgm_read_byte( &ROW_MOTOR_WEST_PINS_P[i] ), LOW );
+#endif
+  stateStartTime[i] = currentTime;
+}
+
+bool TrackerRows::isBalanced( uint8_t i ) const
+{
+  uint32_t east = eastFiltered[i] >> TRACKER_ROW_FILTER_SHIFT;
+  uint32_t west = westFiltered[i] >> TRACKER_ROW_FILTER_SHIFT;
+  uint32_t diff = ( east > west ) ? east - west : west - east;
+  uint32_t lower = ( east < west ) ? east : west;
+  return ( diff * 100UL <= lower * tolerancePercent[i] );
+}
+
+void TrackerRows::loadConfig()
+{
+  uint8_t config[CONFIG_SIZE];
+  if( !eeprom.loadRowConfig( config, CONFIG_SIZE ))
+  {
+    return;  // Keep the defaults
+  }
+  enabledMask = config[0];
+  for( uint8_t i = 0; i < CAPACITY; i++ )
+  {
+    if( config[1 + i] <= 100 )
+    {
+      tolerancePercent[i] = config[1 + i];
+    }
+  }
+}
+
+void TrackerRows::saveConfig()
+{
+  uint8_t config[CONFIG_SIZE];
+  config[0] = enabledMask;
+  for( uint8_t i = 0; i < CAPACITY; i++ )
+  {
+    config[1 + i] = tolerancePercent[i];
+  }
+  eeprom.saveRowConfig( config, CONFIG_SIZE );
+}
@@ -0,0 +1,90 @@
+#ifndef TRACKER_ROWS_H
+#define TRACKER_ROWS_H
+
+#include <Arduino.h>
+#include "param_config.h"
+#include "pins_config.h"
+#include "MotorControl.h"
+
+class TrackerCore;
+
+#if TRACKER_ROW_COUNT < 1 || TRACKER_ROW_COUNT - 1 > ROW_PIN_SLOTS
+#error "TRACKER_ROW_COUNT needs one row pin slot in pins_config.h per extra row"
+#endif
+
+// Compact balance trackers for rows 1..TRACKER_ROW_COUNT-1 of a multi-row
+// installation (row 0 is the main Tracker). Per-row state lives in parallel
+// arrays and every row is processed in one pass. Day/night and timing come
+// from the main tracker; every motor start on the board, including the main
+// and elevation motors, is staggered so inrush currents never overlap, and
+// row motors count against the supply's running-motor budget.
+class TrackerRows
+{
+public:
+  enum RowState
+  {
+    ROW_IDLE,        // Waiting for the next adjustment
+    ROW_ADJUSTING,   // Moving towards balance
+    ROW_RETURNING,   // Moving to full east at nightfall
+    ROW_NIGHT        // Resting until the main tracker sees day
+  };
+
+  static const uint8_t COUNT = TRACKER_ROW_COUNT - 1;
+  static const uint8_t CAPACITY = ( COUNT > 0 ) ? COUNT : 1;
+  static const uint8_t CONFIG_SIZE = 1 + CAPACITY;  // Enabled mask, then tolerance per row
+
+  TrackerRows();
+  void begin( MotorControl* mainMotor, MotorControl* elevationMotor );
+  void update( unsigned long currentTime, const TrackerCore& main );
+
+  // Start arbitration shared by every motor on the board; starting is the
+  // main or elevation motor asking, nullptr for a row
+  bool isStartAllowed( unsigned long currentTime, const MotorControl* starting ) const;
+  void setMaxMotorsRunning( uint8_t motors ) { maxMotorsRunning = ( motors < 1 ) ? 1 : motors; }
+  uint8_t getRunningCount() const;
+  unsigned long getStaggerDeferredCount() const { return staggerDeferredCount; }
+
+  // Per-row configuration (row index 1..COUNT, as shown on the terminal)
+  bool setRowEnabled( uint8_t row, bool enabled );
+  bool setRowTolerance( uint8_t row, uint8_t tolerancePercent );
+  bool isRowEnabled( uint8_t row ) const;
+  uint8_t getRowTolerance( uint8_t row ) const;
+
+  // Per-row state
+  RowState getRowState( uint8_t row ) const;
+  MotorControl::State getRowMotorState( uint8_t row ) const;
+  uint32_t getRowEastValue( uint8_t row ) const;
+  uint32_t getRowWestValue( uint8_t row ) const;
+  uint16_t getRowMoveCount( uint8_t row ) const;
+  static const char* getRowStateName( RowState state );
+
+private:
+  // Structure of arrays, indexed by row - 1
+  uint32_t eastFiltered[CAPACITY];          // Sensor EMA, ohms << TRACKER_ROW_FILTER_SHIFT
+  uint32_t westFiltered[CAPACITY];
+  unsigned long stateStartTime[CAPACITY];   // Move start, or rest start while idle
+  unsigned long lastAdjustmentTime[CAPACITY];
+  uint16_t moveCount[CAPACITY];
+  uint8_t state[CAPACITY];
+  uint8_t tolerancePercent[CAPACITY];
+  uint8_t enabledMask;                      // Bit n-1 set = row n tracks
+  uint8_t movingEastMask;                   // Bit n-1 set = row n motor runs east
+  uint8_t staggerWaitMask;                  // Bit n-1 set = row n start held back
+  uint8_t maxMotorsRunning;                 // Motors the supply can run at once
+
+  MotorControl* mainMotor;
+  MotorControl* elevationMotor;
+  unsigned long lastStartTime;              // Most recent row motor start
+  unsigned long lastSampleTime;
+  unsigned long staggerDeferredCount;       // Row starts held back by the stagger or the supply
+  bool filterInitialized;
+
+  void sampleSensors( unsigned long currentTime );
+  bool startMotor( uint8_t i, bool east, unsigned long currentTime );
+  void stopMotor( uint8_t i, unsigned long currentTime );
+  bool isBalanced( uint8_t i ) const;
+  void loadConfig();
+  void saveConfig();
+};
+
+#endif // TRACKER_ROWS_H
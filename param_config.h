@@ -17,9 +17,29 @@
 // Motor control settings
 #define MOTOR_MAX_MOVE_TIME_SECONDS 15
 #define MOTOR_DEAD_TIME_MS 100
+#define MOTOR_START_LIMIT_ENABLED true  // Rate-limit motor starts with a token bucket
+#define MOTOR_START_BURST 10  // Starts available back to back
+#define MOTOR_START_REFILL_PER_HOUR 30  // Sustained starts per hour
+#define MOTOR_BACKLASH_MS 0  // Configured gear backlash take-up time on reversals
+#define MOTOR_BACKLASH_LEARN_ENABLED false  // Estimate backlash from sensor response latency
+#define MOTOR_BACKLASH_RESPONSE_PERCENT 2.0f  // Imbalance change that counts as panel response
+#define MOTOR_BACKLASH_FILTER_ALPHA 0.25f  // Weight of each new latency sample
+#define MOTOR_BACKLASH_MAX_MS 5000  // Upper bound for configured and learned backlash
+#define MOTOR_TRAVEL_DEGREES 120  // Panel rotation between the east and west end stops
+#define MOTOR_SPEED_DEG_PER_S 10.0f  // Panel speed assumed until learned (full travel must fit in the timeout)
+#define MOTOR_SPEED_LEARN_SHIFT 2  // Learned speed moves 1/2^shift toward each measured arrival
+#define MOTOR_SOFT_LIMITS_ENABLED true  // Stop tracking moves short of the end stops
+#define MOTOR_SOFT_LIMIT_MARGIN_DEGREES 3  // Distance the soft limits keep from the end stops
+#define MOTOR_HOME_MARGIN_MS 1500  // Extra run time on a planned night return to seat against the stop
+#define MOTOR_PWM_ENABLED false  // Drive the motor with PWM: soft-start ramp and slow final approach
+#define MOTOR_PWM_RAMP_MS 1000  // Time for the duty to ramp from the start duty to full
+#define MOTOR_PWM_START_PERCENT 30  // Duty at the start of the ramp
+#define MOTOR_PWM_APPROACH_PERCENT 50  // Duty once nearly balanced (keep above 1/3 for stall detection)
+#define MOTOR_QUEUE_CAPACITY 4  // Motor commands that can be queued ahead
 
 // Tracker settings
 #define TRACKER_TOLERANCE_PERCENT 10.0f
+#define TRACKER_APPROACH_TOLERANCE_MULTIPLE 3  // Within this many tolerances the motor slows for the final approach
 #define TRACKER_MAX_MOVEMENT_TIME_SECONDS 15
 #define TRACKER_ADJUSTMENT_PERIOD_SECONDS 300  // 300 sec (5 min)
 #define TRACKER_SAMPLING_RATE_MS 100
@@ -27,11 +47,25 @@
 #define TRACKER_BRIGHTNESS_FILTER_TIME_CONSTANT_S 10  // 10 seconds
 #define TRACKER_REVERSAL_TIME_LIMIT_MS 1000  // 1 second default reversal time limit
 
+// Dual-axis settings
+#define TRACKER_DUAL_AXIS 0  // 1 = elevation motor and up/down sensors fitted
+#define TRACKER_ELEVATION_TOLERANCE_PERCENT 10.0f  // Up/down balance tolerance
+#define TRACKER_ELEVATION_ADJUSTMENT_PERIOD_SECONDS 900  // Elevation changes slower than azimuth
+#define TRACKER_ELEVATION_MAX_MOVEMENT_TIME_SECONDS 15
+#define TRACKER_MAX_MOTORS_RUNNING 1  // Motors the supply can run at once (1 = axes move in turn)
+#define TRACKER_ROW_COUNT 1  // Tracker rows driven by this board (row 0 = main tracker)
+#define TRACKER_ROW_TOLERANCE_PERCENT 10  // Default balance tolerance of the extra rows
+#define TRACKER_ROW_START_STAGGER_MS 500  // Minimum time between any two motor starts with rows fitted
+#define TRACKER_ROW_FILTER_SHIFT 3  // Row sensor EMA weight is 1/2^shift per sample
+#define TRACKER_ROW_SENSOR_SERIES_OHMS 1000  // Series resistor of the row photosensors
+
 // Default west movement settings
 #define TRACKER_ENABLE_DEFAULT_WEST_MOVEMENT true  // Disabled by default
 #define TRACKER_DEFAULT_WEST_MOVEMENT_MS 500  // 500ms default west movement time
 #define TRACKER_USE_AVERAGE_MOVEMENT_TIME true  // Use average of past successful movements
 #define TRACKER_MOVEMENT_HISTORY_SIZE 3  // Number of past movements to track
+#define TRACKER_MOVEMENT_HISTORY_CAPACITY 10  // Largest history size (statically allocated)
+#define TRACKER_MOVEMENT_AVERAGE_MODE 0  // History average: 0=mean, 1=trimmed mean, 2=median
 
 // Terminal settings
 #define TERMINAL_PRINT_PERIOD_MS 1000  // 1 second
@@ -55,4 +89,125 @@
 #define TRACKER_MIN_WAIT_TIME_SECONDS 120  // 120 seconds minimum wait time
 #define TRACKER_MONITOR_FILTER_TIME_CONSTANT_S 120  // 120 seconds monitor filter time constant
 
+// Adaptive adjustment scheduling settings
+#define TRACKER_ADAPTIVE_SCHEDULE_ENABLED false  // Use fixed adjustment period by default
+#define TRACKER_ADJUSTMENT_PERIOD_MIN_SECONDS 60  // Shortest scheduled interval (1 min)
+#define TRACKER_ADJUSTMENT_PERIOD_MAX_SECONDS 900  // Longest scheduled interval (15 min)
+#define TRACKER_DRIFT_ESTIMATE_WEIGHT 0.3f  // EMA weight of each new drift/gain sample
+#define TRACKER_DRIFT_MIN_PROGRESS_PERCENT 1.0f  // Minimum imbalance removed for a gain sample
+
+// Cloud transient detection settings
+#define TRACKER_CLOUD_DETECT_ENABLED false  // Cloud gating disabled by default
+#define TRACKER_CLOUD_THRESHOLD_PERCENT 5.0f  // Variation/rate limit for stable light
+#define TRACKER_CLOUD_HOLDOFF_SECONDS 60  // Calm time required before adjusting
+#define TRACKER_CLOUD_WINDOW_SAMPLES 100  // Samples per statistics window (2s at 20ms)
+
+// Motor stall detection settings
+#define TRACKER_STALL_DETECT_ENABLED true  // Stop the motor when the sensors stop responding to a move
+#define TRACKER_STALL_STEP_PERCENT 0.5f  // Imbalance change that counts as panel progress
+#define TRACKER_STALL_DEFAULT_WINDOW_MS 3000  // Response window until one has been learned
+#define TRACKER_STALL_WINDOW_FACTOR 3.0f  // Windows are this multiple of the learned response and step times
+#define TRACKER_STALL_MIN_WINDOW_MS 500  // Shortest window (sensor filter lag)
+#define TRACKER_STALL_MAX_WINDOW_MS 10000  // Longest window
+#define TRACKER_STALL_LEARN_WEIGHT 0.25f  // EMA weight of each new response and step time
+#define TRACKER_STALL_END_STOP_ZONE_DEGREES 10  // A stall this close to an end stop is the stop, not a jam
+
+// Energy-aware tracking settings
+#define TRACKER_ENERGY_AWARE_ENABLED false  // Move whenever sensors say so by default
+#define TRACKER_PANEL_POWER_W 100.0f  // Panel output at full sun
+#define TRACKER_MOTOR_POWER_W 24.0f  // Electrical power drawn while the motor runs
+#define TRACKER_DEGREES_PER_PERCENT 0.5f  // Panel angle error per percent of sensor imbalance
+#define TRACKER_FULL_SUN_OHMS 1000  // Average sensor resistance at full sun
+
+// Kalman sun-angle estimator settings (angle in percent of sensor imbalance)
+#define TRACKER_KALMAN_ENABLED false  // Use raw filtered sensor values by default
+#define TRACKER_KALMAN_ANGLE_NOISE 0.5f  // Angle process noise (%^2 per second)
+#define TRACKER_KALMAN_RATE_NOISE 0.0001f  // Drift rate process noise ((%/s)^2 per second)
+#define TRACKER_KALMAN_MEASUREMENT_NOISE 4.0f  // Sensor imbalance measurement noise (%^2)
+#define TRACKER_KALMAN_INITIAL_RATE_VARIANCE 0.01f  // Initial drift rate variance ((%/s)^2)
+#define TRACKER_KALMAN_CONFIDENCE_SIGMAS 2.0f  // Error must exceed tolerance by this many sigma
+#define TRACKER_KALMAN_DEFAULT_MS_PER_PERCENT 50.0f  // Motor effect until a gain is learned
+
+// Row-to-row shading backtracking settings (tilt from flat = position less half the travel)
+#define TRACKER_BACKTRACK_ENABLED false  // Face the sun at all elevations by default
+#define TRACKER_ROW_PITCH_MM 5000  // Distance between neighbouring row axes
+#define TRACKER_PANEL_WIDTH_MM 2000  // Panel width across the rotation axis
+#define TRACKER_BACKTRACK_DAY_HOURS 12  // Dawn-to-dusk span assumed until one has been measured
+#define TRACKER_BACKTRACK_MIN_DAY_HOURS 4  // Shorter spans between night detections are not days
+#define TRACKER_BACKTRACK_DEADBAND_DEGREES 1  // Smallest correction towards the backtracking tilt
+
+// Dawn sun search settings (positions are motor run time west of full east)
+#define TRACKER_SUN_SEARCH_ENABLED false  // Balance from full east after night by default
+#define TRACKER_SUN_SEARCH_STEPS 8  // Maximum brightness probes per search
+#define TRACKER_SUN_SEARCH_TIMEOUT_SECONDS 120  // Abandon the search after this long
+#define TRACKER_SUN_SEARCH_SPAN_SECONDS 20  // Motor travel from full east covered by the search
+#define TRACKER_SUN_SEARCH_SETTLE_MS 1000  // Wait after each move before sampling brightness
+#define TRACKER_SUN_SEARCH_MIN_INTERVAL_MS 250  // Stop narrowing below this bracket width
+#define TRACKER_GOLDEN_RATIO_CONJUGATE 0.618034f  // Golden-section interior point ratio
+
+// Auto-tuning settings (noise is measured while the panel is stationary)
+#define AUTOTUNE_ENABLED false  // Keep hand-tuned parameters by default
+#define AUTOTUNE_WINDOW_SAMPLES 50  // Sample pairs per noise window (1s at 20ms)
+#define AUTOTUNE_MIN_WINDOWS 60  // Quiet windows needed before noise-based tuning
+#define AUTOTUNE_MIN_ADJUSTMENTS 5  // Adjustments needed before outcome-based tuning
+#define AUTOTUNE_LOW_LIGHT_OHMS 10000  // Average brightness above this counts as low light
+#define AUTOTUNE_TOLERANCE_SIGMAS 3.0f  // Tolerance floor in imbalance noise standard deviations
+#define AUTOTUNE_TOLERANCE_MIN_PERCENT 2.0f  // Safe tolerance bounds
+#define AUTOTUNE_TOLERANCE_MAX_PERCENT 25.0f
+#define AUTOTUNE_START_THRESHOLD_RATIO 1.5f  // Start threshold at least this multiple of tolerance
+#define AUTOTUNE_START_THRESHOLD_MAX_PERCENT 50.0f
+#define AUTOTUNE_REVERSAL_RATE_HIGH 0.25f  // Reversals per adjustment that widen tolerance
+#define AUTOTUNE_REPEAT_RATE_HIGH 0.25f  // Repeat moves per adjustment that raise the start threshold
+#define AUTOTUNE_REPEAT_INTERVAL_SECONDS 180  // Adjustment this soon after a balance is a repeat
+#define AUTOTUNE_INCREASE_FACTOR 1.25f  // Step when outcomes call for a wider setting
+#define AUTOTUNE_DECREASE_FACTOR 0.9f  // Step back toward the noise floor on clean days
+#define AUTOTUNE_BRIGHTNESS_NOISE_TARGET_PERCENT 1.0f  // Filtered brightness noise target
+#define AUTOTUNE_MONITOR_NOISE_SIGMAS 4.0f  // Start threshold in filtered imbalance noise sigmas
+#define AUTOTUNE_TAU_MIN_S 1.0f  // Safe filter time constant bounds
+#define AUTOTUNE_TAU_MAX_S 300.0f
+#define AUTOTUNE_MIN_CHANGE 0.05f  // Ignore relative changes smaller than this
+
+// Shading map settings (time of day is measured from the night to day transition)
+#define SHADING_MAP_ENABLED false  // Learn only; do not defer adjustments by default
+#define SHADING_SLOT_MINUTES 10  // Width of one map slot
+#define SHADING_SLOTS 96  // Slots after dawn covered by the map (16 hours)
+#define SHADING_BASELINE_TAU_S 120  // Per-sensor baseline filter time constant
+#define SHADING_DROP_PERCENT 25.0f  // One sensor this much darker than its baseline starts an anomaly
+#define SHADING_STABLE_PERCENT 10.0f  // Other sensor must stay within this of its baseline
+#define SHADING_RECOVER_PERCENT 10.0f  // Anomaly ends when the shaded sensor is back within this
+#define SHADING_MIN_DURATION_SECONDS 30  // Shorter anomalies are ignored
+#define SHADING_MAX_DURATION_MINUTES 20  // Longer anomalies are real changes, not shading
+#define SHADING_SCORE_HIT 96  // Score added to a slot shaded today
+#define SHADING_SCORE_DECAY_SHIFT 2  // Unshaded slots lose score >> shift each day
+#define SHADING_SCORE_THRESHOLD 128  // Slot score that predicts shading (two hits)
+
+// Tracking strategy settings
+#define TRACKER_STRATEGY_SENSOR_BALANCE 0  // Balance the east/west photosensors
+#define TRACKER_STRATEGY_HILL_CLIMB 1  // Perturb and observe measured panel power
+#define TRACKER_STRATEGY_PLANNED 2  // Model-predictive move plans over a short horizon
+#define TRACKER_STRATEGY TRACKER_STRATEGY_SENSOR_BALANCE
+// #define TRACKER_FIXED_STRATEGY TRACKER_STRATEGY_HILL_CLIMB  // Compile in one strategy; ignores tracking_strategy
+#define TRACKER_HILL_CLIMB_STEP_MS 300  // Motor time per perturbation
+#define TRACKER_HILL_CLIMB_MAX_STEPS 6  // Maximum perturbations per adjustment
+#define TRACKER_HILL_CLIMB_DEADBAND_PERCENT 1.0f  // Power gain required to keep a step
+#define TRACKER_HILL_CLIMB_SETTLE_MS 1500  // Wait after each perturbation before measuring
+#define TRACKER_PLANNER_HORIZON_STEPS 4  // Adjustment opportunities each plan looks ahead
+#define TRACKER_PLANNER_START_COST_MWH 1.0f  // Charged per motor start (dead time, wear, start budget)
+#define TRACKER_PLANNER_SETTLE_MS 1500  // Wait after a planned move before measuring the result
+#define TRACKER_PLANNER_MIN_OBSERVATION_S 60  // Shortest interval a drift sample is taken over
+
+// Panel power measurement settings
+#define POWER_SOURCE_SIMULATED 0  // Power modelled from the photosensors
+#define POWER_SOURCE_ANALOG 1  // Voltage divider and current sensor on analog pins
+#define POWER_SENSOR_SOURCE POWER_SOURCE_SIMULATED
+#define POWER_SENSOR_SAMPLING_RATE_MS 100  // Power sample period
+#define POWER_SENSOR_EMA_TIME_CONSTANT_MS 500  // Power EMA filter time constant
+#define POWER_SENSOR_OVERSAMPLE 4  // ADC readings averaged per channel and sample
+#define POWER_ADC_REFERENCE_V 5.0f  // ADC reference voltage
+#define POWER_VOLTAGE_DIVIDER_RATIO 6.0f  // Panel volts per volt at the ADC pin
+#define POWER_CURRENT_OFFSET_V 2.5f  // Current sensor output at zero amps
+#define POWER_CURRENT_SENSITIVITY_V_PER_A 0.066f  // Current sensor output per amp
+#define POWER_SIM_VOLTAGE 12.0f  // Simulated panel voltage
+#define POWER_SIM_SENSOR_OFFSET_PERCENT 3.0f  // Simulated photosensor mismatch at peak power
+
 #endif // PARAM_CONFIG_H
@@ -9,4 +9,23 @@
 #define MOTOR_EAST_PIN 7
 #define MOTOR_WEST_PIN 6
 
+// Elevation axis pins (used when TRACKER_DUAL_AXIS is enabled)
+#define MOTOR_UP_PIN 5
+#define MOTOR_DOWN_PIN 2
+#define UP_SENSOR_PIN A2
+#define DOWN_SENSOR_PIN A3
+
+// Extra tracker row pins (used when TRACKER_ROW_COUNT > 1), entry n-1 = row n.
+// Row motors are switched on/off, so they sit on the digital-only header
+// (22-53), clear of the PWM pins and of pin 13, the bootloader's LED.
+#define ROW_PIN_SLOTS 3
+#define ROW_EAST_SENSOR_PINS { A4, A6, A10 }
+#define ROW_WEST_SENSOR_PINS { A5, A7, A11 }
+#define ROW_MOTOR_EAST_PINS { 22, 24, 26 }
+#define ROW_MOTOR_WEST_PINS { 23, 25, 27 }
+
+// Panel power measurement pins
+#define POWER_VOLTAGE_PIN A8
+#define POWER_CURRENT_PIN A9
+
 #endif // PINS_CONFIG_H
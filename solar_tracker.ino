@@ -5,6 +5,7 @@
 #include "Graph.h"
 #include "Photosensor.h"
 #include "MotorControl.h"
+#include "PowerSensor.h"
 #include "Tracker.h"
 #include "Terminal.h"
 #include "Settings.h"
@@ -18,8 +19,22 @@ DisplayModule_t displayModule;
 Graph_t graph;
 PhotoSensor eastSensor(A0, 1000);
 PhotoSensor westSensor(A1, 1000);
+#if POWER_SENSOR_SOURCE == POWER_SOURCE_ANALOG
+AnalogPowerSensor powerSensor(POWER_VOLTAGE_PIN, POWER_CURRENT_PIN);
+#else
+SimulatedPowerSensor powerSensor(&eastSensor, &westSensor);
+#endif
 MotorControl motorControl;
 Tracker tracker(&eastSensor, &westSensor, &motorControl);
+#if TRACKER_DUAL_AXIS
+PhotoSensor upSensor(UP_SENSOR_PIN, 1000);
+PhotoSensor downSensor(DOWN_SENSOR_PIN, 1000);
+MotorControl elevationMotor(MOTOR_UP_PIN, MOTOR_DOWN_PIN);
+TrackerCore elevationCore;
+#endif
+#if TRACKER_ROW_COUNT > 1
+TrackerRows rows;
+#endif
 Terminal terminal;
 Settings settings;
 
@@ -34,7 +49,7 @@ Settings settings;
 //
 //     Description:
 //     - Initializes the solar tracker system including I2C, display,
-//       graph, photosensors, motor control, tracker, terminal,
+//       graph, photosensors, power sensor, motor control, tracker, terminal,
 //       settings, and EEPROM modules. Sets up command interface.
 //
 //***********************************************************
@@ -46,7 +61,18 @@ void setup()
   Graph_init( &graph, displayModule.display );
   eastSensor.begin();
   westSensor.begin();
+  powerSensor.begin();
   motorControl.begin();
+  tracker.setPowerSensor( &powerSensor );
+#if TRACKER_DUAL_AXIS
+  upSensor.begin();
+  downSensor.begin();
+  elevationMotor.begin();
+  tracker.setElevationAxis( &elevationCore, &upSensor, &downSensor, &elevationMotor );
+#endif
+#if TRACKER_ROW_COUNT > 1
+  tracker.setRows( &rows );
+#endif
   tracker.begin();
   terminal.begin();
   
@@ -69,7 +95,7 @@ void setup()
 //
 //     Description:
 //     - Main control loop that runs continuously. Updates photosensors,
-//       motor control, tracker state machine, terminal logging and
+//       power sensor, motor control, tracker state machine, terminal logging and
 //       command processing, and refreshes the display.
 //
 //***********************************************************
@@ -78,11 +104,21 @@ void loop()
   // Update photosensor sampling every 100ms internally
   eastSensor.update();
   westSensor.update();
+#if TRACKER_DUAL_AXIS
+  upSensor.update();
+  downSensor.update();
+#endif
+
+  // Update panel power measurement
+  powerSensor.update();
 
   // Update motor control state
   motorControl.update();
+#if TRACKER_DUAL_AXIS
+  elevationMotor.update();
+#endif
 
-  // Update tracker state machine
+  // Update tracker state machine (and any extra rows)
   tracker.update();
 
   // Update terminal logging and command processing
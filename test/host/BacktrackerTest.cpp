@@ -0,0 +1,93 @@
+// Checks the fixed-point backtracking kernel against the double-precision
+// geometry it replaces: tilt = asin(sin(e) / gcr) - e while the rows
+// shade (sin(e) < gcr), 90 - e once they clear. Sweeps GCR 0.01-0.99 in
+// 0.001 steps and sun elevations 0-90 degrees in 0.1 degree steps.
+
+#include "HostTest.h"
+#include "Backtracker.h"
+
+static const double DEG = 3.14159265358979 / 180.0;
+static const double ELEVATION_SLACK_DEG = 0.05;
+
+static double referenceTilt( double elevationDeg, double gcr )
+{
+  if( elevationDeg <= 0.0 || elevationDeg >= 90.0 )
+  {
+    return 0.0;
+  }
+  double sinElevation = sin( elevationDeg * DEG );
+  if( sinElevation >= gcr )
+  {
+    return 90.0 - elevationDeg;
+  }
+  double tilt = asin( sinElevation / gcr ) / DEG - elevationDeg;
+  return ( tilt > 0.0 ) ? tilt : 0.0;
+}
+
+int main()
+{
+  // Sine table and its inverse
+  double worstSin = 0.0;
+  double worstAsin = 0.0;
+  for( int32_t mdeg = 0; mdeg <= 90000; mdeg += 10 )
+  {
+    double sinError = fabs( Backtracker::sinQ15( mdeg ) / 32768.0 - sin( mdeg / 1000.0 * DEG ));
+    worstSin = max( worstSin, sinError );
+    uint16_t value = (uint16_t)( sin( mdeg / 1000.0 * DEG ) * 32768.0 + 0.5 );
+    double asinError = fabs( Backtracker::asinMdeg( value ) / 1000.0 - asin( value / 32768.0 ) / DEG );
+    worstAsin = max( worstAsin, asinError );
+  }
+
+  // Shade-free tilt. The exact tilt has infinite slope at the shading
+  // threshold, where one LSB of the Q15 sine moves it by a degree or
+  // more; there the kernel is held to the reference over the elevations
+  // within 0.05 degrees (12 s of sun travel) instead.
+  double worst = 0.0;
+  double worstNearThreshold = 0.0;
+  double worstPointwise = 0.0;
+  double worstGcr = 0.0;
+  double worstElevation = 0.0;
+  for( int gcrPermille = 10; gcrPermille <= 990; gcrPermille++ )
+  {
+    uint16_t gcrQ15 = (uint16_t)( gcrPermille * 32768L / 1000 );
+    double gcr = gcrQ15 / 32768.0;
+    double thresholdDeg = asin( gcr ) / DEG;
+    for( int32_t mdeg = 0; mdeg <= 90000; mdeg += 100 )
+    {
+      double elevation = mdeg / 1000.0;
+      double tilt = Backtracker::getShadeFreeTilt( mdeg, gcrQ15 ) / 1000.0;
+      double reference = referenceTilt( elevation, gcr );
+      worstPointwise = max( worstPointwise, fabs( tilt - reference ));
+      if( fabs( elevation - thresholdDeg ) <= ELEVATION_SLACK_DEG )
+      {
+        double low = min( reference, min( referenceTilt( elevation - ELEVATION_SLACK_DEG, gcr ),
+                                          referenceTilt( elevation + ELEVATION_SLACK_DEG, gcr )));
+        double high = 90.0 - thresholdDeg;   // Peak of the tilt, at the threshold
+        double error = ( tilt < low ) ? low - tilt : (( tilt > high ) ? tilt - high : 0.0 );
+        worstNearThreshold = max( worstNearThreshold, error );
+        continue;
+      }
+      double error = fabs( tilt - reference );
+      if( error > worst )
+      {
+        worst = error;
+        worstGcr = gcr;
+        worstElevation = elevation;
+      }
+    }
+  }
+
+  printf( "sinQ15 worst error %.6f, asinMdeg worst error %.3f deg\n", worstSin, worstAsin );
+  printf( "shade-free tilt worst error %.3f deg (gcr %.3f, elevation %.1f deg), %.3f deg at the threshold "
+          "(%.3f deg pointwise)\n", worst, worstGcr, worstElevation, worstNearThreshold, worstPointwise );
+
+  CHECK( worstSin < 3.0 / 32768.0 );
+  CHECK( worstAsin < 0.1 );
+  CHECK( worst < 0.2 );
+  CHECK( worstNearThreshold < 0.05 );
+  CHECK( worstPointwise < 1.5 );
+  CHECK( Backtracker::getShadeFreeTilt( 0, 16384 ) == 0 );
+  CHECK( Backtracker::getShadeFreeTilt( 90000, 16384 ) == 0 );
+  CHECK( Backtracker::getShadeFreeTilt( 60000, 16384 ) == 30000 );   // sin 60 > 0.5: face the sun
+  return hostTestResult( "BacktrackerTest" );
+}
@@ -0,0 +1,188 @@
+#include <time.h>
+#include "DaySim.h"
+
+static const unsigned long DAY_MS = 12UL * 3600UL * 1000UL;
+static const unsigned long STEP_MS = 10;
+static const double PANEL_SPEED_DEG_PER_MS = 0.1 / 1000.0;
+
+static double sunAngle( unsigned long timeMs )
+{
+  return -60.0 + 120.0 * ( (double)timeMs / DAY_MS );
+}
+
+static void readSensors( TrackerCore::Inputs& in, double errorDeg )
+{
+  double base = 2000.0;
+  in.eastValue = (int32_t)( base * ( 1.0 + 0.02 * errorDeg ));
+  in.westValue = (int32_t)( base * ( 1.0 - 0.02 * errorDeg ));
+  in.eastValue = max( in.eastValue, (int32_t)100 );
+  in.westValue = max( in.westValue, (int32_t)100 );
+}
+
+// Motor plan as MotorControl's queue runs it: commands in order, a timed
+// move holding the queue until it ends and a stop for its hold time
+struct SimPlan
+{
+  uint8_t move[TrackerCore::MOTOR_PLAN_STEPS];
+  unsigned long durationMs[TrackerCore::MOTOR_PLAN_STEPS];
+  uint8_t length;
+  uint8_t next;                     // Command to run or finish next
+  bool running;                     // Command next has started
+  unsigned long startTime;
+  uint8_t doneMask;                 // Finished since the core last stepped
+};
+
+// A new plan replaces the running one
+static void startPlan( const TrackerCore::Outputs& out, SimPlan& plan )
+{
+  if( out.motorPlanLength == 0 )
+  {
+    return;
+  }
+  plan.length = out.motorPlanLength;
+  for( uint8_t i = 0; i < plan.length; i++ )
+  {
+    plan.move[i] = out.motorPlan[i].move;
+    plan.durationMs[i] = out.motorPlan[i].durationMs;
+  }
+  plan.next = 0;
+  plan.running = false;
+}
+
+// Panel output falls with the cosine of the pointing error
+static float panelPower( double errorDeg )
+{
+  double power = TRACKER_PANEL_POWER_W * cos( errorDeg * M_PI / 180.0 );
+  return (float)( power > 0.0 ? power : 0.0 );
+}
+
+DayResult runDay( TrackerCore& core, double sensorBiasDeg )
+{
+  TrackerCore::Inputs in = {};
+  TrackerCore::Outputs out;
+  MotorControl::State motor = MotorControl::STOPPED;
+  unsigned long moveEndTime = 0;    // 0 = untimed
+  double panel = -30.0;
+  double errorSum = 0.0;
+  double errorSquareSum = 0.0;
+  unsigned long errorSamples = 0;
+  SimPlan plan = {};
+  DayResult result = {};
+
+  in.motorState = motor;
+  in.motorCanStart = true;
+  in.supplyAvailable = true;
+  in.powerValid = true;
+  in.powerW = panelPower( sunAngle( 0 ) - panel );
+  readSensors( in, sunAngle( 0 ) - panel + sensorBiasDeg );
+  core.begin( in );
+
+  clock_t start = clock();
+  unsigned long t;
+  for( t = 0; t < DAY_MS; t += STEP_MS )
+  {
+    if( motor != MotorControl::STOPPED && moveEndTime != 0 && t >= moveEndTime )
+    {
+      motor = MotorControl::STOPPED;
+    }
+    if( motor == MotorControl::MOVING_EAST )
+    {
+      panel -= STEP_MS * PANEL_SPEED_DEG_PER_MS;
+      result.runMs += STEP_MS;
+    }
+    else if( motor == MotorControl::MOVING_WEST )
+    {
+      panel += STEP_MS * PANEL_SPEED_DEG_PER_MS;
+      result.runMs += STEP_MS;
+    }
+    double error = sunAngle( t ) - panel;
+    readSensors( in, error + sensorBiasDeg );
+    in.powerW = panelPower( error );
+    result.energyWh += in.powerW * ( STEP_MS / 3600000.0 );
+    in.energyWh = (float)result.energyWh;
+    if( t % 1000 == 0 )
+    {
+      errorSum += fabs( error );
+      errorSquareSum += error * error;
+      errorSamples++;
+    }
+
+    in.timeMs = t;
+    in.timeUs = t * 1000UL;
+    in.motorState = motor;
+    in.motorRunTimeMs = result.runMs;
+    in.samplePair = ( t % 100 == 0 );
+    in.sampleMicros = in.timeUs;
+    in.motorPlanDone = plan.doneMask;
+    plan.doneMask = 0;
+
+    core.step( in, out );
+    result.steps++;
+    result.transitions += out.transitions;
+
+    if( out.motorStop )
+    {
+      motor = MotorControl::STOPPED;
+      plan.length = 0;
+      plan.doneMask = 0;
+    }
+    if( out.motorMove != TrackerCore::MOTOR_NONE )
+    {
+      MotorControl::State next = ( out.motorMove == TrackerCore::MOTOR_EAST ) ?
+                                 MotorControl::MOVING_EAST : MotorControl::MOVING_WEST;
+      if( motor != next )
+      {
+        in.motorMoveStartTime = t;
+        result.starts++;
+      }
+      // Direct moves run until the core stops them; timed ones come as a plan
+      motor = next;
+      moveEndTime = 0;
+      result.moves++;
+    }
+
+    startPlan( out, plan );
+    while( plan.next < plan.length )
+    {
+      uint8_t move = plan.move[plan.next];
+      unsigned long durationMs = plan.durationMs[plan.next];
+      if( !plan.running )
+      {
+        plan.running = true;
+        plan.startTime = t;
+        if( move == TrackerCore::MOTOR_NONE )
+        {
+          motor = MotorControl::STOPPED;
+        }
+        else
+        {
+          MotorControl::State next = ( move == TrackerCore::MOTOR_EAST ) ?
+                                     MotorControl::MOVING_EAST : MotorControl::MOVING_WEST;
+          if( motor != next )
+          {
+            in.motorMoveStartTime = t;
+            result.starts++;
+          }
+          motor = next;
+          moveEndTime = ( durationMs > 0 ) ? t + durationMs : 0;
+          result.moves++;
+        }
+      }
+      // Untimed moves finish once started
+      bool finished = ( move == TrackerCore::MOTOR_NONE ) ? ( t - plan.startTime >= durationMs ) :
+                      ( durationMs == 0 || motor == MotorControl::STOPPED );
+      if( !finished )
+      {
+        break;
+      }
+      plan.doneMask |= ( 1 << plan.next );
+      plan.next++;
+      plan.running = false;
+    }
+  }
+  result.seconds = (double)( clock() - start ) / CLOCKS_PER_SEC;
+  result.meanErrorDeg = errorSum / errorSamples;
+  result.rmsErrorDeg = sqrt( errorSquareSum / errorSamples );
+  result.finalErrorDeg = sunAngle( t ) - panel;
+  return result;
+}
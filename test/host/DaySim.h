@@ -0,0 +1,31 @@
+#ifndef DAY_SIM_H
+#define DAY_SIM_H
+
+#include "TrackerCore.h"
+
+// Shared 12 h day for the TrackerCore simulations: the sun crosses from
+// 60 deg east to 60 deg west, the panel starts 30 deg east and moves at
+// 0.1 deg/s while the motor runs, and the sensors see a 2 % resistance
+// difference per degree of pointing error, offset by sensorBiasDeg (a
+// soiled or mismatched pair balances that far off the sun). Panel power is
+// TRACKER_PANEL_POWER_W times the cosine of the pointing error. Steps every
+// 10 ms with a sensor pair every 100 ms, the loop rate of the sketch. Motor
+// plans run as MotorControl's queue would run them, timed moves stopping
+// after their run time.
+struct DayResult
+{
+  unsigned long steps;
+  unsigned long moves;              // Move commands, direct or from a plan
+  unsigned long starts;             // Moves that started the motor
+  unsigned long runMs;              // Motor run time
+  unsigned long transitions;
+  double meanErrorDeg;              // Mean |pointing error|, sampled each second
+  double rmsErrorDeg;
+  double finalErrorDeg;
+  double energyWh;                  // Panel energy over the day
+  double seconds;                   // Host time for the day
+};
+
+DayResult runDay( TrackerCore& core, double sensorBiasDeg = 0.0 );
+
+#endif // DAY_SIM_H
@@ -0,0 +1,181 @@
+// Benchmarks the per-step sensor math of TrackerCore alone: the float path
+// it replaced (brightness and monitor EMAs with a dt / tau weight, percent
+// tolerance) against updateFilter() and exceedsPpm(), over the same
+// samples. Both paths must agree to the ohm and make the same balance
+// decisions.
+//
+// The host times both, but its FPU makes float cheap, so it also counts the
+// float operations the old path makes per step: on the ATmega2560 each is
+// a soft-float library call, where the fixed-point path is integer adds,
+// compares and 32x32-bit multiplies only.
+
+#include <time.h>
+#include "HostTest.h"
+#include "TrackerCore.h"
+
+static const unsigned long STEP_MS = 10;
+static const int SAMPLES = 4096;
+static const int PASSES = 2000;
+
+static int32_t eastOhms[SAMPLES];
+static int32_t westOhms[SAMPLES];
+static float eastFloat[SAMPLES];
+static float westFloat[SAMPLES];
+
+// Sensor pair drifting through the day with a few percent of noise
+static void makeSamples()
+{
+  uint32_t seed = 12345;
+  for( int i = 0; i < SAMPLES; i++ )
+  {
+    seed = seed * 1103515245UL + 12345UL;
+    int32_t noise = (int32_t)(( seed >> 16 ) % 200 ) - 100;
+    int32_t base = 2000 + ( i * 30000 ) / SAMPLES;
+    eastOhms[i] = base + noise;
+    westOhms[i] = base + base / 20 - noise;
+    eastFloat[i] = (float)eastOhms[i];
+    westFloat[i] = (float)westOhms[i];
+  }
+}
+
+// Float that counts what it does, for the operation count of the old path
+struct CountedFloat
+{
+  float v;
+  CountedFloat( float value = 0.0f ) : v( value ) {}
+  static unsigned long adds;
+  static unsigned long multiplies;
+  static unsigned long divides;
+  static unsigned long compares;
+};
+
+unsigned long CountedFloat::adds = 0;
+unsigned long CountedFloat::multiplies = 0;
+unsigned long CountedFloat::divides = 0;
+unsigned long CountedFloat::compares = 0;
+
+static CountedFloat operator+( CountedFloat a, CountedFloat b ) { CountedFloat::adds++; return a.v + b.v; }
+static CountedFloat operator-( CountedFloat a, CountedFloat b ) { CountedFloat::adds++; return a.v - b.v; }
+static CountedFloat operator*( CountedFloat a, CountedFloat b ) { CountedFloat::multiplies++; return a.v * b.v; }
+static CountedFloat operator/( CountedFloat a, CountedFloat b ) { CountedFloat::divides++; return a.v / b.v; }
+static bool operator<( CountedFloat a, CountedFloat b ) { CountedFloat::compares++; return a.v < b.v; }
+static bool operator>( CountedFloat a, CountedFloat b ) { CountedFloat::compares++; return a.v > b.v; }
+static bool operator<=( CountedFloat a, CountedFloat b ) { CountedFloat::compares++; return a.v <= b.v; }
+static CountedFloat& operator+=( CountedFloat& a, CountedFloat b ) { a = a + b; return a; }
+static CountedFloat fabs( CountedFloat a ) { return fabsf( a.v ); }   // Clears the sign bit
+
+template<typename Real>
+struct FloatPath
+{
+  Real brightness;
+  Real monitorEast;
+  Real monitorWest;
+  int balanced;
+};
+
+struct FixedPath
+{
+  TrackerCore::FixedFilter brightness;
+  TrackerCore::FixedFilter monitorEast;
+  TrackerCore::FixedFilter monitorWest;
+  int balanced;
+};
+
+// As TrackerCore::step() did it before the fixed-point conversion; dt came
+// from the millis() difference
+template<typename Real>
+static void runFloat( FloatPath<Real>& path, int samples, Real brightnessTauS, Real monitorTauS, Real tolerancePercent )
+{
+  for( int i = 0; i < samples; i++ )
+  {
+    Real east = eastFloat[i];
+    Real west = westFloat[i];
+    Real dt = Real( (float)STEP_MS ) / 1000.0f;
+    Real average = ( east + west ) / 2.0f;
+    Real alpha = brightnessTauS > 0.0f ? dt / brightnessTauS : 1.0f;
+    path.brightness += ( alpha * ( average - path.brightness ));
+    if( path.brightness < 0.0f ) path.brightness = 0.0f;
+    Real monitorAlpha = monitorTauS > 0.0f ? dt / monitorTauS : 1.0f;
+    path.monitorEast += ( monitorAlpha * ( east - path.monitorEast ));
+    if( path.monitorEast < 0.0f ) path.monitorEast = 0.0f;
+    path.monitorWest += ( monitorAlpha * ( west - path.monitorWest ));
+    if( path.monitorWest < 0.0f ) path.monitorWest = 0.0f;
+    Real lowerValue = ( east < west ) ? east : west;
+    Real tolerance = ( lowerValue * tolerancePercent / 100.0f );
+    path.balanced += ( fabs( east - west ) <= tolerance );
+  }
+}
+
+static void runFixed( FixedPath& path, unsigned long brightnessTauMs, uint32_t brightnessAlpha,
+                      unsigned long monitorTauMs, uint32_t monitorAlpha, int32_t tolerancePpm )
+{
+  for( int i = 0; i < SAMPLES; i++ )
+  {
+    int32_t east = eastOhms[i];
+    int32_t west = westOhms[i];
+    TrackerCore::updateFilter( &path.brightness, ( east + west ) / 2, STEP_MS, brightnessTauMs, brightnessAlpha );
+    TrackerCore::updateFilter( &path.monitorEast, east, STEP_MS, monitorTauMs, monitorAlpha );
+    TrackerCore::updateFilter( &path.monitorWest, west, STEP_MS, monitorTauMs, monitorAlpha );
+    int32_t lowerValue = ( east < west ) ? east : west;
+    path.balanced += !TrackerCore::exceedsPpm( east - west, lowerValue, tolerancePpm );
+  }
+}
+
+int main()
+{
+  makeSamples();
+  float brightnessTauS = TRACKER_BRIGHTNESS_FILTER_TIME_CONSTANT_S;
+  float monitorTauS = TRACKER_MONITOR_FILTER_TIME_CONSTANT_S;
+  float tolerancePercent = 3.0f;
+  unsigned long brightnessTauMs = TrackerCore::getFilterTauMs( brightnessTauS );
+  unsigned long monitorTauMs = TrackerCore::getFilterTauMs( monitorTauS );
+  uint32_t brightnessAlpha = TrackerCore::getFilterAlphaPerMs( brightnessTauMs );
+  uint32_t monitorAlpha = TrackerCore::getFilterAlphaPerMs( monitorTauMs );
+  int32_t tolerancePpm = TrackerCore::percentToPpm( tolerancePercent );
+
+  // One pass from the same start: same filter values and decisions
+  int32_t startBrightness = ( eastOhms[0] + westOhms[0] ) / 2;
+  FloatPath<float> floatPath = { (float)startBrightness, eastFloat[0], westFloat[0], 0 };
+  FixedPath fixedPath;
+  TrackerCore::resetFilter( &fixedPath.brightness, startBrightness );
+  TrackerCore::resetFilter( &fixedPath.monitorEast, eastOhms[0] );
+  TrackerCore::resetFilter( &fixedPath.monitorWest, westOhms[0] );
+  fixedPath.balanced = 0;
+  runFloat<float>( floatPath, SAMPLES, brightnessTauS, monitorTauS, tolerancePercent );
+  runFixed( fixedPath, brightnessTauMs, brightnessAlpha, monitorTauMs, monitorAlpha, tolerancePpm );
+  CHECK( fabs( TrackerCore::getFilterValue( fixedPath.brightness ) - floatPath.brightness ) < 1.0f );
+  CHECK( fabs( TrackerCore::getFilterValue( fixedPath.monitorEast ) - floatPath.monitorEast ) < 1.0f );
+  CHECK( fabs( TrackerCore::getFilterValue( fixedPath.monitorWest ) - floatPath.monitorWest ) < 1.0f );
+  CHECK( fixedPath.balanced == floatPath.balanced );
+  CHECK( fixedPath.balanced > 0 && fixedPath.balanced < SAMPLES );
+
+  clock_t start = clock();
+  for( int pass = 0; pass < PASSES; pass++ )
+  {
+    runFloat<float>( floatPath, SAMPLES, brightnessTauS, monitorTauS, tolerancePercent );
+  }
+  double floatSeconds = (double)( clock() - start ) / CLOCKS_PER_SEC;
+  start = clock();
+  for( int pass = 0; pass < PASSES; pass++ )
+  {
+    runFixed( fixedPath, brightnessTauMs, brightnessAlpha, monitorTauMs, monitorAlpha, tolerancePpm );
+  }
+  double fixedSeconds = (double)( clock() - start ) / CLOCKS_PER_SEC;
+
+  // Keeps both loops from being optimized away
+  CHECK( fixedPath.balanced == floatPath.balanced );
+  double steps = (double)SAMPLES * PASSES;
+  printf( "host: float path %.2f ns/step, fixed point %.2f ns/step\n",
+          floatSeconds * 1e9 / steps, fixedSeconds * 1e9 / steps );
+
+  // One step of the old path, counted
+  FloatPath<CountedFloat> counted = { CountedFloat( startBrightness ), eastFloat[0], westFloat[0], 0 };
+  runFloat<CountedFloat>( counted, 1, brightnessTauS, monitorTauS, tolerancePercent );
+  unsigned long operations = CountedFloat::adds + CountedFloat::multiplies + CountedFloat::divides +
+                             CountedFloat::compares;
+  printf( "AVR: float path %lu soft-float calls/step (%lu add, %lu mul, %lu div, %lu compare), fixed point none\n",
+          operations, CountedFloat::adds, CountedFloat::multiplies, CountedFloat::divides,
+          CountedFloat::compares );
+  CHECK( CountedFloat::divides > 0 );
+  return hostTestResult( "FilterBench" );
+}
@@ -0,0 +1,105 @@
+#include "HostArduino.h"
+#include <EEPROM.h>
+#include <Wire.h>
+#include "pins_config.h"
+
+unsigned long hostMillis = 0;
+uint8_t hostPinLevel[HOST_PIN_COUNT];
+int hostAnalogValue[HOST_PIN_COUNT];
+void (*hostInterruptHook)( void ) = nullptr;
+
+uint8_t hostTccrB[6];
+uint8_t hostTccr5a;
+uint8_t hostTimsk5;
+uint16_t hostTcnt5;
+uint16_t hostOcr5a;
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+TwoWire Wire;
+
+static uint8_t eepromData[4096];
+static bool eepromErased = false;
+
+unsigned long millis()
+{
+  return hostMillis;
+}
+
+unsigned long micros()
+{
+  return hostMillis * 1000UL;
+}
+
+void delay( unsigned long ms )
+{
+  hostMillis += ms;
+}
+
+void pinMode( uint8_t, uint8_t )
+{
+}
+
+void digitalWrite( uint8_t pin, uint8_t value )
+{
+  if( pin < HOST_PIN_COUNT )
+  {
+    hostPinLevel[pin] = value ? 255 : 0;
+  }
+}
+
+int analogRead( uint8_t pin )
+{
+  return pin < HOST_PIN_COUNT ? hostAnalogValue[pin] : 0;
+}
+
+void analogWrite( uint8_t pin, int value )
+{
+  if( pin < HOST_PIN_COUNT )
+  {
+    hostPinLevel[pin] = (uint8_t)constrain( value, 0, 255 );
+  }
+}
+
+void noInterrupts()
+{
+  if( hostInterruptHook != nullptr )
+  {
+    void (*hook)( void ) = hostInterruptHook;
+    hostInterruptHook = nullptr;
+    hook();
+  }
+}
+
+void interrupts()
+{
+}
+
+// Pins 6 and 7 are OC4A/OC4B on the Mega; only the motor pins need PWM here
+uint8_t digitalPinToTimer( uint8_t pin )
+{
+  if( pin == MOTOR_WEST_PIN || pin == MOTOR_EAST_PIN )
+  {
+    return TIMER4A;
+  }
+  return NOT_ON_TIMER;
+}
+
+uint8_t EEPROMClass::read( int address )
+{
+  if( !eepromErased )
+  {
+    memset( eepromData, 0xFF, sizeof( eepromData ));
+    eepromErased = true;
+  }
+  return ( address >= 0 && address < length()) ? eepromData[address] : 0xFF;
+}
+
+void EEPROMClass::write( int address, uint8_t value )
+{
+  read( 0 );
+  if( address >= 0 && address < length())
+  {
+    eepromData[address] = value;
+  }
+}
@@ -0,0 +1,19 @@
+#ifndef HOST_ARDUINO_CONTROL_H
+#define HOST_ARDUINO_CONTROL_H
+
+#include <Arduino.h>
+
+// Test side of the host Arduino core. The clock only moves when a test
+// advances it; pin levels hold the last digitalWrite (0/255) or
+// analogWrite duty.
+extern unsigned long hostMillis;
+extern uint8_t hostPinLevel[HOST_PIN_COUNT];
+extern int hostAnalogValue[HOST_PIN_COUNT];
+
+// Runs once, then clears, at the next noInterrupts(): lets a test land an
+// interrupt just before a critical section
+extern void (*hostInterruptHook)( void );
+
+ISR(TIMER5_COMPA_vect);   // Call once per simulated millisecond to run the stop timer
+
+#endif // HOST_ARDUINO_CONTROL_H
@@ -0,0 +1,26 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+// Minimal check macro for the host tests: prints each failure and makes
+// hostTestResult() non-zero so make check stops on it.
+static int hostTestFailures = 0;
+
+#define CHECK( cond ) \
+  do \
+  { \
+    if( !( cond )) \
+    { \
+      printf( "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+      hostTestFailures++; \
+    } \
+  } while( 0 )
+
+static inline int hostTestResult( const char* name )
+{
+  printf( "%s: %s\n", name, hostTestFailures ? "FAILED" : "passed" );
+  return hostTestFailures ? 1 : 0;
+}
+
+#endif // HOST_TEST_H
@@ -0,0 +1,128 @@
+// MotorControl driving a brushed DC motor model through the host pins:
+// i = (V d - K w) / R, J dw/dt = K i - B w, no inductance. Full duty runs
+// the panel at 10 deg/s; with the outputs off it coasts (tau = J / B).
+// The controller sees the panel through a 100 ms sensor filter lag and
+// moves it 20 degrees with a 1 degree tolerance, stopping once balanced or
+// past balance, as the tracker does. Compares plain on/off drive with the
+// PWM ramp, with and without the slow final approach.
+
+#include "HostTest.h"
+#include "HostArduino.h"
+#include "MotorControl.h"
+#include "pins_config.h"
+
+struct PlantResult
+{
+  double peakCurrentA;
+  double finalErrorDeg;
+  int moves;
+  int corrections;                  // Moves after the first
+  double estimateErrorDeg;          // Position estimate against the plant, at rest
+};
+
+// The timer interrupt keeps every motor it serves, so the runs share one
+static MotorControl motor( MOTOR_EAST_PIN, MOTOR_WEST_PIN );
+
+static PlantResult run( bool pwm, bool approach )
+{
+  static const double V = 12.0, R = 2.0, K = 1.0, J = 0.05, B = 0.2;
+  static const double TARGET_DEG = 20.0;
+  static const double TOLERANCE_DEG = 1.0;
+  static const int LAG_MS = 100;
+  static const int HISTORY = 256;
+
+  motor.setPwmEnabled( pwm );
+  motor.setSoftLimitsEnabled( false );
+  motor.setStartLimitEnabled( false );
+  hostMillis += 1000;
+  motor.begin();
+
+  const double fullSpeed = ( K * V / R ) / ( B + K * K / R );
+  double speed = 0.0;
+  double position = 0.0;
+  double history[HISTORY] = { 0.0 };
+  int historyIndex = 0;
+  int direction = 0;
+  int32_t estimateStart = motor.getPositionEstimate();
+  PlantResult result = {};
+
+  for( int ms = 0; ms < 120000; ms++ )
+  {
+    hostMillis++;
+    TIMER5_COMPA_vect();
+    motor.update();
+
+    double duty = hostPinLevel[MOTOR_WEST_PIN] ? hostPinLevel[MOTOR_WEST_PIN] / 255.0 :
+                  ( hostPinLevel[MOTOR_EAST_PIN] ? -hostPinLevel[MOTOR_EAST_PIN] / 255.0 : 0.0 );
+    double current = ( duty != 0.0 ) ? ( V * duty - K * speed ) / R : 0.0;
+    result.peakCurrentA = max( result.peakCurrentA, fabs( current ));
+    speed += 0.001 * ( K * current - B * speed ) / J;
+    position += 0.001 * speed * 10.0 / fullSpeed;
+    history[historyIndex] = position;
+    historyIndex = ( historyIndex + 1 ) % HISTORY;
+    double error = TARGET_DEG - history[( historyIndex + HISTORY - LAG_MS ) % HISTORY];
+
+    // Adjust every 500 ms while off target, up to ten moves
+    if( direction == 0 && ms % 500 == 0 && fabs( error ) > TOLERANCE_DEG && result.moves < 10 )
+    {
+      if( result.moves > 0 )
+      {
+        result.corrections++;
+      }
+      direction = ( error > 0 ) ? 1 : -1;
+      result.moves++;
+      if( direction > 0 )
+      {
+        motor.moveWest( MotorControl::PRIORITY_SAFETY );
+      }
+      else
+      {
+        motor.moveEast( MotorControl::PRIORITY_SAFETY );
+      }
+    }
+    if( direction != 0 )
+    {
+      if( fabs( error ) < TOLERANCE_DEG || error * direction < 0 )
+      {
+        motor.stop();
+        direction = 0;
+      }
+      else if( approach && fabs( error ) < 3 * TOLERANCE_DEG )
+      {
+        motor.setApproach();
+      }
+    }
+    if( direction == 0 && fabs( speed ) < 1e-3 )
+    {
+      double estimateError = fabs(( motor.getPositionEstimate() - estimateStart ) / 1000.0 - position );
+      result.estimateErrorDeg = max( result.estimateErrorDeg, estimateError );
+    }
+  }
+  result.finalErrorDeg = position - TARGET_DEG;
+  return result;
+}
+
+static void printResult( const char* name, const PlantResult& result )
+{
+  printf( "%-20s peak %.2f A, final error %+.2f deg, %d moves (%d corrections), estimate error %.2f deg\n",
+          name, result.peakCurrentA, result.finalErrorDeg, result.moves, result.corrections,
+          result.estimateErrorDeg );
+}
+
+int main()
+{
+  PlantResult onOff = run( false, false );
+  PlantResult ramp = run( true, false );
+  PlantResult rampApproach = run( true, true );
+  printResult( "on/off:", onOff );
+  printResult( "PWM ramp:", ramp );
+  printResult( "PWM ramp + approach:", rampApproach );
+
+  CHECK( ramp.peakCurrentA < onOff.peakCurrentA / 2 );
+  CHECK( rampApproach.peakCurrentA <= ramp.peakCurrentA );
+  CHECK( ramp.corrections < onOff.corrections );
+  CHECK( rampApproach.moves <= ramp.moves );
+  CHECK( fabs( rampApproach.finalErrorDeg ) <= 1.0 );
+  CHECK( rampApproach.estimateErrorDeg < 1.0 );
+  return hostTestResult( "MotorPlantSim" );
+}
@@ -0,0 +1,310 @@
+// Runs MotorControl's command queue against the host pins and the Timer5
+// interrupt: queued sequences and their completion reports, direct
+// commands cutting into a timed move, a cut racing a retime, end stops
+// taken from the safety timeout, refused starts, and the accuracy of the
+// deadline when loop() only gets round every 50 ms.
+
+#include "HostTest.h"
+#include "HostArduino.h"
+#include "MotorControl.h"
+#include "pins_config.h"
+
+struct Report
+{
+  uint8_t id;
+  uint8_t result;
+  unsigned long time;
+};
+
+static Report reports[16];
+static uint8_t reportCount = 0;
+
+static void onCommandDone( MotorControl*, uint8_t commandId, uint8_t result, void* )
+{
+  if( reportCount < sizeof( reports ) / sizeof( reports[0] ))
+  {
+    reports[reportCount].id = commandId;
+    reports[reportCount].result = result;
+    reports[reportCount].time = hostMillis;
+    reportCount++;
+  }
+}
+
+// The timer interrupt keeps every motor it serves, so the checks share one
+static MotorControl motor( MOTOR_EAST_PIN, MOTOR_WEST_PIN );
+
+// Advances the clock, ticking the interrupt every ms and running update()
+// every updateMs, as a busy loop() would
+static void run( unsigned long ms, unsigned long updateMs )
+{
+  for( unsigned long t = 1; t <= ms; t++ )
+  {
+    hostMillis++;
+    TIMER5_COMPA_vect();
+    if( t % updateMs == 0 )
+    {
+      motor.update();
+    }
+  }
+}
+
+// Starts each check from rest, clear of the dead time
+static void setUp()
+{
+  motor.setStartLimitEnabled( false );
+  motor.setSoftLimitsEnabled( false );
+  motor.setPwmEnabled( false );
+  motor.setCommandDoneCallback( onCommandDone, nullptr );
+  if( hostMillis == 0 )
+  {
+    hostMillis = 1000;
+  }
+  motor.begin();
+  motor.stop();
+  run( 1000, 50 );
+  reportCount = 0;
+}
+
+static bool driving( bool west )
+{
+  return hostPinLevel[west ? MOTOR_WEST_PIN : MOTOR_EAST_PIN] != 0;
+}
+
+// west, stop, east 300 ms, stop 200 ms, west 500 ms
+static void checkSequence()
+{
+  setUp();
+  CHECK( motor.moveWest());
+  run( 2000, 50 );
+  uint8_t stopId = motor.queueStop();
+  uint8_t eastId = motor.queueMove( MotorControl::DIRECTION_EAST, 300 );
+  uint8_t holdId = motor.queueStop( 200 );
+  uint8_t westId = motor.queueMove( MotorControl::DIRECTION_WEST, 500 );
+  CHECK( stopId != 0 && eastId != 0 && holdId != 0 && westId != 0 );
+  CHECK( motor.getQueueLength() == 3 );
+  uint8_t endId = motor.queueStop();
+  CHECK( endId != 0 );
+  CHECK( motor.queueMove( MotorControl::DIRECTION_EAST ) == 0 );
+
+  // The reversal waits out the dead time from the stop
+  unsigned long queuedTime = hostMillis;
+  unsigned long eastStart = 0;
+  unsigned long eastEnd = 0;
+  unsigned long westStart = 0;
+  unsigned long westEnd = 0;
+  for( int t = 0; t < 3000; t++ )
+  {
+    bool east = driving( false );
+    bool west = driving( true );
+    run( 1, 1 );
+    if( !east && driving( false )) eastStart = hostMillis;
+    if( east && !driving( false )) eastEnd = hostMillis;
+    if( !west && driving( true )) westStart = hostMillis;
+    if( west && !driving( true )) westEnd = hostMillis;
+  }
+  CHECK( eastStart == queuedTime + MOTOR_DEAD_TIME_MS );
+  CHECK( eastEnd == eastStart + 300 );
+  CHECK( westStart >= eastEnd + 200 && westStart >= eastEnd + MOTOR_DEAD_TIME_MS );
+  CHECK( westEnd == westStart + 500 );
+  CHECK( motor.getState() == MotorControl::STOPPED );
+
+  CHECK( reportCount == 6 );
+  CHECK( reports[0].result == MotorControl::COMMAND_DONE );   // The untimed west move, on start
+  CHECK( reports[1].id == stopId && reports[1].result == MotorControl::COMMAND_DONE );
+  CHECK( reports[2].id == eastId && reports[2].result == MotorControl::COMMAND_DONE );
+  CHECK( reports[3].id == holdId && reports[3].time >= reports[2].time + 200 );
+  CHECK( reports[4].id == westId && reports[4].result == MotorControl::COMMAND_DONE );
+  CHECK( reports[5].id == endId && reports[5].time == reports[4].time );
+}
+
+// A direct command cancels the timed move as a new command of its own, an
+// untimed one runs on with the deadline cleared, and repeating it while it
+// runs untimed is coalesced
+static void checkDirectCommands()
+{
+  setUp();
+  unsigned long starts = motor.getStartCount();
+  unsigned long runTime = motor.getTotalRunTime();
+  unsigned long firstStart = hostMillis;
+  CHECK( motor.moveFor( MotorControl::DIRECTION_EAST, 1000 ));
+  uint8_t timedId = motor.getActiveCommand();
+  CHECK( timedId != 0 && motor.isTimedMove());
+  run( 300, 50 );
+
+  unsigned long coalesced = motor.getCoalescedCommandCount();
+  CHECK( motor.moveEast());
+  CHECK( reportCount == 2 );
+  CHECK( reports[0].id == timedId && reports[0].result == MotorControl::COMMAND_CANCELLED );
+  CHECK( reports[1].id != timedId && reports[1].result == MotorControl::COMMAND_DONE );
+  CHECK( !motor.isTimedMove());
+  CHECK( motor.getActiveCommand() == 0 );
+  CHECK( motor.getCoalescedCommandCount() == coalesced );
+  run( 2000, 50 );
+  CHECK( motor.getState() == MotorControl::MOVING_EAST && driving( false ));
+  CHECK( motor.getStartCount() == starts + 1 );
+
+  // Repeated each sample, the command is coalesced into the running move
+  reportCount = 0;
+  coalesced = motor.getCoalescedCommandCount();
+  unsigned long queued = motor.getQueuedCommandCount();
+  for( int i = 0; i < 20; i++ )
+  {
+    CHECK( motor.moveEast());
+    run( 100, 50 );
+  }
+  CHECK( motor.getCoalescedCommandCount() == coalesced + 20 );
+  CHECK( motor.getQueuedCommandCount() == queued );
+  CHECK( reportCount == 0 );
+  CHECK( motor.getStartCount() == starts + 1 );
+  CHECK( motor.getState() == MotorControl::MOVING_EAST );
+
+  // Retimed from now while running
+  CHECK( motor.moveFor( MotorControl::DIRECTION_EAST, 400 ));
+  unsigned long retimed = hostMillis;
+  run( 600, 1 );
+  CHECK( motor.getState() == MotorControl::STOPPED );
+  CHECK( motor.getTotalRunTime() == runTime + retimed + 400 - firstStart );
+
+  // A cut the loop has not seen yet ends the move before a new command
+  CHECK( motor.moveFor( MotorControl::DIRECTION_EAST, 300 ));
+  for( int t = 0; t < 300; t++ )
+  {
+    hostMillis++;
+    TIMER5_COMPA_vect();
+  }
+  CHECK( !driving( false ));
+  CHECK( motor.moveEast());
+  CHECK( driving( false ));
+  CHECK( motor.getStartCount() == starts + 3 );
+  motor.stop();
+}
+
+static void tick()
+{
+  TIMER5_COMPA_vect();
+}
+
+// The deadline passes after the command has looked for a cut but before the
+// move is retimed: the cut stands and the new command starts a fresh move
+static void checkRetimeCut()
+{
+  setUp();
+  unsigned long starts = motor.getStartCount();
+  unsigned long timerStops = motor.getTimerStopCount();
+  CHECK( motor.moveFor( MotorControl::DIRECTION_EAST, 300 ));
+  for( int t = 0; t < 299; t++ )
+  {
+    hostMillis++;
+    TIMER5_COMPA_vect();
+  }
+  CHECK( driving( false ));
+  hostMillis++;
+  hostInterruptHook = tick;
+  CHECK( motor.moveFor( MotorControl::DIRECTION_EAST, 500 ));
+  CHECK( hostInterruptHook == nullptr );
+  CHECK( motor.getTimerStopCount() == timerStops + 1 );
+  CHECK( motor.getStartCount() == starts + 2 );
+  CHECK( motor.getState() == MotorControl::MOVING_EAST && driving( false ));
+  run( 499, 1 );
+  CHECK( driving( false ));
+  run( 1, 1 );
+  CHECK( !driving( false ) && motor.getState() == MotorControl::STOPPED );
+}
+
+// A move that runs into the safety timeout re-zeroes the estimate at the
+// stop only when the estimate already has it there
+static void checkTimeoutStop()
+{
+  setUp();
+  PanelPosition* position = motor.getPosition();
+  position->reset();
+  CHECK( motor.moveWest());
+  run( MOTOR_MAX_MOVE_TIME_SECONDS * 1000UL + 100, 50 );
+  CHECK( motor.getState() == MotorControl::STOPPED );
+  CHECK( position->getEndStopCount() == 1 );
+  CHECK( position->isKnown() && position->isAtEndStop( true ));
+
+  // Half the distance at the approach duty: stopped short, not re-zeroed
+  run( 1000, 50 );
+  position->reset();
+  motor.setPwmEnabled( true );
+  CHECK( motor.moveWest());
+  run( 1000, 50 );
+  motor.setApproach();
+  run( MOTOR_MAX_MOVE_TIME_SECONDS * 1000UL, 50 );
+  CHECK( motor.getState() == MotorControl::STOPPED );
+  CHECK( position->getEndStopCount() == 0 );
+  CHECK( !position->isKnown() && !position->isAtEndStop( true ));
+  motor.setPwmEnabled( false );
+}
+
+// Refusals come back from the command, also for a reversal that would only
+// start after the dead time, and through the callback when queued
+static void checkRefusals()
+{
+  setUp();
+  motor.setStartLimitEnabled( true );
+  motor.setStartRefillRate( 0 );
+  motor.setStartBurst( 1 );
+  unsigned long denied = motor.getDeniedStartCount();
+  unsigned long priorityStarts = motor.getPriorityStartCount();
+  CHECK( motor.moveWest());
+  run( 500, 50 );
+  CHECK( !motor.moveEast());
+  CHECK( motor.getState() == MotorControl::STOPPED && !driving( true ));
+  CHECK( motor.getDeniedStartCount() == denied + 1 );
+  run( 500, 50 );
+  CHECK( motor.getState() == MotorControl::STOPPED && !driving( false ));
+
+  reportCount = 0;
+  uint8_t id = motor.queueMove( MotorControl::DIRECTION_WEST, 200 );
+  CHECK( id != 0 );
+  CHECK( reportCount == 1 && reports[0].id == id && reports[0].result == MotorControl::COMMAND_REFUSED );
+  CHECK( motor.getDeniedStartCount() == denied + 2 );
+
+  // Safety moves always start
+  CHECK( motor.moveEast( MotorControl::PRIORITY_SAFETY ));
+  CHECK( motor.getPriorityStartCount() == priorityStarts + 1 );
+  motor.stop();
+}
+
+// The interrupt cuts a timed move on the ms, whatever the loop period
+static void checkDeadline()
+{
+  setUp();
+  CHECK( motor.isTimerAvailable());
+  unsigned long timerStops = motor.getTimerStopCount();
+  unsigned long worst = 0;
+  for( unsigned long duration = 137; duration < 3000; duration += 411 )
+  {
+    CHECK( motor.moveFor( MotorControl::DIRECTION_WEST, duration ));
+    unsigned long start = hostMillis;
+    unsigned long end = 0;
+    for( int t = 0; t < 4000 && end == 0; t++ )
+    {
+      run( 1, 50 );
+      if( !driving( true ))
+      {
+        end = hostMillis;
+      }
+    }
+    unsigned long error = ( end > start + duration ) ? end - start - duration : start + duration - end;
+    worst = max( worst, error );
+    run( 200, 50 );
+    CHECK( motor.getState() == MotorControl::STOPPED );
+  }
+  printf( "MotorQueueTest: worst deadline error %lu ms at a 50 ms loop\n", worst );
+  CHECK( worst == 0 );
+  CHECK( motor.getTimerStopCount() == timerStops + 7 );
+}
+
+int main()
+{
+  checkSequence();
+  checkDirectCommands();
+  checkRetimeCut();
+  checkTimeoutStop();
+  checkRefusals();
+  checkDeadline();
+  return hostTestResult( "MotorQueueTest" );
+}
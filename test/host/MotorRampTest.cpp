@@ -0,0 +1,115 @@
+// Checks the MotorRamp duty profile and its closed-form equivalent run
+// time against a millisecond sum of the duty the motor is actually given.
+
+#include "HostTest.h"
+#include "MotorRamp.h"
+
+// Full-duty ms the profile delivers over elapsedMs, summed per ms
+static double sumDuty( const MotorRamp& ramp, unsigned long startTime, unsigned long elapsedMs )
+{
+  double dutyMs = 0.0;
+  for( unsigned long t = 0; t < elapsedMs; t++ )
+  {
+    dutyMs += ramp.getDuty( startTime + t );
+  }
+  return dutyMs / MotorRamp::FULL_DUTY;
+}
+
+static void checkProfile()
+{
+  MotorRamp ramp;
+  ramp.start( 1000 );
+  uint8_t startDuty = MotorRamp::percentToDuty( MOTOR_PWM_START_PERCENT );
+  CHECK( ramp.getDuty( 1000 ) == startDuty );
+  CHECK( ramp.getDuty( 1000 + MOTOR_PWM_RAMP_MS ) == MotorRamp::FULL_DUTY );
+  CHECK( ramp.getDuty( 1000 + 600000UL ) == MotorRamp::FULL_DUTY );
+
+  uint8_t previous = 0;
+  bool rising = true;
+  for( unsigned long t = 0; t <= MOTOR_PWM_RAMP_MS; t++ )
+  {
+    uint8_t duty = ramp.getDuty( 1000 + t );
+    rising = rising && duty >= previous;
+    previous = duty;
+  }
+  CHECK( rising );
+  uint8_t halfway = ramp.getDuty( 1000 + MOTOR_PWM_RAMP_MS / 2 );
+  CHECK( abs( halfway - ( startDuty + MotorRamp::FULL_DUTY ) / 2 ) <= 1 );
+
+  // The approach caps the duty from the call on, also during the ramp
+  uint8_t approachDuty = MotorRamp::percentToDuty( MOTOR_PWM_APPROACH_PERCENT );
+  ramp.start( 5000 );
+  ramp.setApproach( 5100 );
+  CHECK( ramp.isApproach() );
+  CHECK( ramp.getDuty( 5100 ) <= approachDuty );
+  CHECK( ramp.getDuty( 5000 + MOTOR_PWM_RAMP_MS ) == approachDuty );
+  ramp.start( 9000 );
+  CHECK( !ramp.isApproach() );
+  CHECK( ramp.getDuty( 9000 + MOTOR_PWM_RAMP_MS ) == MotorRamp::FULL_DUTY );
+
+  CHECK( MotorRamp::percentToDuty( 0 ) == 0 );
+  CHECK( MotorRamp::percentToDuty( 50 ) == 128 );
+  CHECK( MotorRamp::percentToDuty( 120 ) == MotorRamp::FULL_DUTY );
+}
+
+// Equivalent time within 1 % + 5 ms of the summed duty, for plain moves
+// and moves that switch to the approach during or after the ramp
+static void checkEquivalentTime()
+{
+  static const unsigned long ELAPSED_MS[] = { 0, 1, 250, 999, 1000, 1001, 3000, 60000, 600000 };
+  static const unsigned long NEVER = 0xFFFFFFFFUL;
+  static const unsigned long APPROACH_MS[] = { NEVER, 0, 400, 1000, 2500, 30000 };
+  double worst = 0.0;
+  for( uint8_t a = 0; a < sizeof( APPROACH_MS ) / sizeof( APPROACH_MS[0] ); a++ )
+  {
+    for( uint8_t e = 0; e < sizeof( ELAPSED_MS ) / sizeof( ELAPSED_MS[0] ); e++ )
+    {
+      MotorRamp ramp;
+      ramp.start( 2000 );
+      unsigned long elapsed = ELAPSED_MS[e];
+      double summed;
+      if( APPROACH_MS[a] <= elapsed )
+      {
+        summed = sumDuty( ramp, 2000, APPROACH_MS[a] );
+        ramp.setApproach( 2000 + APPROACH_MS[a] );
+        summed += sumDuty( ramp, 2000, elapsed ) - sumDuty( ramp, 2000, APPROACH_MS[a] );
+      }
+      else
+      {
+        summed = sumDuty( ramp, 2000, elapsed );
+      }
+      double error = fabs( ramp.getEquivalentTime( 2000 + elapsed ) - summed );
+      worst = max( worst, error );
+      CHECK( error <= 5.0 + summed * 0.01 );
+    }
+  }
+  printf( "equivalent time worst error %.1f ms\n", worst );
+
+  // No jump where the approach starts
+  MotorRamp ramp;
+  ramp.start( 0 );
+  unsigned long before = ramp.getEquivalentTime( 700 );
+  ramp.setApproach( 700 );
+  CHECK( ramp.getEquivalentTime( 700 ) == before );
+
+  // A ten-minute move stays within 32 bits: ramp average plus full duty after it
+  uint8_t startDuty = ramp.getStartDuty();
+  double expected = MOTOR_PWM_RAMP_MS * ( startDuty + MotorRamp::FULL_DUTY ) / 2.0 / MotorRamp::FULL_DUTY +
+                    ( 600000.0 - MOTOR_PWM_RAMP_MS );
+  ramp.start( 0 );
+  CHECK( fabs( ramp.getEquivalentTime( 600000UL ) - expected ) <= 2.0 );
+
+  // Without a ramp the equivalent time is the run time scaled by the duty
+  ramp.setRampTime( 0 );
+  ramp.start( 0 );
+  CHECK( ramp.getEquivalentTime( 10000 ) == 10000 );
+  ramp.setApproach( 0 );
+  CHECK( ramp.getEquivalentTime( 10000 ) == 10000UL * ramp.getApproachDuty() / MotorRamp::FULL_DUTY );
+}
+
+int main()
+{
+  checkProfile();
+  checkEquivalentTime();
+  return hostTestResult( "MotorRampTest" );
+}
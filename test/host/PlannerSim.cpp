@@ -0,0 +1,55 @@
+// Sensor balance against the model-predictive planner over the same day
+// (see DaySim.h): the planner should need fewer motor starts for no more
+// motor run time and point closer to the sun. Also times MotionPlanner::plan.
+
+#include <time.h>
+#include "HostTest.h"
+#include "DaySim.h"
+
+static void printDay( const char* name, const DayResult& day )
+{
+  printf( "%-15s %3lu starts, motor run %6.1f s, mean error %.2f deg, rms %.2f deg\n",
+          name, day.starts, day.runMs / 1000.0, day.meanErrorDeg, day.rmsErrorDeg );
+}
+
+static double timePlan()
+{
+  MotionPlanner planner;
+  planner.seedGain( 2500.0f );
+  planner.seedDrift( 0.67f );
+  MotionPlanner::Model model = { 0.0f, 5.0f, 0.06f, 0.0067f, 1.0f, 15000 };
+  const long PLANS = 1000000L;
+  volatile unsigned long sink = 0;
+  clock_t start = clock();
+  for( long i = 0; i < PLANS; i++ )
+  {
+    model.errorPercent = ( i % 200 ) * 0.05f - 5.0f;
+    sink += planner.plan( model ).durationMs;
+  }
+  (void)sink;
+  return (double)( clock() - start ) / CLOCKS_PER_SEC / PLANS * 1e6;
+}
+
+int main()
+{
+  TrackerCore balanceCore;
+  balanceCore.setTrackingStrategy( TRACKER_STRATEGY_SENSOR_BALANCE );
+  DayResult balance = runDay( balanceCore );
+
+  TrackerCore plannedCore;
+  plannedCore.setTrackingStrategy( TRACKER_STRATEGY_PLANNED );
+  DayResult planned = runDay( plannedCore );
+
+  printDay( "sensor balance:", balance );
+  printDay( "planned:", planned );
+  printf( "planned moves %u, deferred %u, learned gain %.0f ms/%%, drift %.3f %%/min, plan %.3f us\n",
+          plannedCore.getPlannedMoveCount(), plannedCore.getPlannerDeferCount(),
+          plannedCore.getMotionPlanner()->getGain(), plannedCore.getMotionPlanner()->getDriftRate(),
+          timePlan() );
+
+  CHECK( plannedCore.getPlannedMoveCount() > 0 );
+  CHECK( planned.starts < balance.starts );
+  CHECK( planned.runMs < balance.runMs * 11 / 10 );
+  CHECK( planned.meanErrorDeg <= balance.meanErrorDeg );
+  return hostTestResult( "PlannerSim" );
+}
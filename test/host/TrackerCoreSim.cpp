@@ -0,0 +1,27 @@
+// Full-day run of TrackerCore with the default sensor balance strategy
+// (see DaySim.h), reporting the host step rate.
+//
+// The move and transition counts are those of the floating-point core
+// that preceded the fixed-point sensor and filter math; the integer core
+// must make the same decisions.
+
+#include "HostTest.h"
+#include "DaySim.h"
+
+static const unsigned long FLOAT_CORE_MOVES = 138;
+static const unsigned long FLOAT_CORE_TRANSITIONS = 286;
+
+int main()
+{
+  TrackerCore core;
+  DayResult day = runDay( core );
+  printf( "%lu steps in %.3f s (%.1fM steps/s), %lu moves, final error %.2f deg, %lu transitions\n",
+          day.steps, day.seconds, day.steps / day.seconds / 1e6, day.moves, day.finalErrorDeg,
+          day.transitions );
+
+  CHECK( day.steps == 12UL * 3600UL * 100UL );
+  CHECK( day.moves == FLOAT_CORE_MOVES );
+  CHECK( day.transitions == FLOAT_CORE_TRANSITIONS );
+  CHECK( fabs( day.finalErrorDeg ) < 5.0 );
+  return hostTestResult( "TrackerCoreSim" );
+}
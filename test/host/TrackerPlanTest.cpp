@@ -0,0 +1,165 @@
+// Drives TrackerCore through an overshoot: the reversal must go out as a
+// motor plan (stop held for the reversal dead time, then the move the
+// other way), the core must wait for its completion report, and a refused
+// reversal, reported or never sent, must end the adjustment.
+
+#include "HostTest.h"
+#include "TrackerCore.h"
+
+static const unsigned long STEP_MS = 10;
+
+struct PlanRun
+{
+  TrackerCore core;
+  TrackerCore::Inputs in;
+  TrackerCore::Outputs out;
+  unsigned long t;
+};
+
+// errorPercent > 0: the west sensor is brighter and the panel should move west
+static void setImbalance( PlanRun& run, float errorPercent )
+{
+  run.in.eastValue = (int32_t)( 2000.0f * ( 1.0f + errorPercent / 200.0f ));
+  run.in.westValue = (int32_t)( 2000.0f * ( 1.0f - errorPercent / 200.0f ));
+}
+
+static void step( PlanRun& run )
+{
+  run.t += STEP_MS;
+  run.in.timeMs = run.t;
+  run.in.timeUs = run.t * 1000UL;
+  run.in.samplePair = ( run.t % 100 == 0 );
+  run.in.sampleMicros = run.in.timeUs;
+  run.core.step( run.in, run.out );
+  run.in.motorPlanDone = 0;
+  run.in.motorPlanRefused = 0;
+  if( run.out.motorStop )
+  {
+    run.in.motorState = MotorControl::STOPPED;
+  }
+  if( run.out.motorMove == TrackerCore::MOTOR_WEST )
+  {
+    run.in.motorState = MotorControl::MOVING_WEST;
+  }
+  else if( run.out.motorMove == TrackerCore::MOTOR_EAST )
+  {
+    run.in.motorState = MotorControl::MOVING_EAST;
+  }
+}
+
+// Runs until the core overshoots west and sends its reversal plan
+static bool overshoot( PlanRun& run )
+{
+  run.in = TrackerCore::Inputs();
+  run.in.motorState = MotorControl::STOPPED;
+  run.in.motorCanStart = true;
+  run.in.supplyAvailable = true;
+  run.t = 0;
+  setImbalance( run, 0.0f );
+  run.core.begin( run.in );
+  setImbalance( run, 10.0f );
+  for( int i = 0; i < 100000 && run.in.motorState != MotorControl::MOVING_WEST; i++ )
+  {
+    step( run );
+  }
+  if( run.core.getState() != TrackerCore::ADJUSTING )
+  {
+    return false;
+  }
+  setImbalance( run, -10.0f );
+  for( int i = 0; i < 100 && run.out.motorPlanLength == 0; i++ )
+  {
+    step( run );
+  }
+  return run.out.motorPlanLength > 0;
+}
+
+static void checkReversal()
+{
+  static PlanRun run;
+  CHECK( overshoot( run ));
+  CHECK( run.out.motorStop );
+  CHECK( run.out.motorPlanLength == 2 );
+  CHECK( run.out.motorPlan[0].move == TrackerCore::MOTOR_NONE );
+  CHECK( run.out.motorPlan[0].durationMs == run.core.getReversalDeadTime() );
+  CHECK( run.out.motorPlan[1].move == TrackerCore::MOTOR_EAST );
+  CHECK( run.out.motorPlan[1].durationMs == 0 );
+
+  // Nothing more is sent while the motor runs the plan, however long it takes
+  bool quiet = true;
+  for( int i = 0; i < 500; i++ )
+  {
+    step( run );
+    quiet = quiet && !run.out.motorStop && run.out.motorMove == TrackerCore::MOTOR_NONE &&
+            run.out.motorPlanLength == 0;
+  }
+  CHECK( quiet );
+  CHECK( run.core.getState() == TrackerCore::ADJUSTING );
+
+  // The stop hold ends, then the move east starts and finishes as a command
+  run.in.motorPlanDone = 0x01;
+  step( run );
+  run.in.motorState = MotorControl::MOVING_EAST;
+  run.in.motorPlanDone = 0x02;
+  step( run );
+  CHECK( run.core.getState() == TrackerCore::ADJUSTING );
+
+  // Balanced on the way back
+  setImbalance( run, 0.0f );
+  for( int i = 0; i < 20 && run.core.getState() == TrackerCore::ADJUSTING; i++ )
+  {
+    step( run );
+  }
+  CHECK( run.core.getState() == TrackerCore::IDLE );
+  CHECK( run.in.motorState == MotorControl::STOPPED );
+}
+
+static void checkRefusedReversal()
+{
+  static PlanRun run;
+  CHECK( overshoot( run ));
+  run.in.motorPlanDone = 0x03;
+  run.in.motorPlanRefused = 0x02;
+  step( run );
+  CHECK( run.core.getState() == TrackerCore::IDLE );
+  CHECK( run.out.motorMove == TrackerCore::MOTOR_NONE && run.out.motorPlanLength == 0 );
+}
+
+// Out of start tokens at the overshoot: the plan is never sent
+static void checkUnsentReversal()
+{
+  static PlanRun run;
+  run.core.setReversalDeadTime( 0 );
+  run.in = TrackerCore::Inputs();
+  run.in.motorState = MotorControl::STOPPED;
+  run.in.motorCanStart = true;
+  run.in.supplyAvailable = true;
+  run.t = 0;
+  setImbalance( run, 0.0f );
+  run.core.begin( run.in );
+  setImbalance( run, 10.0f );
+  for( int i = 0; i < 100000 && run.in.motorState != MotorControl::MOVING_WEST; i++ )
+  {
+    step( run );
+  }
+  CHECK( run.core.getState() == TrackerCore::ADJUSTING );
+  run.in.motorCanStart = false;
+  setImbalance( run, -10.0f );
+  bool sent = false;
+  for( int i = 0; i < 20 && run.core.getState() == TrackerCore::ADJUSTING; i++ )
+  {
+    step( run );
+    sent = sent || run.out.motorPlanLength > 0;
+  }
+  CHECK( !sent );
+  CHECK( run.core.getState() == TrackerCore::IDLE );
+  CHECK( run.in.motorState == MotorControl::STOPPED );
+}
+
+int main()
+{
+  checkReversal();
+  checkRefusedReversal();
+  checkUnsentReversal();
+  return hostTestResult( "TrackerPlanTest" );
+}
@@ -0,0 +1,39 @@
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+#include <Arduino.h>
+
+// Display driver that draws nothing, so Display and Graph compile on the host
+#define SSD1306_SWITCHCAPVCC 2
+#define SSD1306_WHITE 1
+#define SSD1306_BLACK 0
+#define WHITE 1
+#define BLACK 0
+
+struct TwoWire;
+
+class Adafruit_SSD1306 {
+public:
+  Adafruit_SSD1306( int, int, TwoWire*, int ) {}
+  bool begin( int, int ) { return true; }
+  void clearDisplay() {}
+  void display() {}
+  void setTextSize( int ) {}
+  void setTextColor( int ) {}
+  void setTextColor( int, int ) {}
+  void setCursor( int, int ) {}
+  template<typename T> void print( T ) {}
+  template<typename T> void print( T, int ) {}
+  template<typename T> void println( T ) {}
+  void drawPixel( int, int, int ) {}
+  void drawLine( int, int, int, int, int ) {}
+  void drawRect( int, int, int, int, int ) {}
+  void fillRect( int, int, int, int, int ) {}
+  void drawFastHLine( int, int, int, int ) {}
+  void drawFastVLine( int, int, int, int ) {}
+  void getTextBounds( const char*, int, int, int16_t*, int16_t*, uint16_t*, uint16_t* ) {}
+  int width() { return 128; }
+  int height() { return 64; }
+};
+
+#endif // HOST_ADAFRUIT_SSD1306_H
@@ -0,0 +1,134 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Host stand-in for the Arduino core: just enough of the AVR/Arduino API
+// for the tracker sources to compile with g++ on Linux. The functions are
+// defined in HostArduino.cpp, which lets a test drive the clock, read the
+// pin levels and call the timer interrupt.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_byte_near(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_ptr(p) (*(void* const*)(p))
+#define pgm_read_float(p) (*(const float*)(p))
+#define memcpy_P memcpy
+#define strcmp_P strcmp
+#define strcasecmp_P strcasecmp
+#define strlen_P strlen
+#define strncpy_P strncpy
+
+#define abs(x) ((x)>0?(x):-(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+
+#define A0 54
+#define A1 55
+#define A2 56
+#define A3 57
+#define A4 58
+#define A5 59
+#define A6 60
+#define A7 61
+#define A8 62
+#define A9 63
+#define A10 64
+#define A11 65
+#define HOST_PIN_COUNT 70
+
+#define INPUT 0
+#define OUTPUT 1
+#define LOW 0
+#define HIGH 1
+#define PI 3.14159265358979f
+#define DEC 10
+#define HEX 16
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+unsigned long millis();
+unsigned long micros();
+void delay( unsigned long ms );
+void pinMode( uint8_t pin, uint8_t mode );
+void digitalWrite( uint8_t pin, uint8_t value );
+int analogRead( uint8_t pin );
+void analogWrite( uint8_t pin, int value );
+void noInterrupts();
+void interrupts();
+
+// Timers: the motor pins sit on Timer4 as on the Mega; Timer5 drives the
+// motor stop interrupt
+#define NOT_ON_TIMER 0
+#define TIMER0A 1
+#define TIMER0B 2
+#define TIMER1A 3
+#define TIMER1B 4
+#define TIMER1C 5
+#define TIMER2 6
+#define TIMER2A 7
+#define TIMER2B 8
+#define TIMER3A 9
+#define TIMER3B 10
+#define TIMER3C 11
+#define TIMER4A 12
+#define TIMER4B 13
+#define TIMER4C 14
+#define TIMER4D 15
+#define TIMER5A 16
+#define TIMER5B 17
+#define TIMER5C 18
+uint8_t digitalPinToTimer( uint8_t pin );
+
+#define F_CPU 16000000UL
+#define clockCyclesPerMicrosecond() ( F_CPU / 1000000UL )
+#define _BV(bit) ( 1 << (bit) )
+extern uint8_t hostTccrB[6];
+extern uint8_t hostTccr5a;
+extern uint8_t hostTimsk5;
+extern uint16_t hostTcnt5;
+extern uint16_t hostOcr5a;
+#define TCCR1B hostTccrB[1]
+#define TCCR2B hostTccrB[2]
+#define TCCR3B hostTccrB[3]
+#define TCCR4B hostTccrB[4]
+#define TCCR5B hostTccrB[5]
+#define TCCR5A hostTccr5a
+#define TCNT5 hostTcnt5
+#define OCR5A hostOcr5a
+#define TIMSK5 hostTimsk5
+#define CS50 0
+#define CS51 1
+#define WGM52 3
+#define OCIE5A 1
+
+#define ISR(vector) extern "C" void vector( void )
+#define TIMER5_COMPA_vect hostTimer5CompareA
+
+class __FlashStringHelper;
+
+// Serial output is discarded; the tests check results, not logs
+struct HardwareSerial {
+  void begin( unsigned long ) {}
+  int available() { return 0; }
+  int read() { return -1; }
+  template<typename T> size_t print( T ) { return 0; }
+  template<typename T> size_t print( T, int ) { return 0; }
+  template<typename T> size_t println( T ) { return 0; }
+  template<typename T> size_t println( T, int ) { return 0; }
+  size_t println() { return 0; }
+};
+extern HardwareSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,15 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+// 4 KB of EEPROM held in RAM, erased to 0xFF like a new part
+struct EEPROMClass {
+  uint8_t read( int address );
+  void write( int address, uint8_t value );
+  void update( int address, uint8_t value ) { write( address, value ); }
+  int length() { return 4096; }
+};
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
@@ -0,0 +1,9 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+struct TwoWire {
+  void begin() {}
+};
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H